@@ -3,25 +3,55 @@
 // Input from vertex shader
 in vec2 vTexCoord;
 in vec4 vColor;
+flat in uint vTexSlot;
 
-// Uniforms
-uniform sampler2D uTexture;
-uniform bool uUseTexture;
+// Per-frame constants shared by all programs (std140, see FrameUniforms)
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;   // w = alpha cutoff, 0 in 2D
+};
+
+// One sampler per SpriteBatch texture slot (MAX_TEXTURE_SLOTS)
+uniform sampler2D uTextures[8];
 
 // Output color
 out vec4 FragColor;
 
-void main()
+// GLSL 3.30 only allows constant sampler array indices, hence the switch.
+// Gradients are taken outside it, since the branch isn't uniform.
+vec4 sampleSlot(uint slot, vec2 uv, vec2 dx, vec2 dy)
 {
-    if (uUseTexture)
+    switch (slot)
     {
-        // Sample texture and apply color tint
-        vec4 texColor = texture(uTexture, vTexCoord);
-        FragColor = texColor * vColor;
+        case 0u: return textureGrad(uTextures[0], uv, dx, dy);
+        case 1u: return textureGrad(uTextures[1], uv, dx, dy);
+        case 2u: return textureGrad(uTextures[2], uv, dx, dy);
+        case 3u: return textureGrad(uTextures[3], uv, dx, dy);
+        case 4u: return textureGrad(uTextures[4], uv, dx, dy);
+        case 5u: return textureGrad(uTextures[5], uv, dx, dy);
+        case 6u: return textureGrad(uTextures[6], uv, dx, dy);
+        case 7u: return textureGrad(uTextures[7], uv, dx, dy);
+
+        // Untextured sprites/shapes use color only
+        default: return vec4(1.0);
     }
-    else
+}
+
+void main()
+{
+    // Sample texture and apply color tint (both premultiplied)
+    vec4 color = sampleSlot(vTexSlot, vTexCoord, dFdx(vTexCoord), dFdy(vTexCoord)) * vColor;
+
+    // Depth-tested views discard see-through texels so they don't write depth
+    if (color.a < uCameraDown.w)
     {
-        // Use color only (for untextured sprites/shapes)
-        FragColor = vColor;
+        discard;
     }
+    FragColor = color;
 }
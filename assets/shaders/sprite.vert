@@ -4,22 +4,32 @@
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec2 aTexCoord;
 layout(location = 2) in vec4 aColor;
+layout(location = 3) in uint aTexSlot;  // Index into uTextures, 255 = untextured
 
-// Uniform matrices
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+// Per-frame constants shared by all programs (std140, see FrameUniforms)
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;  // World direction of screen +x
+    vec4 uCameraDown;   // World direction of screen +y; w = alpha cutoff
+};
 
 // Output to fragment shader
 out vec2 vTexCoord;
 out vec4 vColor;
+flat out uint vTexSlot;
 
 void main()
 {
-    // Transform vertex position by MVP matrices
-    gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+    // Sprite vertices are already in world space
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
 
     // Pass texture coordinates and color to fragment shader
     vTexCoord = aTexCoord;
     vColor = aColor;
+    vTexSlot = aTexSlot;
 }
@@ -0,0 +1,47 @@
+#version 330 core
+
+// Per-instance attributes (divisor 1), one record per sprite
+layout(location = 0) in vec4 aTransform;  // x, y, z, rotation
+layout(location = 1) in vec2 aSize;
+layout(location = 2) in vec4 aTexRect;    // u0, v0, u1, v1
+layout(location = 3) in vec2 aOrigin;
+layout(location = 4) in vec4 aColor;
+layout(location = 5) in uint aTexSlot;    // Index into uTextures, 255 = untextured
+
+// Per-frame constants shared by all programs (std140, see FrameUniforms)
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;  // World direction of screen +x
+    vec4 uCameraDown;   // World direction of screen +y; w = alpha cutoff
+};
+
+// Output to fragment shader
+out vec2 vTexCoord;
+out vec4 vColor;
+flat out uint vTexSlot;
+
+void main()
+{
+    // Drawn as a 4-vertex triangle strip: (0,0) (1,0) (0,1) (1,1)
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+    // Rotate about the origin, then span the quad along the camera's screen
+    // axes (plain X/Y in 2D, a camera-facing billboard in isometric views)
+    vec2 local = (corner - aOrigin) * aSize;
+    float c = cos(aTransform.w);
+    float s = sin(aTransform.w);
+    vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    vec3 world = aTransform.xyz + uCameraRight.xyz * rotated.x + uCameraDown.xyz * rotated.y;
+
+    gl_Position = uViewProjection * vec4(world, 1.0);
+
+    // Pass texture coordinates and color to fragment shader
+    vTexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
+    vColor = aColor;
+    vTexSlot = aTexSlot;
+}
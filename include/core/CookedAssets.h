@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Penumbra {
+namespace Assets {
+
+/**
+ * Runtime-ready asset formats produced by penumbra_cook
+ *
+ * Cooked files are little-endian blobs laid out so the runtime can hand
+ * their payload straight to OpenGL or into game structures without any
+ * decoding, conversion or text parsing.
+ *
+ *   textures/foo.png   -> textures/foo.ptex   (premultiplied RGBA8 + mip chain)
+ *   shaders/x.vert/.frag -> shaders.pshb      (preprocessed sources, one bundle)
+ *   rooms/foo.json     -> rooms/foo.proom     (binary room definition)
+ *   fonts/foo.fnt      -> fonts/foo.pfnt      (glyph metrics; the page .png cooks as a texture)
+ */
+
+/**
+ * Bump when any cooked layout changes; forces a full recook
+ */
+constexpr uint32_t COOK_FORMAT_VERSION = 1;
+
+constexpr uint32_t TEXTURE_MAGIC = 0x58455450;  // "PTEX"
+constexpr uint32_t SHADER_BUNDLE_MAGIC = 0x42485350;  // "PSHB"
+constexpr uint32_t ROOM_MAGIC = 0x4D4F5250;  // "PROM"
+constexpr uint32_t FONT_MAGIC = 0x544E4650;  // "PFNT"
+
+constexpr const char* TEXTURE_EXTENSION = ".ptex";
+constexpr const char* ROOM_EXTENSION = ".proom";
+constexpr const char* FONT_EXTENSION = ".pfnt";
+constexpr const char* SHADER_BUNDLE_FILE = "shaders.pshb";
+constexpr const char* MANIFEST_FILE = "manifest.json";
+
+/**
+ * Cooked texture: premultiplied RGBA8, mip level 0 first
+ * RGBA8 rows are always 4-byte aligned, so levels upload with the default
+ * GL_UNPACK_ALIGNMENT
+ */
+struct CookedTexture {
+    struct Level {
+        int width;
+        int height;
+        size_t offset;  // Byte offset of this level within pixels
+        size_t size;
+    };
+
+    int width;
+    int height;
+    std::vector<Level> levels;
+    std::vector<uint8_t> pixels;  // Level data; may be preceded by header bytes when read from disk
+
+    CookedTexture() : width(0), height(0) {}
+
+    const uint8_t* levelData(size_t level) const { return pixels.data() + levels[level].offset; }
+};
+
+/**
+ * Preprocessed shader sources keyed by their path relative to the asset root
+ * (e.g. "shaders/sprite.vert")
+ */
+struct ShaderBundle {
+    std::unordered_map<std::string, std::string> sources;
+
+    const std::string* find(const std::string& path) const {
+        auto it = sources.find(path);
+        return it != sources.end() ? &it->second : nullptr;
+    }
+};
+
+/**
+ * Cooked room: flat tile arrays plus metadata and spawn lists
+ */
+struct CookedRoom {
+    struct EnemySpawn {
+        std::string type;
+        float x;
+        float y;
+    };
+
+    struct PlatformSpawn {
+        std::string pattern;
+        float x;
+        float y;
+        float width;
+        float height;
+    };
+
+    std::string name;
+    int width;
+    int height;
+    std::vector<uint8_t> tileTypes;       // Row-major Game::TileType values
+    std::vector<uint16_t> textureIndices; // Row-major, same size as tileTypes
+    float spawnX;
+    float spawnY;
+    std::string northRoom;
+    std::string southRoom;
+    std::string eastRoom;
+    std::string westRoom;
+    float background[4];
+    std::string musicTrack;
+    std::vector<EnemySpawn> enemies;
+    std::vector<PlatformSpawn> platforms;
+
+    CookedRoom()
+        : width(0), height(0), spawnX(0.0f), spawnY(0.0f)
+        , background{0.0f, 0.0f, 0.0f, 1.0f} {}
+};
+
+/**
+ * Cooked bitmap font: glyph metrics over one atlas page
+ * Cooked from an AngelCode BMFont text file; the page image is cooked as a
+ * texture like any other .png
+ */
+struct CookedFont {
+    struct Glyph {
+        uint32_t codepoint;
+        uint16_t x, y, width, height;  // Atlas rect in pixels
+        int16_t offsetX, offsetY;      // Pen position (top of line) to glyph top-left
+        int16_t advance;
+    };
+
+    struct Kerning {
+        uint32_t first;
+        uint32_t second;
+        int16_t amount;
+    };
+
+    int lineHeight;
+    int base;  // Top of line to baseline
+    int pageWidth;
+    int pageHeight;
+    std::string page;  // Page image's source path relative to the asset root
+    std::vector<Glyph> glyphs;
+    std::vector<Kerning> kernings;
+
+    CookedFont() : lineHeight(0), base(0), pageWidth(0), pageHeight(0) {}
+};
+
+/**
+ * Read cooked assets from disk
+ * @return true if the file exists, has the right magic and current version
+ */
+bool readTexture(const std::string& path, CookedTexture& outTexture);
+bool readShaderBundle(const std::string& path, ShaderBundle& outBundle);
+bool readRoom(const std::string& path, CookedRoom& outRoom);
+bool readFont(const std::string& path, CookedFont& outFont);
+
+/**
+ * Write cooked assets to disk (used by penumbra_cook)
+ */
+bool writeTexture(const std::string& path, const CookedTexture& texture);
+bool writeShaderBundle(const std::string& path, const ShaderBundle& bundle);
+bool writeRoom(const std::string& path, const CookedRoom& room);
+bool writeFont(const std::string& path, const CookedFont& font);
+
+/**
+ * Map a source asset path to its cooked counterpart
+ * ("sprites/player.png" -> "sprites/player.ptex")
+ */
+std::string cookedTexturePath(const std::string& sourcePath);
+std::string cookedRoomPath(const std::string& sourcePath);
+std::string cookedFontPath(const std::string& sourcePath);
+
+/**
+ * 64-bit FNV-1a content hash used by the cook manifest
+ */
+uint64_t hashContent(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+
+} // namespace Assets
+} // namespace Penumbra
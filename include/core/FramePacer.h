@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/FrameStats.h"
+#include <mutex>
+
+namespace Penumbra {
+namespace Platform {
+
+/**
+ * How frames are paced to the display
+ */
+enum class PresentMode {
+    Uncapped,       // No vsync, no limit
+    VSync,          // Swap waits for vblank
+    AdaptiveVSync,  // Late frames swap immediately (tears) instead of waiting a whole refresh; VSync where unsupported
+    Limited         // No vsync; sleep-plus-spin to the target rate
+};
+
+/**
+ * Timing summary over the last FrameStats window
+ */
+struct FramePacingReport {
+    double frameTimeMean;    // Seconds
+    double frameTimeStdDev;  // Pacing jitter; 0 is perfectly even
+    double frameTimeMax;
+    double latencyMean;      // Input sampled -> buffer swap returned
+    double latencyMax;
+};
+
+/**
+ * Paces the main loop and measures frame time and latency
+ *
+ * Each frame, call beginFrame() first (it waits out the limiter and returns
+ * the delta time), poll input, then markInputSampled(). With late input
+ * sampling on, poll after beginFrame() so the limiter wait doesn't age the
+ * input; otherwise poll before it. recordPresent() may be called from the
+ * render thread.
+ */
+class FramePacer {
+public:
+    FramePacer();
+
+    /**
+     * Set present mode and the Limited mode's target rate (Hz)
+     * Takes effect on the next applySwapInterval()
+     */
+    void setMode(PresentMode mode, double targetRate = 60.0);
+    PresentMode getMode() const { return mode; }
+    double getTargetRate() const { return targetRate; }
+
+    /**
+     * Set the swap interval for the current mode
+     * Call on the thread where the GL context is current
+     * @return Mode in effect (AdaptiveVSync falls back to VSync when unsupported)
+     */
+    PresentMode applySwapInterval();
+
+    void setLateInputSampling(bool enable) { lateInputSampling = enable; }
+    bool getLateInputSampling() const { return lateInputSampling; }
+
+    /**
+     * Start a frame; in Limited mode, wait until its slot
+     * @return Seconds since the previous beginFrame() (0 on the first)
+     */
+    double beginFrame();
+
+    /**
+     * Note that input for this frame has been polled
+     * @return Timestamp to hand to recordPresent() once the frame is on screen
+     */
+    double markInputSampled();
+
+    /**
+     * Record a finished swap for a frame whose input was sampled at inputTime
+     */
+    void recordPresent(double inputTime);
+
+    /**
+     * Get frame time and latency statistics
+     */
+    FramePacingReport getReport() const;
+
+private:
+    // Sleep granularity is ~1 ms at best, so the last stretch is spun
+    static constexpr double SPIN_MARGIN = 0.002;
+
+    PresentMode mode;
+    double targetRate;
+    bool lateInputSampling;
+
+    double frameStart;
+    double nextDeadline;
+    FrameStats frameTimes;
+
+    mutable std::mutex latencyMutex;
+    FrameStats latencies;
+
+    void waitUntil(double deadline);
+};
+
+/**
+ * Get present mode name ("uncapped", "vsync", "adaptive", "limited")
+ */
+const char* getPresentModeName(PresentMode mode);
+
+} // namespace Platform
+} // namespace Penumbra
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Penumbra {
+namespace Platform {
+
+/**
+ * Rolling window of timing samples (seconds)
+ * Keeps the last windowSize samples; statistics cover only those
+ */
+class FrameStats {
+public:
+    explicit FrameStats(size_t windowSize = 120);
+
+    /**
+     * Add sample, dropping the oldest once the window is full
+     */
+    void add(double sample);
+
+    /**
+     * Drop all samples
+     */
+    void clear();
+
+    size_t getCount() const { return count; }
+    double getMean() const;
+    double getStdDev() const;
+    double getMin() const;
+    double getMax() const;
+
+private:
+    std::vector<double> samples;
+    size_t next;
+    size_t count;
+};
+
+} // namespace Platform
+} // namespace Penumbra
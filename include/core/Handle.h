@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Penumbra {
+namespace Resources {
+
+/**
+ * Generational handle to a pooled resource of type T
+ * The index selects a slot in the owning pool; the generation detects
+ * that the slot was freed (and possibly reused) after the handle was issued
+ */
+template<typename T>
+struct Handle {
+    uint32_t index;
+    uint32_t generation;
+
+    Handle() : index(0), generation(0) {}
+    Handle(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+    /**
+     * Null handles have generation 0 (live slots always start at 1)
+     */
+    bool isNull() const { return generation == 0; }
+    explicit operator bool() const { return !isNull(); }
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+/**
+ * Dense slot array that owns resources and hands out generational handles
+ * Lookups are an index plus a generation compare; no hashing or searching
+ */
+template<typename T>
+class HandlePool {
+public:
+    using HandleType = Handle<T>;
+
+    HandlePool() : liveCount(0) {}
+
+    /**
+     * Take ownership of a resource and return a handle to it
+     * Freed slots are reused before the array grows
+     */
+    HandleType insert(std::unique_ptr<T> resource) {
+        uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot());
+        }
+
+        Slot& slot = slots[index];
+        slot.resource = std::move(resource);
+        slot.refCount = 0;
+        slot.lastUsed = 0;
+        ++liveCount;
+        return HandleType(index, slot.generation);
+    }
+
+    /**
+     * Destroy the resource referenced by handle
+     * Every outstanding copy of the handle becomes stale
+     */
+    void remove(HandleType handle) {
+        take(handle);
+    }
+
+    /**
+     * Remove the resource referenced by handle without destroying it
+     * Every outstanding copy of the handle becomes stale; the caller decides
+     * when (and on which thread) the resource is destroyed
+     * @return The resource, or nullptr if the handle is null or stale
+     */
+    std::unique_ptr<T> take(HandleType handle) {
+        if (!isValid(handle)) {
+            return nullptr;
+        }
+
+        Slot& slot = slots[handle.index];
+        std::unique_ptr<T> resource = std::move(slot.resource);
+        bumpGeneration(slot);
+        freeList.push_back(handle.index);
+        --liveCount;
+        return resource;
+    }
+
+    /**
+     * Resolve handle to its resource
+     * Stale or null handles return nullptr; debug builds assert on stale handles
+     * so use-after-unload is caught where it happens
+     */
+    T* get(HandleType handle) const {
+        if (handle.index >= slots.size()) {
+            assert(handle.isNull() && "Handle index out of range");
+            return nullptr;
+        }
+
+        const Slot& slot = slots[handle.index];
+        if (slot.generation != handle.generation || !slot.resource) {
+            assert(handle.isNull() && "Stale resource handle dereferenced");
+            return nullptr;
+        }
+        return slot.resource.get();
+    }
+
+    /**
+     * Resolve handle and stamp the slot as used at time stamp (for LRU eviction)
+     */
+    T* get(HandleType handle, uint64_t stamp) {
+        T* resource = get(handle);
+        if (resource) {
+            slots[handle.index].lastUsed = stamp;
+        }
+        return resource;
+    }
+
+    /**
+     * Check whether handle still references a live resource (never asserts)
+     */
+    bool isValid(HandleType handle) const {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation &&
+               slots[handle.index].resource != nullptr;
+    }
+
+    /**
+     * Reference counting; resources with a count of 0 are eligible for eviction
+     */
+    void addRef(HandleType handle) {
+        if (isValid(handle)) {
+            ++slots[handle.index].refCount;
+        }
+    }
+
+    void release(HandleType handle) {
+        if (isValid(handle) && slots[handle.index].refCount > 0) {
+            --slots[handle.index].refCount;
+        }
+    }
+
+    uint32_t refCount(HandleType handle) const {
+        return isValid(handle) ? slots[handle.index].refCount : 0;
+    }
+
+    /**
+     * Last use stamp recorded by get(handle, stamp), or 0 if never used
+     */
+    uint64_t lastUsed(HandleType handle) const {
+        return isValid(handle) ? slots[handle.index].lastUsed : 0;
+    }
+
+    /**
+     * Destroy all resources and invalidate every outstanding handle
+     */
+    void clear() {
+        freeList.clear();
+        for (uint32_t i = static_cast<uint32_t>(slots.size()); i-- > 0;) {
+            if (slots[i].resource) {
+                slots[i].resource.reset();
+                bumpGeneration(slots[i]);
+            }
+            freeList.push_back(i);
+        }
+        liveCount = 0;
+    }
+
+    /**
+     * Invoke fn(handle, resource) for every live resource
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].resource) {
+                fn(HandleType(i, slots[i].generation), *slots[i].resource);
+            }
+        }
+    }
+
+    size_t size() const { return liveCount; }
+    size_t capacity() const { return slots.size(); }
+    bool empty() const { return liveCount == 0; }
+
+private:
+    struct Slot {
+        std::unique_ptr<T> resource;
+        uint32_t generation;
+        uint32_t refCount;
+        uint64_t lastUsed;
+
+        Slot() : generation(1), refCount(0), lastUsed(0) {}
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeList;
+    size_t liveCount;
+
+    static void bumpGeneration(Slot& slot) {
+        // Skip 0 on wrap so a recycled slot can never match a null handle
+        if (++slot.generation == 0) {
+            slot.generation = 1;
+        }
+    }
+};
+
+} // namespace Resources
+} // namespace Penumbra
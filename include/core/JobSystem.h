@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Penumbra {
+namespace Jobs {
+
+/**
+ * Fixed pool of worker threads for data-parallel frame work
+ *
+ * dispatch() splits a job into indexed pieces and blocks until all are
+ * done; the calling thread works too. Every piece is told which thread
+ * runs it, so callers can give each thread its own scratch state (e.g. a
+ * SpriteCommandBuffer) and share nothing while the job runs.
+ */
+class JobSystem {
+public:
+    /**
+     * Start workers
+     * @param workerCount Threads besides the caller; by default one per
+     *                    remaining hardware thread
+     */
+    explicit JobSystem(size_t workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * Get number of threads that run pieces, including the caller
+     * Thread indices passed to jobs are below this
+     */
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    /**
+     * Run job(piece, thread) for every piece in [0, pieceCount) and wait
+     * Not reentrant: jobs must not dispatch
+     */
+    void dispatch(size_t pieceCount, const std::function<void(size_t piece, size_t thread)>& job);
+
+    /**
+     * Hardware threads minus the caller (at least 0)
+     */
+    static size_t defaultWorkerCount();
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t, size_t)>* job;
+    size_t pieceCount;
+    std::atomic<size_t> nextPiece;
+    size_t busyWorkers;
+    uint64_t generation;
+    bool stopping;
+
+    void workerLoop(size_t thread);
+    void runPieces(size_t thread);
+};
+
+} // namespace Jobs
+} // namespace Penumbra
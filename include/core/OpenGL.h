@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * Platform OpenGL header selection
+ * Include this instead of the system GL headers directly
+ */
+
+// OpenGL headers - macOS specific
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
@@ -1,10 +1,21 @@
 #pragma once
 
+#include "core/CookedAssets.h"
+#include "core/Handle.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Penumbra {
+
+namespace Rendering {
+class GLStateCache;
+} // namespace Rendering
+
 namespace Resources {
 
 /**
@@ -14,6 +25,14 @@ class Texture;
 class Shader;
 class Sound;
 
+/**
+ * Typed generational handles for cached resources
+ * Resolve a name once, keep the handle, and dereference it per frame
+ */
+using TextureHandle = Handle<Texture>;
+using ShaderHandle = Handle<Shader>;
+using SoundHandle = Handle<Sound>;
+
 /**
  * Resource manager for loading and caching game assets
  * Implements singleton pattern for global access
@@ -27,53 +46,176 @@ public:
 
     /**
      * Initialize resource manager with base asset path
+     * The base path is a penumbra_cook output tree; its shader bundle is
+     * loaded here so shader loads never touch individual source files
      */
     void initialize(const std::string& assetBasePath);
 
+    /**
+     * Route texture uploads and deletes through the renderer's state cache
+     * so its texture bindings stay in sync; stateCache must outlive every
+     * loaded texture (clear and release them before it goes)
+     */
+    void setStateCache(Rendering::GLStateCache* stateCache) { state = stateCache; }
+
     /**
      * Load and cache texture from file
+     * Uploads to GL: call where the context is current (through
+     * RenderThread::runWithContext() when the render thread is on)
      * @param name Identifier for the texture
-     * @param path Path relative to asset base path
-     * @return Pointer to loaded texture, or nullptr on failure
+     * @param path Source path relative to asset base path; the cooked .ptex
+     *             next to it is what actually gets loaded
+     * @return Handle to loaded texture (existing handle if name is already loaded),
+     *         or a null handle on failure
+     */
+    TextureHandle loadTexture(const std::string& name, const std::string& path);
+
+    /**
+     * Look up cached texture handle by name
+     * Hashes the name; call once at load time, not per frame
+     * @return Handle to texture, or a null handle if not found
+     */
+    TextureHandle getTexture(const std::string& name) const;
+
+    /**
+     * Resolve texture handle and mark it as used this frame
+     * @return Pointer to texture, or nullptr if the handle is null or stale
      */
-    Texture* loadTexture(const std::string& name, const std::string& path);
+    Texture* get(TextureHandle handle) { return textures.get(handle, frameIndex); }
 
     /**
-     * Get cached texture by name
-     * @return Pointer to texture, or nullptr if not found
+     * Check whether texture handle still refers to a loaded texture
      */
-    Texture* getTexture(const std::string& name);
+    bool isValid(TextureHandle handle) const { return textures.isValid(handle); }
+
+    /**
+     * Unload single texture; outstanding handles to it become stale
+     * Its GL texture is retired, not deleted (see releaseRetiredTextures)
+     */
+    void unloadTexture(TextureHandle handle);
+
+    /**
+     * Delete GL textures of unloaded and evicted textures
+     * Call on the thread that owns the GL context, before drawing a frame.
+     * Retired textures were unused for the two frames a threaded renderer
+     * may still draw, so deleting them there can't pull one out from under
+     * a draw in flight. Thread-safe against unloads on the simulation thread.
+     */
+    void releaseRetiredTextures();
 
     /**
      * Load and compile shader program
+     * Sources come from the cooked shader bundle when present, else from disk
      * @param name Identifier for the shader
      * @param vertexPath Path to vertex shader
      * @param fragmentPath Path to fragment shader
-     * @return Pointer to compiled shader, or nullptr on failure
+     * @return Handle to compiled shader, or a null handle on failure
+     */
+    ShaderHandle loadShader(const std::string& name,
+                            const std::string& vertexPath,
+                            const std::string& fragmentPath);
+
+    /**
+     * Look up cached shader handle by name
+     * @return Handle to shader, or a null handle if not found
+     */
+    ShaderHandle getShader(const std::string& name) const;
+
+    /**
+     * Resolve shader handle
+     * @return Pointer to shader, or nullptr if the handle is null or stale
      */
-    Shader* loadShader(const std::string& name,
-                       const std::string& vertexPath,
-                       const std::string& fragmentPath);
+    Shader* get(ShaderHandle handle) const { return shaders.get(handle); }
 
     /**
-     * Get cached shader by name
-     * @return Pointer to shader, or nullptr if not found
+     * Check whether shader handle still refers to a loaded shader
      */
-    Shader* getShader(const std::string& name);
+    bool isValid(ShaderHandle handle) const { return shaders.isValid(handle); }
+
+    /**
+     * Unload single shader; outstanding handles to it become stale
+     */
+    void unloadShader(ShaderHandle handle);
 
     /**
      * Load sound from file
      * @param name Identifier for the sound
      * @param path Path relative to asset base path
-     * @return Pointer to loaded sound, or nullptr on failure
+     * @return Handle to loaded sound, or a null handle on failure
+     */
+    SoundHandle loadSound(const std::string& name, const std::string& path);
+
+    /**
+     * Look up cached sound handle by name
+     * @return Handle to sound, or a null handle if not found
+     */
+    SoundHandle getSound(const std::string& name) const;
+
+    /**
+     * Resolve sound handle
+     * @return Pointer to sound, or nullptr if the handle is null or stale
+     */
+    Sound* get(SoundHandle handle) const { return sounds.get(handle); }
+
+    /**
+     * Check whether sound handle still refers to a loaded sound
+     */
+    bool isValid(SoundHandle handle) const { return sounds.isValid(handle); }
+
+    /**
+     * Unload single sound; outstanding handles to it become stale
+     */
+    void unloadSound(SoundHandle handle);
+
+    /**
+     * Reference counting
+     * Freshly loaded resources start at 0; referenced textures are never evicted
+     */
+    void addRef(TextureHandle handle) { textures.addRef(handle); }
+    void addRef(ShaderHandle handle) { shaders.addRef(handle); }
+    void addRef(SoundHandle handle) { sounds.addRef(handle); }
+    void release(TextureHandle handle) { textures.release(handle); }
+    void release(ShaderHandle handle) { shaders.release(handle); }
+    void release(SoundHandle handle) { sounds.release(handle); }
+    uint32_t getRefCount(TextureHandle handle) const { return textures.refCount(handle); }
+    uint32_t getRefCount(ShaderHandle handle) const { return shaders.refCount(handle); }
+    uint32_t getRefCount(SoundHandle handle) const { return sounds.refCount(handle); }
+
+    /**
+     * Set texture memory budget in bytes (0 = unlimited)
+     * Takes effect immediately
      */
-    Sound* loadSound(const std::string& name, const std::string& path);
+    void setTextureBudget(size_t bytes);
+    size_t getTextureBudget() const { return textureBudget; }
 
     /**
-     * Get cached sound by name
-     * @return Pointer to sound, or nullptr if not found
+     * Advance the LRU clock and evict over-budget textures
+     * Call once per frame before any draw code resolves handles
      */
-    Sound* getSound(const std::string& name);
+    void beginFrame();
+
+    /**
+     * Evict unreferenced textures, least recently used first, until resident
+     * texture memory fits the budget. Textures used this frame or the last
+     * are kept: with the render thread on, last frame's packet may still be
+     * drawing with them.
+     * @return Number of textures evicted
+     */
+    size_t enforceBudget();
+
+    /**
+     * Residency statistics
+     */
+    struct Stats {
+        size_t textureCount;
+        size_t shaderCount;
+        size_t soundCount;
+        size_t texturesReferenced;
+        size_t textureMemory;
+        size_t textureBudget;
+        size_t texturesEvicted;
+    };
+    Stats getStats() const;
 
     /**
      * Clear all cached resources
@@ -82,21 +224,42 @@ public:
 
     /**
      * Clear resources of specific type
+     * All handles of that type become stale; textures are retired
      */
     void clearTextures();
     void clearShaders();
     void clearSounds();
 
 private:
-    ResourceManager() = default;
+    ResourceManager();
     ~ResourceManager() = default;
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
     std::string basePath;
-    std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
-    std::unordered_map<std::string, std::unique_ptr<Shader>> shaders;
-    std::unordered_map<std::string, std::unique_ptr<Sound>> sounds;
+    Assets::ShaderBundle shaderBundle;
+    Rendering::GLStateCache* state;
+
+    HandlePool<Texture> textures;
+    HandlePool<Shader> shaders;
+    HandlePool<Sound> sounds;
+
+    // Name lookup only; the render path works on handles
+    std::unordered_map<std::string, TextureHandle> textureNames;
+    std::unordered_map<std::string, ShaderHandle> shaderNames;
+    std::unordered_map<std::string, SoundHandle> soundNames;
+
+    // Residency
+    size_t textureMemory;
+    size_t textureBudget;
+    size_t texturesEvicted;
+    uint64_t frameIndex;
+
+    // Unloaded textures awaiting GL deletion on the render thread
+    std::vector<std::unique_ptr<Texture>> retiredTextures;
+    std::mutex retiredMutex;
+
+    void retireTexture(std::unique_ptr<Texture> texture);
 };
 
 /**
@@ -104,21 +267,71 @@ private:
  */
 class Texture {
 public:
-    Texture() : textureID(0), width(0), height(0) {}
+    Texture() : textureID(0), width(0), height(0), channels(4), state(nullptr) {}
     ~Texture();
 
-    bool loadFromFile(const std::string& path);
+    /**
+     * Load a cooked .ptex blob (premultiplied RGBA8 with mips) and upload it
+     * No image decoding happens at runtime; use penumbra_cook for source art
+     * Colors are premultiplied, so blend with GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+     * @param stateCache Binds for the upload and the delete go through it
+     *                   (must outlive the texture); null binds GL directly
+     */
+    bool loadFromFile(const std::string& path, Rendering::GLStateCache* stateCache = nullptr);
+
+    /**
+     * Upload premultiplied RGBA8 pixels generated at runtime (no mips)
+     */
+    bool loadFromPixels(const uint8_t* pixels, int width, int height,
+                        Rendering::GLStateCache* stateCache = nullptr);
+
     void bind() const;
     void unbind() const;
 
     unsigned int getID() const { return textureID; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
+    int getChannels() const { return channels; }
+
+    /**
+     * Approximate resident size in bytes (width * height * bytes per pixel)
+     */
+    size_t getMemorySize() const {
+        return static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
+    }
 
 private:
     unsigned int textureID;
     int width;
     int height;
+    int channels;
+    Rendering::GLStateCache* state;
+
+    void beginUpload(Rendering::GLStateCache* stateCache);
+    void endUpload();
+};
+
+/**
+ * Pre-hashed uniform name
+ * Declare as constexpr and pass to Shader setters, so the render loop never
+ * builds or hashes strings
+ */
+struct UniformID {
+    uint32_t hash;
+
+    constexpr UniformID(const char* name) : hash(hashName(name)) {}
+
+    /**
+     * 32-bit FNV-1a, usable at compile time
+     */
+    static constexpr uint32_t hashName(const char* name) {
+        uint32_t value = 2166136261u;
+        while (*name != '\0') {
+            value ^= static_cast<uint8_t>(*name++);
+            value *= 16777619u;
+        }
+        return value;
+    }
 };
 
 /**
@@ -130,19 +343,42 @@ public:
     ~Shader();
 
     bool loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
-    void use() const;
+    bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * Make this the current program through stateCache
+     */
+    void use(Rendering::GLStateCache& stateCache) const;
 
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, float x, float y) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
-    void setVec4(const std::string& name, float x, float y, float z, float w) const;
-    void setMat4(const std::string& name, const float* value) const;
+    /**
+     * Uniform setters; locations come from the table reflected at link time
+     * Uniforms the program doesn't use are silently ignored
+     */
+    void setInt(UniformID id, int value) const;
+    void setIntArray(UniformID id, const int* values, int count) const;
+    void setFloat(UniformID id, float value) const;
+    void setVec2(UniformID id, float x, float y) const;
+    void setVec3(UniformID id, float x, float y, float z) const;
+    void setVec4(UniformID id, float x, float y, float z, float w) const;
+    void setMat4(UniformID id, const float* value) const;
+
+    /**
+     * Get reflected uniform location, or -1 if the program has no such uniform
+     */
+    int getUniformLocation(UniformID id) const;
 
     unsigned int getID() const { return programID; }
 
 private:
+    struct UniformSlot {
+        uint32_t hash;
+        int location;
+    };
+
     unsigned int programID;
+    std::vector<UniformSlot> uniforms;  // Sorted by hash
+
+    void reflectUniforms();
     bool compileShader(const std::string& source, unsigned int type, unsigned int& outID);
     bool linkProgram(unsigned int vertexID, unsigned int fragmentID);
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Math.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -36,36 +37,69 @@ struct Tile {
     bool isCollidable() const { return isSolid() || isPlatform(); }
 };
 
+/**
+ * Faces of a tile's block in stacked (isometric) grids
+ * North is -Y (row above), East is +X; blocks are never seen from below
+ */
+enum class TileFace {
+    Top = 0,
+    North = 1,
+    East = 2,
+    South = 3,
+    West = 4
+};
+
 /**
  * Grid-based level structure
  * Manages tile layout and collision queries
+ *
+ * A grid may stack several levels of tiles for isometric rooms; level 0 is
+ * the ground and the only one 2D collision and rendering look at.
  */
 class TileGrid {
 public:
     static constexpr int TILE_SIZE = 16;
+    static constexpr int CHUNK_SIZE = 16;  // Tiles per chunk edge
 
     TileGrid();
-    TileGrid(int width, int height);
+    TileGrid(int width, int height, int levels = 1);
 
     /**
      * Initialize grid with specified dimensions
      */
-    void initialize(int width, int height);
+    void initialize(int width, int height, int levels = 1);
 
     /**
-     * Set tile at grid position
+     * Set tile at grid position (on the ground level, or level z)
      */
     void setTile(int x, int y, const Tile& tile);
+    void setTile(int x, int y, int z, const Tile& tile);
 
     /**
-     * Get tile at grid position
+     * Get tile at grid position (on the ground level, or level z)
+     * Positions outside the grid read as empty
      */
     const Tile& getTile(int x, int y) const;
+    const Tile& getTile(int x, int y, int z) const;
+
+    /**
+     * Get contiguous row of tiles (y and z must be valid)
+     * Rows are stored row-major, so walking x along a row is a linear scan
+     */
+    const Tile* getRow(int y, int z = 0) const { return tiles.data() + toIndex(0, y, z); }
 
     /**
      * Check if grid position is valid
      */
     bool isValidPosition(int x, int y) const;
+    bool isValidPosition(int x, int y, int z) const;
+
+    /**
+     * Check if a face of the block at (x, y, z) can ever be seen
+     * False for empty tiles and for faces pressed against a solid neighbor;
+     * non-solid tiles (platforms, ladders) don't hide their neighbors' faces
+     */
+    bool isFaceExposed(int x, int y, int z, TileFace face) const;
 
     /**
      * Convert world position to grid coordinates
@@ -77,6 +111,13 @@ public:
      */
     void gridToWorld(int gridX, int gridY, float& outWorldX, float& outWorldY) const;
 
+    /**
+     * Get cells overlapping bounds as a half-open range [minX, maxX) x [minY, maxY)
+     * clamped to the grid; the range is empty if minX >= maxX or minY >= maxY
+     */
+    void getCellRange(const Math::AABB& bounds, int& outMinX, int& outMinY,
+                      int& outMaxX, int& outMaxY) const;
+
     /**
      * Check for collision with tiles in AABB
      * @return true if any solid/platform tile intersects the AABB
@@ -103,16 +144,51 @@ public:
      */
     void clear();
 
+    /**
+     * Get grid size in CHUNK_SIZE x CHUNK_SIZE chunks (edge chunks may be partial)
+     */
+    int getChunkColumns() const { return chunkColumns; }
+    int getChunkRows() const { return chunkRows; }
+
+    /**
+     * Get revision of the chunk containing tiles
+     * [chunkX * CHUNK_SIZE, (chunkX + 1) * CHUNK_SIZE) x [chunkY * CHUNK_SIZE, ...)
+     * on every level
+     * Changes whenever a tile in the chunk, or the exposure of one of its
+     * faces, may have changed; revisions are
+     * never reused by a grid, so a cache keyed on them can't be fooled by
+     * edits that were undone
+     */
+    uint32_t getChunkRevision(int chunkX, int chunkY) const
+    {
+        return chunkRevisions[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                              static_cast<size_t>(chunkX)];
+    }
+
     int getWidth() const { return width; }
     int getHeight() const { return height; }
+    int getLevels() const { return levels; }
     int getTileSize() const { return TILE_SIZE; }
 
 private:
     int width;
     int height;
+    int levels;
     std::vector<Tile> tiles;
 
-    int toIndex(int x, int y) const { return y * width + x; }
+    int chunkColumns;
+    int chunkRows;
+    uint32_t revision;
+    std::vector<uint32_t> chunkRevisions;
+
+    void touchAllChunks();
+    void touchChunk(int x, int y);
+
+    size_t toIndex(int x, int y, int z = 0) const
+    {
+        return (static_cast<size_t>(z) * static_cast<size_t>(height) + static_cast<size_t>(y)) *
+               static_cast<size_t>(width) + static_cast<size_t>(x);
+    }
 };
 
 } // namespace Game
@@ -107,6 +107,12 @@ public:
      */
     Math::Vec2 worldToScreen(float worldX, float worldY) const;
 
+    /**
+     * Get world-space rectangle visible through the viewport
+     * @param margin Extra world units on every side (e.g. for shake or overhanging sprites)
+     */
+    Math::AABB getVisibleBounds(float margin = 0.0f) const;
+
     /**
      * Get viewport dimensions
      */
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "core/Math.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Debug drawing is compiled in unless NDEBUG is set (release builds)
+ * Define PENUMBRA_DEBUG_DRAW to 0 or 1 to override
+ */
+#ifndef PENUMBRA_DEBUG_DRAW
+    #ifdef NDEBUG
+        #define PENUMBRA_DEBUG_DRAW 0
+    #else
+        #define PENUMBRA_DEBUG_DRAW 1
+    #endif
+#endif
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Debug primitive vertex (16 bytes)
+ */
+struct DebugVertex {
+    float x, y, z;
+    uint8_t r, g, b, a;  // Premultiplied
+};
+static_assert(sizeof(DebugVertex) == 16, "DebugVertex must stay tightly packed");
+
+/**
+ * How long a debug primitive is drawn
+ */
+enum class DebugLifetime {
+    Frame,      // Until the next endFrame()
+    Persistent  // Until clearPersistent()
+};
+
+/**
+ * Immediate-mode queue of debug lines, rects, circles and text
+ *
+ * Primitives are expanded into one line list and one triangle list as they
+ * are queued, so Renderer::drawDebug() draws any number of them in two draw
+ * calls. Text uses a built-in 16-segment stroke font (letters, digits and
+ * basic punctuation), so it needs no texture.
+ *
+ * Persistent primitives sit at the front of both lists and frame primitives
+ * after them, so endFrame() only truncates.
+ *
+ * With PENUMBRA_DEBUG_DRAW off every call is an empty inline function and
+ * the queue holds no data.
+ */
+class DebugDrawQueue {
+public:
+    static constexpr int CIRCLE_SEGMENTS = 24;
+
+#if PENUMBRA_DEBUG_DRAW
+    DebugDrawQueue();
+
+    void line(const Math::Vec2& start, const Math::Vec2& end, const Math::Color& color,
+              DebugLifetime lifetime = DebugLifetime::Frame);
+    void line(const Math::Vec3& start, const Math::Vec3& end, const Math::Color& color,
+              DebugLifetime lifetime = DebugLifetime::Frame);
+
+    void rect(const Math::Rect& bounds, const Math::Color& color, bool filled = false,
+              DebugLifetime lifetime = DebugLifetime::Frame);
+
+    void circle(const Math::Vec2& center, float radius, const Math::Color& color, bool filled = false,
+                DebugLifetime lifetime = DebugLifetime::Frame);
+
+    /**
+     * Draw text with its top-left corner at position
+     * @param height Glyph height in world units; glyphs are half as wide
+     */
+    void text(const Math::Vec2& position, const std::string& message, const Math::Color& color,
+              float height = 8.0f, DebugLifetime lifetime = DebugLifetime::Frame);
+
+    /**
+     * Drop frame primitives
+     */
+    void endFrame();
+
+    /**
+     * Drop persistent primitives
+     */
+    void clearPersistent();
+
+    /**
+     * Drop everything
+     */
+    void clear();
+
+    /**
+     * Vertex lists, two vertices per line and three per triangle
+     */
+    const std::vector<DebugVertex>& getLineVertices() const { return lines; }
+    const std::vector<DebugVertex>& getTriangleVertices() const { return triangles; }
+
+    bool isEmpty() const { return lines.empty() && triangles.empty(); }
+
+private:
+    std::vector<DebugVertex> lines;
+    std::vector<DebugVertex> triangles;
+    size_t persistentLines;      // Leading line vertices that survive endFrame()
+    size_t persistentTriangles;  // Leading triangle vertices that survive endFrame()
+
+    // Append to the frame or persistent section of list
+    static DebugVertex* append(std::vector<DebugVertex>& list, size_t& persistentCount,
+                               size_t count, DebugLifetime lifetime);
+    DebugVertex* appendLines(size_t lineCount, DebugLifetime lifetime);
+    DebugVertex* appendTriangles(size_t triangleCount, DebugLifetime lifetime);
+#else
+    void line(const Math::Vec2&, const Math::Vec2&, const Math::Color&,
+              DebugLifetime = DebugLifetime::Frame) {}
+    void line(const Math::Vec3&, const Math::Vec3&, const Math::Color&,
+              DebugLifetime = DebugLifetime::Frame) {}
+    void rect(const Math::Rect&, const Math::Color&, bool = false,
+              DebugLifetime = DebugLifetime::Frame) {}
+    void circle(const Math::Vec2&, float, const Math::Color&, bool = false,
+                DebugLifetime = DebugLifetime::Frame) {}
+    void text(const Math::Vec2&, const std::string&, const Math::Color&,
+              float = 8.0f, DebugLifetime = DebugLifetime::Frame) {}
+    void endFrame() {}
+    void clearPersistent() {}
+    void clear() {}
+    bool isEmpty() const { return true; }
+#endif
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Queued draw with its sort key
+ * index refers back to the caller's command storage
+ */
+struct DrawCommand {
+    uint64_t key;
+    uint32_t index;
+};
+
+/**
+ * Build a sort key; ascending keys are drawn first
+ *
+ * Bit layout, most significant first:
+ *   layer   8  (clamped to -128..127)
+ *   depth   32 (float, total order; lower draws first)
+ *   texture 16 (per-flush texture or atlas page slot)
+ *   shader  8  (per-flush shader slot)
+ *
+ * Layer and depth decide visibility; texture and shader only group draws
+ * that are free to reorder, so batches are as long as correctness allows.
+ */
+uint64_t makeSortKey(int layer, float depth, uint32_t textureSlot, uint32_t shaderSlot);
+
+/**
+ * Stable LSD radix sort by key, one byte per pass
+ * Passes where every key shares the same byte are skipped, so keys that
+ * only vary in a few fields sort in a few passes
+ * @param scratch Reused buffer; resized as needed
+ */
+void radixSort(std::vector<DrawCommand>& commands, std::vector<DrawCommand>& scratch);
+
+} // namespace Rendering
+} // namespace Penumbra
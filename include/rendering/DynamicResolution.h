@@ -0,0 +1,78 @@
+#pragma once
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Tuning for DynamicResolution
+ * Times are in seconds of GPU work per frame
+ */
+struct DynamicResolutionSettings {
+    float minScale;          // Smallest fraction of the world target rendered, per axis
+    float maxScale;          // Largest (1 = full world resolution)
+    float step;              // Scale change per adjustment
+    double targetFrameTime;  // GPU budget
+    float shrinkAbove;       // Shrink when smoothed time exceeds this fraction of the budget...
+    float growBelow;         // ...grow when it stays under this one
+    int shrinkFrames;        // Consecutive frames over budget before shrinking
+    int growFrames;          // Consecutive frames under budget before growing
+    int settleFrames;        // Samples ignored after a change (queries lag a few frames)
+    float smoothing;         // Weight of each new sample in the moving average
+
+    DynamicResolutionSettings()
+        : minScale(0.5f)
+        , maxScale(1.0f)
+        , step(0.1f)
+        , targetFrameTime(1.0 / 60.0)
+        , shrinkAbove(0.9f)
+        , growBelow(0.7f)
+        , shrinkFrames(4)
+        , growFrames(60)
+        , settleFrames(8)
+        , smoothing(0.2f)
+    {}
+};
+
+/**
+ * Picks a render scale from measured GPU frame times
+ *
+ * The band between growBelow and shrinkAbove is hysteresis: times inside
+ * it change nothing, and growing must be earned over many more frames than
+ * shrinking, so a scene near the budget doesn't flicker between scales.
+ * Shrinking reacts within a few frames to protect the frame rate.
+ */
+class DynamicResolution {
+public:
+    DynamicResolution();
+
+    void setSettings(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& getSettings() const { return settings; }
+
+    /**
+     * Feed one frame's GPU time
+     * @return true if the scale changed
+     */
+    bool update(double gpuFrameTime);
+
+    /**
+     * Return to full scale and forget history
+     */
+    void reset();
+
+    float getScale() const { return scale; }
+    double getSmoothedFrameTime() const { return smoothedTime; }
+
+private:
+    DynamicResolutionSettings settings;
+    float scale;
+    double smoothedTime;
+    int overFrames;
+    int underFrames;
+    int settling;
+    bool hasSample;
+
+    void setScale(float newScale);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
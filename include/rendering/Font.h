@@ -0,0 +1,104 @@
+#pragma once
+
+#include "core/Math.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Penumbra {
+
+namespace Resources {
+class Texture;
+}
+
+namespace Rendering {
+
+/**
+ * Glyph metrics in pixels, with its rect in the font page
+ */
+struct Glyph {
+    Math::Rect textureRect;  // Normalized
+    Math::Vec2 size;
+    Math::Vec2 offset;       // Pen position (top of line) to glyph top-left
+    float advance;
+};
+
+/**
+ * Bitmap font: one atlas page plus a glyph metrics table
+ *
+ * Every glyph lives on the same page texture, so any amount of text drawn
+ * through a SpriteBatch shares one texture slot and adds no draw calls.
+ * Fonts come from penumbra_cook (.pfnt, cooked from BMFont .fnt files) or
+ * from the built-in 5x7 pixel font used for debug overlays.
+ */
+class Font {
+public:
+    Font();
+
+    /**
+     * Load a cooked .pfnt file
+     * The page is a separate cooked texture: load getPagePath() through the
+     * ResourceManager and pass it to setPage()
+     */
+    bool loadFromFile(const std::string& path);
+
+    /**
+     * Build the built-in font (printable ASCII, 5x7 glyphs on a 6x9 grid)
+     * @param outPixels Receives the page as premultiplied RGBA8,
+     *                  getPageWidth() x getPageHeight(), for the caller to upload
+     */
+    void loadBuiltin(std::vector<uint8_t>& outPixels);
+
+    void setPage(Resources::Texture* texture) { page = texture; }
+    Resources::Texture* getPage() const { return page; }
+
+    /**
+     * Page image's source path relative to the asset root (empty for the built-in font)
+     */
+    const std::string& getPagePath() const { return pagePath; }
+
+    /**
+     * Get glyph for a Unicode codepoint, or nullptr if the font lacks it
+     */
+    const Glyph* getGlyph(uint32_t codepoint) const;
+
+    /**
+     * Get extra advance between a pair of codepoints (usually negative)
+     */
+    float getKerning(uint32_t first, uint32_t second) const;
+
+    float getLineHeight() const { return lineHeight; }
+    float getBaseline() const { return baseline; }
+    int getPageWidth() const { return pageWidth; }
+    int getPageHeight() const { return pageHeight; }
+
+    /**
+     * Bumped on every load, so cached layouts notice a changed font
+     */
+    uint32_t getRevision() const { return revision; }
+
+private:
+    static constexpr uint32_t ASCII_COUNT = 128;
+    static constexpr int32_t NO_GLYPH = -1;
+
+    std::vector<Glyph> glyphs;
+    int32_t asciiGlyphs[ASCII_COUNT];                // ASCII is looked up directly
+    std::unordered_map<uint32_t, int32_t> otherGlyphs;
+    std::unordered_map<uint64_t, float> kernings;   // (first << 32 | second)
+
+    float lineHeight;
+    float baseline;
+    int pageWidth;
+    int pageHeight;
+    std::string pagePath;
+    Resources::Texture* page;
+    uint32_t revision;
+
+    void reset(int width, int height);
+    void addGlyph(uint32_t codepoint, const Glyph& glyph);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/Math.h"
+
+namespace Penumbra {
+namespace Rendering {
+
+// Forward declarations
+class Camera;
+class IsometricCamera;
+
+/**
+ * Per-frame shader constants in std140 layout
+ * Mirrors the FrameData uniform block declared in the shaders
+ */
+struct FrameData {
+    Math::Mat4 view;
+    Math::Mat4 projection;
+    Math::Mat4 viewProjection;
+    Math::Vec4 viewport;  // width, height, 1/width, 1/height
+    Math::Vec4 time;      // seconds, delta seconds, unused, unused
+    Math::Vec4 cameraRight;  // xyz: world direction of screen +x, w unused
+    Math::Vec4 cameraDown;   // xyz: world direction of screen +y, w: alpha cutoff (0 in 2D)
+};
+
+static_assert(sizeof(FrameData) == 3 * 64 + 4 * 16, "FrameData must match the std140 block layout");
+
+/**
+ * Uniform buffer holding FrameData, bound once at FRAME_UNIFORM_BINDING
+ * Every program that declares the FrameData block reads the same buffer,
+ * so camera matrices are uploaded once per frame instead of per program
+ */
+class FrameUniforms {
+public:
+    FrameUniforms();
+    ~FrameUniforms();
+
+    /**
+     * Create buffer and bind it to its binding point
+     * Requires a current GL context
+     */
+    void initialize();
+
+    /**
+     * Upload camera matrices and timing for this frame
+     */
+    void update(const Camera& camera, float time, float deltaTime);
+
+    /**
+     * Upload isometric camera matrices, billboard axes and alpha cutoff
+     * Fragments with alpha below alphaCutoff are discarded so they don't
+     * write depth
+     */
+    void update(const IsometricCamera& camera, float alphaCutoff, float time, float deltaTime);
+
+    /**
+     * Upload explicit frame data
+     */
+    void update(const FrameData& frameData);
+
+    /**
+     * Get data uploaded by the last update
+     */
+    const FrameData& getData() const { return data; }
+
+private:
+    unsigned int UBO;
+    FrameData data;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Check if the current context is at least the given GL version
+ */
+bool hasGLVersion(int major, int minor);
+
+/**
+ * Check if the current context exposes an extension
+ */
+bool hasGLExtension(const char* extension);
+
+/**
+ * GL entry points that change pipeline state
+ * The default backend forwards to OpenGL; tests substitute a recording fake
+ * so state tracking can be verified without a GPU
+ */
+class GLBackend {
+public:
+    virtual ~GLBackend() = default;
+
+    virtual void useProgram(unsigned int program) = 0;
+    virtual void activeTexture(unsigned int unit) = 0;
+    virtual void bindTexture(unsigned int target, unsigned int texture) = 0;
+    virtual void bindVertexArray(unsigned int vertexArray) = 0;
+    virtual void setBlendEnabled(bool enabled) = 0;
+    virtual void blendFunc(unsigned int sourceFactor, unsigned int destFactor) = 0;
+    virtual void viewport(int x, int y, int width, int height) = 0;
+    virtual void setDepthTestEnabled(bool enabled) = 0;
+    virtual void depthMask(bool write) = 0;
+
+    /**
+     * Get backend that calls the real OpenGL functions
+     */
+    static GLBackend& getOpenGL();
+};
+
+/**
+ * Blend presets used by the renderer
+ */
+enum class BlendMode {
+    None,
+    Alpha,          // Straight alpha: SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    Premultiplied,  // Cooked textures: ONE, ONE_MINUS_SRC_ALPHA
+    Additive,       // Lights and glow: ONE, ONE
+    Multiply        // Light maps: DST_COLOR, ZERO
+};
+
+/**
+ * Depth buffer usage
+ */
+enum class DepthMode {
+    Disabled,   // 2D passes: draw order alone decides overlap
+    TestWrite,  // Opaque and alpha-tested 3D sprites
+    TestOnly    // Translucent 3D sprites: hidden by opaque ones, never hide others
+};
+
+/**
+ * Shadow copy of bound GL state
+ * Every setter compares against the shadow and only reaches the backend
+ * when the value actually changes. Call invalidate() after any code that
+ * touches GL state without going through the cache.
+ */
+class GLStateCache {
+public:
+    static constexpr unsigned int MAX_TEXTURE_UNITS = 16;
+    static constexpr unsigned int TEXTURE_2D = 0x0DE1;  // GL_TEXTURE_2D
+
+    explicit GLStateCache(GLBackend& backend = GLBackend::getOpenGL());
+
+    void useProgram(unsigned int program);
+    void bindTexture(unsigned int unit, unsigned int texture, unsigned int target = TEXTURE_2D);
+    void bindVertexArray(unsigned int vertexArray);
+    void setBlendMode(BlendMode mode);
+    void setViewport(int x, int y, int width, int height);
+    void setDepthMode(DepthMode mode);
+
+    /**
+     * Forget all shadowed state; the next call to each setter reaches GL
+     */
+    void invalidate();
+
+    /**
+     * Forget units shadowing texture; call after deleting it
+     * GL unbinds a deleted texture, and a new one may reuse its name
+     */
+    void forgetTexture(unsigned int texture);
+
+    /**
+     * Get depth mode last set (Disabled if unknown since invalidate())
+     */
+    DepthMode getDepthMode() const { return depthMode; }
+
+    /**
+     * State change counters
+     */
+    struct Stats {
+        size_t issued;   // Changes forwarded to GL
+        size_t avoided;  // Redundant changes skipped
+    };
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats{0, 0}; }
+
+private:
+    GLBackend& backend;
+
+    // Shadowed state; invalidate() sets sentinels no real value matches
+    unsigned int program;
+    unsigned int activeUnit;
+    unsigned int textures[MAX_TEXTURE_UNITS];
+    unsigned int textureTargets[MAX_TEXTURE_UNITS];
+    unsigned int vertexArray;
+    BlendMode blendMode;
+    bool blendKnown;
+    DepthMode depthMode;
+    bool depthKnown;
+    int viewportRect[4];
+
+    Stats stats;
+
+    bool skip(bool redundant);
+    void selectUnit(unsigned int unit);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
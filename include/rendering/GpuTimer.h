@@ -0,0 +1,54 @@
+#pragma once
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Measures GPU time between begin() and end() with GL_TIME_ELAPSED queries
+ *
+ * Results arrive frames after they're issued, so a small ring of queries
+ * is kept in flight and poll() picks up whichever have finished without
+ * waiting. If every query is still pending, begin() skips that frame
+ * rather than stall. Timer queries don't nest: nothing between begin() and
+ * end() may start another.
+ */
+class GpuTimer {
+public:
+    static constexpr int QUERY_COUNT = 4;
+
+    GpuTimer();
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /**
+     * Create queries; requires a current GL context
+     */
+    void initialize();
+
+    void begin();
+    void end();
+
+    /**
+     * Collect finished queries
+     * @return true if a new result arrived (see getLastTime)
+     */
+    bool poll();
+
+    /**
+     * Get GPU time of the most recently finished query (seconds)
+     */
+    double getLastTime() const { return lastTime; }
+
+private:
+    unsigned int queries[QUERY_COUNT];
+    bool pending[QUERY_COUNT];
+    int next;    // Slot begin() uses
+    int oldest;  // Earliest slot poll() may read
+    bool active;
+    double lastTime;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
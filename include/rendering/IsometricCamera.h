@@ -0,0 +1,153 @@
+#pragma once
+
+#include "core/Math.h"
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Orthographic camera orbiting a 3D world at an isometric angle
+ *
+ * World space is Z-up with the ground on X/Y, laid out like TileGrid:
+ * X is the column (east), Y is the row (south), one unit per pixel at
+ * zoom 1. Yaw turns the camera about Z; quarter turns animate between
+ * the four diagonal views. Overlap comes from the depth buffer, so sprites
+ * and tiles need no CPU depth sort.
+ */
+class IsometricCamera {
+public:
+    // 2:1 pixel-art dimetric; asin(tan(30 deg)) ~= 35.264 gives true isometric
+    static constexpr float DEFAULT_PITCH = 30.0f;
+    static constexpr float DEFAULT_YAW = 45.0f;
+
+    IsometricCamera();
+    IsometricCamera(float viewportWidth, float viewportHeight);
+
+    /**
+     * Initialize camera with viewport dimensions
+     */
+    void initialize(float viewportWidth, float viewportHeight);
+
+    /**
+     * Advance quarter-turn animation
+     */
+    void update(float deltaTime);
+
+    /**
+     * Set point the camera looks at and orbits
+     */
+    void setTarget(const Math::Vec3& target) { this->target = target; }
+    Math::Vec3 getTarget() const { return target; }
+
+    /**
+     * Set yaw in degrees immediately (0 looks north, increasing clockwise from above)
+     */
+    void setYaw(float degrees);
+    float getYaw() const { return yaw; }
+
+    /**
+     * Set pitch above the ground plane in degrees (clamped to 1..89)
+     */
+    void setPitch(float degrees);
+    float getPitch() const { return pitch; }
+
+    /**
+     * Start turning the view 90 degrees (+1 clockwise, -1 counter-clockwise)
+     * Turns queue up, so repeated calls keep rotating
+     */
+    void rotateQuarterTurn(int direction);
+
+    /**
+     * Get which of the four views the camera is in or turning to (0-3)
+     */
+    int getQuarterTurn() const;
+
+    /**
+     * Check if a quarter turn is still animating
+     */
+    bool isRotating() const { return yaw != targetYaw; }
+
+    /**
+     * Set quarter-turn speed in degrees per second
+     */
+    void setRotationSpeed(float degreesPerSecond) { rotationSpeed = degreesPerSecond; }
+
+    /**
+     * Set zoom level (1.0 = one world unit per pixel)
+     */
+    void setZoom(float zoom);
+    float getZoom() const { return zoom; }
+
+    /**
+     * Get view matrix for rendering
+     */
+    Math::Mat4 getViewMatrix() const;
+
+    /**
+     * Get orthographic projection matrix for rendering
+     * Depth covers getDepthRange() world units either side of the target
+     */
+    Math::Mat4 getProjectionMatrix() const;
+
+    /**
+     * Set how far in front of and behind the target geometry stays visible
+     */
+    void setDepthRange(float range);
+    float getDepthRange() const { return depthRange; }
+
+    /**
+     * Get world-space directions of screen +x and screen +y (down)
+     * Sprite quads are spanned by these, so they face the camera and every
+     * pixel takes the depth of the sprite's anchor
+     */
+    Math::Vec3 getRight() const;
+    Math::Vec3 getDown() const;
+
+    /**
+     * Check if a surface with the given world normal faces the camera
+     */
+    bool isFacing(const Math::Vec3& normal) const;
+
+    /**
+     * Get sort depth for a world point; nearer points are higher, matching
+     * Sprite::depth, so translucent sprites can be drawn back to front
+     */
+    float getSortDepth(const Math::Vec3& world) const;
+
+    /**
+     * Convert world position to screen coordinates (origin top-left)
+     */
+    Math::Vec2 worldToScreen(const Math::Vec3& world) const;
+
+    /**
+     * Convert screen coordinates to the world point on the plane Z = height
+     */
+    Math::Vec3 screenToWorld(float screenX, float screenY, float height = 0.0f) const;
+
+    /**
+     * Get viewport dimensions
+     */
+    float getViewportWidth() const { return viewportWidth; }
+    float getViewportHeight() const { return viewportHeight; }
+
+    /**
+     * Update viewport dimensions (call when window resizes)
+     */
+    void setViewportSize(float width, float height);
+
+private:
+    Math::Vec3 target;
+    float yaw;
+    float targetYaw;
+    float pitch;
+    float rotationSpeed;
+    float zoom;
+    float depthRange;
+
+    // Viewport
+    float viewportWidth;
+    float viewportHeight;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/Resources.h"
+#include "rendering/RenderTarget.h"
+#include <cstddef>
+
+namespace Penumbra {
+namespace Rendering {
+
+// Forward declarations
+class GLStateCache;
+struct LightFrame;
+
+/**
+ * Draws a LightFrame as a light map multiplied over the scene
+ *
+ * The light map is rendered at a fraction of the viewport's resolution:
+ * cleared to the ambient color, then each light's visibility fan is added
+ * with radial (and cone) falloff. Blurring the small map softens every
+ * shadow edge into a penumbra for a few full-screen passes over a
+ * downscale-squared fraction of the pixels, and the bilinear upscale in the
+ * final multiply smooths it further.
+ *
+ * 2D frames only: light fans are placed with the frame's view-projection,
+ * so draw after Renderer::beginFrame(const Camera&).
+ */
+class LightRenderer {
+public:
+    static constexpr int DEFAULT_DOWNSCALE = 4;
+    static constexpr int DEFAULT_BLUR_PASSES = 1;
+
+    LightRenderer();
+    ~LightRenderer();
+
+    LightRenderer(const LightRenderer&) = delete;
+    LightRenderer& operator=(const LightRenderer&) = delete;
+
+    /**
+     * Create shaders and the light map for a viewport
+     * All binds go through stateCache, which must outlive the renderer
+     * @param downscale Viewport pixels per light map texel along each axis
+     */
+    void initialize(GLStateCache& stateCache, int viewportWidth, int viewportHeight,
+                    int downscale = DEFAULT_DOWNSCALE);
+
+    /**
+     * Recreate the light map for a new viewport size
+     */
+    void resize(int viewportWidth, int viewportHeight);
+
+    /**
+     * Set number of horizontal + vertical blur passes; 0 gives hard shadows
+     */
+    void setBlurPasses(int passes) { blurPasses = passes < 0 ? 0 : passes; }
+
+    /**
+     * Render frame's light map and multiply it over targetFramebuffer
+     * Leaves targetFramebuffer bound with the full viewport, premultiplied
+     * blending and the depth mode it was called with. Does nothing when the
+     * frame isn't enabled.
+     */
+    void draw(const LightFrame& frame, unsigned int targetFramebuffer = 0);
+
+    /**
+     * Get number of draw calls issued by the last draw()
+     */
+    size_t getDrawCalls() const { return drawCalls; }
+
+    int getMapWidth() const { return mapWidth; }
+    int getMapHeight() const { return mapHeight; }
+
+private:
+    GLStateCache* state;
+    Resources::Shader lightShader;
+    Resources::Shader blurShader;
+    Resources::Shader compositeShader;
+
+    unsigned int lightVAO;
+    unsigned int lightVBO;
+    unsigned int fullscreenVAO;  // No attributes; FULLSCREEN_VERTEX_SHADER uses gl_VertexID
+
+    // Ping-pong light maps; [0] holds the finished map
+    RenderTarget maps[2];
+
+    int viewportWidth;
+    int viewportHeight;
+    int downscale;
+    int mapWidth;
+    int mapHeight;
+    int blurPasses;
+    size_t drawCalls;
+
+    void drawFullscreen();
+};
+
+} // namespace Rendering
+} // namespace Penumbra
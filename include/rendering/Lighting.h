@@ -0,0 +1,229 @@
+#pragma once
+
+#include "core/Handle.h"
+#include "core/Math.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Penumbra {
+
+namespace Game {
+class TileGrid;
+}
+
+namespace Rendering {
+
+/**
+ * 2D light source
+ */
+struct Light {
+    Math::Vec2 position;
+    Math::Color color;
+    float radius;           // World units; nothing beyond it is lit
+    float intensity;        // Scales color
+    Math::Vec2 direction;   // Cone axis (normalized); ignored by point lights
+    float coneAngle;        // Half-angle in radians; pi or more lights every direction
+    bool isStatic;          // Keeps its shadow polygon until it moves or the occluders change
+
+    Light()
+        : position(0.0f, 0.0f)
+        , color(Math::Color::White)
+        , radius(128.0f)
+        , intensity(1.0f)
+        , direction(1.0f, 0.0f)
+        , coneAngle(3.14159265f)
+        , isStatic(false)
+    {}
+
+    /**
+     * Get world-space bounds of everything the light can reach
+     */
+    Math::AABB getBounds() const;
+};
+
+using LightHandle = Resources::Handle<Light>;
+
+/**
+ * Edge between a solid and a non-solid tile, merged with its collinear neighbors
+ */
+struct OccluderSegment {
+    Math::Vec2 start;
+    Math::Vec2 end;
+};
+
+/**
+ * Shadow-casting edges of a TileGrid, cached per chunk
+ *
+ * Each TileGrid::CHUNK_SIZE chunk keeps the boundaries between its solid
+ * and non-solid ground tiles, merged into runs so a wall of n tiles is one
+ * segment rather than n. update() re-extracts only chunks whose
+ * TileGrid::getChunkRevision changed, and everything when the grid itself
+ * changes (a new room), so a static room costs nothing per frame.
+ */
+class OccluderCache {
+public:
+    OccluderCache();
+
+    /**
+     * Bring segments up to date with grid
+     * @return true if any segment changed
+     */
+    bool update(const Game::TileGrid& grid);
+
+    /**
+     * Append segments whose bounds overlap bounds to out
+     */
+    void query(const Math::AABB& bounds, std::vector<OccluderSegment>& out) const;
+
+    /**
+     * Drop every cached chunk (e.g. on room change)
+     */
+    void clear();
+
+    /**
+     * Get revision of the whole set; changes whenever update() changes a segment
+     */
+    uint32_t getRevision() const { return revision; }
+
+    /**
+     * Get number of cached segments, and chunks re-extracted by the last update()
+     */
+    size_t getSegmentCount() const;
+    size_t getChunksRebuilt() const { return chunksRebuilt; }
+
+private:
+    // Segments of one chunk; revision 0 means never extracted
+    struct Chunk {
+        uint32_t revision;
+        std::vector<OccluderSegment> segments;
+    };
+
+    const Game::TileGrid* grid;
+    int chunkColumns;
+    int chunkRows;
+    std::vector<Chunk> chunks;
+    uint32_t revision;
+    size_t chunksRebuilt;
+
+    void rebuildChunk(Chunk& chunk, const Game::TileGrid& grid, int chunkX, int chunkY);
+};
+
+/**
+ * Region a point light can see past a set of occluders
+ *
+ * Rays are cast at every occluder endpoint and just either side of it, and
+ * the nearest hit of each, sorted by angle, outlines the lit area. A square
+ * of the light's radius bounds the result, so rays that miss every occluder
+ * still end.
+ */
+class VisibilityPolygon {
+public:
+    /**
+     * Outline what origin sees within radius
+     */
+    void build(const Math::Vec2& origin, float radius, const std::vector<OccluderSegment>& occluders);
+
+    /**
+     * Get outline in increasing angle order, to be drawn as a fan around the origin
+     */
+    const std::vector<Math::Vec2>& getPoints() const { return points; }
+
+private:
+    std::vector<OccluderSegment> walls;
+    std::vector<float> angles;
+    std::vector<Math::Vec2> points;
+};
+
+/**
+ * Light that survived culling, with its fan in LightFrame::vertices
+ */
+struct VisibleLight {
+    Light light;
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+};
+
+/**
+ * Everything LightRenderer needs to draw one frame's light map
+ * Filled on the simulation thread by LightSystem::update(), then read-only
+ */
+struct LightFrame {
+    bool enabled;
+    Math::Color ambient;  // Light map color where no light reaches
+    std::vector<VisibleLight> lights;
+    std::vector<Math::Vec2> vertices;  // Per light: origin, outline, first outline point again
+
+    LightFrame()
+        : enabled(false)
+        , ambient(Math::Color::White)
+    {}
+
+    void clear()
+    {
+        lights.clear();
+        vertices.clear();
+    }
+};
+
+/**
+ * Owns a room's lights and turns them into LightFrames
+ *
+ * Lights whose bounds miss the view are culled before any shadow work.
+ * Static lights keep their visibility polygon until they move, change
+ * radius, or the occluders change; dynamic lights rebuild theirs each
+ * update(). Nothing here touches GL, so updates can run on the simulation
+ * thread.
+ */
+class LightSystem {
+public:
+    LightSystem();
+
+    LightHandle addLight(const Light& light);
+    void removeLight(LightHandle handle);
+    void clear();
+
+    /**
+     * Get light for editing; nullptr for stale handles
+     */
+    Light* getLight(LightHandle handle) { return lights.get(handle); }
+
+    void setAmbient(const Math::Color& color) { ambient = color; }
+    const Math::Color& getAmbient() const { return ambient; }
+
+    /**
+     * Cull lights against view, build their shadow polygons, and fill out
+     */
+    void update(const OccluderCache& occluders, const Math::AABB& view, LightFrame& out);
+
+    /**
+     * Get counters for the last update()
+     */
+    size_t getLightCount() const { return lights.size(); }
+    size_t getLightsCulled() const { return lightsCulled; }
+    size_t getPolygonsBuilt() const { return polygonsBuilt; }
+
+private:
+    // Cached polygon of a static light, indexed like its handle
+    struct ShadowCache {
+        uint32_t generation;  // 0 means empty
+        uint32_t occluderRevision;
+        Math::Vec2 position;
+        float radius;
+        std::vector<Math::Vec2> points;
+    };
+
+    Resources::HandlePool<Light> lights;
+    std::vector<ShadowCache> caches;
+    Math::Color ambient;
+    VisibilityPolygon visibility;
+    std::vector<OccluderSegment> nearby;
+    size_t lightsCulled;
+    size_t polygonsBuilt;
+
+    const std::vector<Math::Vec2>& polygonFor(LightHandle handle, const Light& light,
+                                              const OccluderCache& occluders);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "core/Math.h"
+#include "core/Resources.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Penumbra {
+
+namespace Game {
+class TileGrid;
+}
+
+namespace Rendering {
+
+// Forward declarations
+class SpriteCommandBuffer;
+
+/**
+ * How particles of one kind (dust, sparks, death bursts) spawn and age
+ * Size and color are interpolated from start to end over each particle's life
+ */
+struct ParticleType {
+    size_t capacity;          // Live particles at most; emission past it is dropped
+    float lifetime;           // Seconds
+    float lifetimeVariance;   // Fraction of lifetime added or removed at random
+    float angle;              // Launch direction, radians
+    float spread;             // Random launch angle either side of angle, radians
+    float speed;              // World units per second
+    float speedVariance;      // Fraction of speed added or removed at random
+    Math::Vec2 acceleration;  // Gravity, wind
+    float drag;               // Fraction of velocity lost per second
+    float startSize;
+    float endSize;
+    Math::Color startColor;
+    Math::Color endColor;
+    Resources::Texture* texture;  // nullptr draws untextured squares
+    Math::Rect textureRect;
+    int layer;
+    bool collide;             // Bounce off solid ground tiles (see ParticleSystem::update)
+    float bounce;             // Fraction of speed kept across a tile hit
+
+    ParticleType()
+        : capacity(1024)
+        , lifetime(1.0f)
+        , lifetimeVariance(0.0f)
+        , angle(0.0f)
+        , spread(3.14159265f)
+        , speed(32.0f)
+        , speedVariance(0.0f)
+        , acceleration(0.0f, 0.0f)
+        , drag(0.0f)
+        , startSize(2.0f)
+        , endSize(2.0f)
+        , startColor(Math::Color::White)
+        , endColor(Math::Color::Transparent)
+        , texture(nullptr)
+        , textureRect(0.0f, 0.0f, 1.0f, 1.0f)
+        , layer(0)
+        , collide(false)
+        , bounce(0.5f)
+    {}
+};
+
+/**
+ * Solid flags of a TileGrid's ground level, one byte per cell
+ * Collision tests touch 1 byte per cell instead of a whole Tile, and stale
+ * chunks are re-read from TileGrid::getChunkRevision, like OccluderCache
+ */
+class SolidTileMask {
+public:
+    SolidTileMask();
+
+    /**
+     * Re-read chunks of grid that changed (everything for a new grid)
+     */
+    void update(const Game::TileGrid& grid);
+
+    /**
+     * Check whether the cell at a world position is solid; outside reads as empty
+     */
+    bool isSolidAt(float worldX, float worldY) const
+    {
+        int x = static_cast<int>(std::floor(worldX * inverseTileSize));
+        int y = static_cast<int>(std::floor(worldY * inverseTileSize));
+        return x >= 0 && y >= 0 && x < width && y < height &&
+               cells[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] != 0;
+    }
+
+private:
+    const Game::TileGrid* grid;
+    int width;
+    int height;
+    int chunkColumns;
+    int chunkRows;
+    float inverseTileSize;
+    std::vector<uint32_t> chunkRevisions;
+    std::vector<uint8_t> cells;
+};
+
+/**
+ * Fixed-capacity pool of one ParticleType, stored as structure of arrays
+ *
+ * Every attribute is its own float stream, padded to a whole number of
+ * SIMD groups, so update() integrates velocity, position, life, size and
+ * color for 4 (SSE2) or 8 (AVX2, see PENUMBRA_AVX2) particles per
+ * instruction. Dead particles are removed by moving the last live one into
+ * their place, which keeps the pool dense and never allocates, but does
+ * not keep emission order.
+ */
+class ParticlePool {
+public:
+    explicit ParticlePool(const ParticleType& type);
+
+    /**
+     * Spawn up to count particles at position
+     * @return Number spawned (fewer when the pool is full)
+     */
+    size_t emit(const Math::Vec2& position, size_t count);
+
+    /**
+     * Advance every particle by deltaTime and drop expired ones
+     * @param tiles Solid cells to bounce off when the type collides; may be nullptr
+     */
+    void update(float deltaTime, const SolidTileMask* tiles = nullptr);
+
+    /**
+     * Record live particles into buffer
+     * Instanced buffers take all particles as one run of instance records;
+     * vertex buffers fall back to one draw() per particle
+     */
+    void draw(SpriteCommandBuffer& buffer) const;
+
+    void clear() { count = 0; }
+
+    const ParticleType& getType() const { return type; }
+    size_t getCount() const { return count; }
+    size_t getCapacity() const { return type.capacity; }
+
+    /**
+     * Get a live particle's position (index < getCount())
+     */
+    Math::Vec2 getPosition(size_t index) const
+    {
+        return Math::Vec2(streams[POSITION_X * stride + index], streams[POSITION_Y * stride + index]);
+    }
+
+private:
+    enum Stream {
+        POSITION_X,
+        POSITION_Y,
+        VELOCITY_X,
+        VELOCITY_Y,
+        LIFE,              // Seconds left
+        INVERSE_LIFETIME,  // 1 / starting life
+        SIZE,
+        COLOR_R,
+        COLOR_G,
+        COLOR_B,
+        COLOR_A,
+        STREAM_COUNT
+    };
+
+    ParticleType type;
+    size_t count;
+    size_t stride;  // Floats per stream
+    std::vector<float> streams;
+    uint32_t randomState;
+
+    float* stream(Stream which) { return streams.data() + static_cast<size_t>(which) * stride; }
+    const float* stream(Stream which) const { return streams.data() + static_cast<size_t>(which) * stride; }
+    float random();  // Uniform in [-1, 1]
+    void collide(size_t index, float deltaTime, const SolidTileMask& tiles);
+};
+
+/**
+ * Name of the kernel ParticlePool::update() uses ("AVX2", "SSE2" or "scalar")
+ */
+const char* getParticleKernelName();
+
+/**
+ * One ParticlePool per particle type
+ * Nothing here touches GL: update and record on the simulation thread,
+ * into a FramePacket's sprite buffer
+ */
+class ParticleSystem {
+public:
+    /**
+     * Add a particle type and get its index for emit()
+     */
+    size_t addType(const ParticleType& type);
+
+    /**
+     * Spawn particles of a type; returns the number spawned
+     */
+    size_t emit(size_t type, const Math::Vec2& position, size_t count);
+
+    /**
+     * Advance every pool
+     * @param grid Room colliding types bounce in; may be nullptr
+     */
+    void update(float deltaTime, const Game::TileGrid* grid = nullptr);
+
+    /**
+     * Record every pool into buffer
+     */
+    void draw(SpriteCommandBuffer& buffer) const;
+
+    /**
+     * Drop every live particle
+     */
+    void clear();
+
+    ParticlePool& getPool(size_t type) { return *pools[type]; }
+    size_t getTypeCount() const { return pools.size(); }
+    size_t getParticleCount() const;
+
+private:
+    std::vector<std::unique_ptr<ParticlePool>> pools;
+    SolidTileMask tiles;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * On-disk cache of linked GL program binaries
+ *
+ * Keyed by a hash of the shader sources plus the GL vendor, renderer and
+ * version strings, so a driver update invalidates every entry. Uses
+ * glGetProgramBinary/glProgramBinary (GL 4.1 or GL_ARB_get_program_binary);
+ * on drivers without it every call is a miss and programs compile from source.
+ */
+class ProgramCache {
+public:
+    /**
+     * Get singleton instance
+     */
+    static ProgramCache& getInstance();
+
+    /**
+     * Initialize cache directory and probe driver support
+     * Requires a current GL context
+     * @param directory Cache directory (created if missing), normally
+     *                  getUserDataPath()/shader_cache
+     */
+    void initialize(const std::string& directory);
+
+    /**
+     * Check if program binaries can be retrieved and reloaded on this driver
+     */
+    bool isSupported() const { return supported; }
+
+    /**
+     * Compute cache key for a vertex/fragment source pair on the current driver
+     */
+    uint64_t makeKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    /**
+     * Create a program from a cached binary
+     * A binary the driver rejects is deleted from disk and reported as a miss
+     * @return true if outProgramID is a linked program
+     */
+    bool load(uint64_t key, unsigned int& outProgramID);
+
+    /**
+     * Store binary of a linked program
+     * The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+     */
+    void store(uint64_t key, unsigned int programID);
+
+    /**
+     * Cache statistics since initialize()
+     */
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t rejected;
+        size_t stored;
+    };
+    const Stats& getStats() const { return stats; }
+
+private:
+    ProgramCache();
+    ProgramCache(const ProgramCache&) = delete;
+    ProgramCache& operator=(const ProgramCache&) = delete;
+
+    std::string directory;
+    uint64_t driverHash;
+    bool supported;
+    Stats stats;
+
+    std::string getEntryPath(uint64_t key) const;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "core/Math.h"
+#include <algorithm>
+
+namespace Penumbra {
+namespace Rendering {
+
+// Forward declarations
+class GLStateCache;
+
+/**
+ * How a render target's texture is sampled when drawn at another size
+ */
+enum class RenderTargetFilter {
+    Nearest,  // Crisp pixel art at integer scales
+    Linear    // Smooth upscale of low-frequency data (light maps)
+};
+
+/**
+ * Offscreen framebuffer with a color texture and optional depth buffer
+ */
+class RenderTarget {
+public:
+    RenderTarget();
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    /**
+     * (Re)create storage; requires a current GL context
+     * The texture is bound through stateCache (which must outlive the
+     * target); leaves the default framebuffer bound
+     * @param depth Attach a depth buffer (isometric frames depth-test)
+     * @return false if the framebuffer is incomplete
+     */
+    bool create(GLStateCache& stateCache, int width, int height, RenderTargetFilter filter, bool depth);
+
+    /**
+     * Delete GL objects
+     */
+    void release();
+
+    bool isValid() const { return framebuffer != 0; }
+    unsigned int getFramebuffer() const { return framebuffer; }
+    unsigned int getTexture() const { return texture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    GLStateCache* state;
+    unsigned int framebuffer;
+    unsigned int texture;
+    unsigned int depthBuffer;
+    int width;
+    int height;
+};
+
+/**
+ * Placement of a low-resolution image scaled by a whole number into a window
+ */
+struct IntegerUpscale {
+    int scale;
+    int x, y;           // Bottom-left of the image in the window (GL viewport origin)
+    int width, height;  // Source size * scale
+};
+
+/**
+ * Largest whole scale of source that fits the window, centered
+ * Never below 1, so a source larger than the window is cropped, not shrunk
+ */
+inline IntegerUpscale fitIntegerUpscale(int sourceWidth, int sourceHeight, int windowWidth, int windowHeight)
+{
+    IntegerUpscale fit;
+    fit.scale = std::max(std::min(windowWidth / std::max(sourceWidth, 1), windowHeight / std::max(sourceHeight, 1)), 1);
+    fit.width = sourceWidth * fit.scale;
+    fit.height = sourceHeight * fit.scale;
+    fit.x = (windowWidth - fit.width) / 2;
+    fit.y = (windowHeight - fit.height) / 2;
+    return fit;
+}
+
+/**
+ * Effects applied while the world target is upscaled to the window
+ * The defaults change nothing, and then the upscale is a plain copy
+ */
+struct PostSettings {
+    float vignette;          // Darkening at the corners, 0-1
+    float vignetteRadius;    // Distance from center (1 = corner) where darkening starts
+    float vignetteSoftness;  // Distance over which it fades in
+    float brightness;        // Added to color
+    float contrast;          // Scale about mid-gray
+    float saturation;        // 0 = grayscale, 1 = unchanged
+    Math::Color tint;        // Multiplied into color
+
+    PostSettings()
+        : vignette(0.0f)
+        , vignetteRadius(0.6f)
+        , vignetteSoftness(0.5f)
+        , brightness(0.0f)
+        , contrast(1.0f)
+        , saturation(1.0f)
+        , tint(Math::Color::White)
+    {}
+
+    bool isNeutral() const
+    {
+        return vignette <= 0.0f && brightness == 0.0f && contrast == 1.0f && saturation == 1.0f &&
+               tint.r == 1.0f && tint.g == 1.0f && tint.b == 1.0f;
+    }
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "core/Math.h"
+#include "rendering/Camera.h"
+#include "rendering/DebugDraw.h"
+#include "rendering/IsometricCamera.h"
+#include "rendering/Lighting.h"
+#include "rendering/RenderTarget.h"
+#include "rendering/SpriteCommandBuffer.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+
+// Forward declarations
+class Renderer;
+
+/**
+ * Everything the render thread needs to draw one frame
+ * Filled by the simulation thread between RenderThread::beginFrame() and
+ * submitFrame(), then read-only until the render thread is done with it.
+ * Textures and shaders it points to must stay alive until then.
+ */
+struct FramePacket {
+    bool isometric;
+    Camera camera;
+    IsometricCamera isometricCamera;
+    Math::Color clearColor;
+    uint64_t frameNumber;
+    double inputTime;  // When this frame's input was polled (Platform::Time), for latency tracking
+
+    // One buffer per recording thread; [0] belongs to the simulation thread
+    std::vector<SpriteCommandBuffer> sprites;
+
+    // Light map multiplied over sprites when lighting.enabled, in 2D frames (see LightSystem::update)
+    LightFrame lighting;
+
+    // Applied when the world is upscaled (see Renderer::setWorldResolution)
+    PostSettings post;
+
+    // UI sprites in window pixels, drawn after lighting and the upscale so
+    // they stay unlit and at native resolution (see Renderer::beginOverlay)
+    SpriteCommandBuffer overlay;
+
+    // Snapshot of RenderThread::getDebugDraw(), drawn over the world when debug is set
+    bool debug;
+    DebugDrawQueue debugDraw;
+
+    FramePacket()
+        : isometric(false)
+        , clearColor(0.2f, 0.2f, 0.2f, 1.0f)
+        , frameNumber(0)
+        , inputTime(0.0)
+        , debug(false)
+    {}
+};
+
+/**
+ * Runs GL submission and presentation on a dedicated thread
+ *
+ * Two FramePackets alternate: while the render thread draws and presents
+ * frame N from one, the simulation thread fills frame N + 1 in the other.
+ * GL driver time and vsync waits then overlap simulation instead of
+ * stalling it.
+ *
+ * Latency: a frame is presented one frame later than when rendered inline,
+ * so input sampled during simulation reaches the screen up to one extra
+ * frame later (16.7 ms at 60 Hz). Turn threading off (setThreaded(false))
+ * where that matters more than throughput.
+ *
+ * Only the thread that owns the GL context may touch GL, so with threading
+ * on, resource loading and other direct GL work go through runWithContext().
+ */
+class RenderThread {
+public:
+    struct Hooks {
+        std::function<void(bool current)> bindContext;  // Make the GL context current on, or release it from, the calling thread
+        std::function<void()> present;                  // Swap buffers
+        std::function<void(const FramePacket&)> presented;  // Optional; called after present(), on the presenting thread
+    };
+
+    /**
+     * Create pipeline; renders inline until setThreaded(true)
+     * The GL context must be current on the calling thread
+     * @param recordingThreads Sprite buffers per packet (see FramePacket::sprites)
+     */
+    RenderThread(Renderer& renderer, const Hooks& hooks, size_t recordingThreads = 1);
+
+    /**
+     * Stop the render thread, presenting any submitted frame, and hand the
+     * GL context back to the calling thread
+     */
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * Switch between a dedicated render thread and inline rendering
+     * Call from the simulation thread between frames; the GL context moves
+     * with the mode
+     */
+    void setThreaded(bool threaded);
+    bool isThreaded() const { return threaded; }
+
+    /**
+     * Start the next frame and get its packet
+     * Blocks while the render thread still reads this packet (it runs at
+     * most one frame behind)
+     */
+    FramePacket& beginFrame(const Camera& camera);
+    FramePacket& beginFrame(const IsometricCamera& camera);
+
+    /**
+     * Get the simulation thread's debug draw queue
+     * submitFrame() copies it into the packet when FramePacket::debug is
+     * set, then drops its frame primitives
+     */
+    DebugDrawQueue& getDebugDraw() { return debugDraw; }
+
+    /**
+     * Hand the packet from beginFrame() over for drawing
+     * Returns as soon as the render thread picks it up; renders and
+     * presents before returning when not threaded
+     */
+    void submitFrame();
+
+    /**
+     * Run task where the GL context is current and wait for it
+     */
+    void runWithContext(const std::function<void()>& task);
+
+    /**
+     * Wait until every submitted frame has been presented
+     */
+    void waitIdle();
+
+    /**
+     * Get number of frames presented so far
+     */
+    uint64_t getFramesPresented() const;
+
+private:
+    static constexpr int NO_PACKET = -1;
+
+    Renderer& renderer;
+    Hooks hooks;
+    FramePacket packets[2];
+    DebugDrawQueue debugDraw;
+    int writeIndex;
+    uint64_t frameNumber;
+    bool threaded;
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    int pendingIndex;    // Submitted, not yet picked up
+    int renderingIndex;  // Being drawn
+    const std::function<void()>* task;
+    bool stopping;
+    uint64_t framesPresented;
+
+    FramePacket& acquirePacket();
+    void threadLoop();
+    void renderPacket(const FramePacket& packet);
+    void presentPacket(const FramePacket& packet);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
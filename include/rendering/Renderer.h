@@ -2,39 +2,38 @@
 
 #include "core/Math.h"
 #include "core/Resources.h"
+#include "rendering/Camera.h"
+#include "rendering/DebugDraw.h"
+#include "rendering/FrameUniforms.h"
+#include "rendering/DrawSort.h"
+#include "rendering/DynamicResolution.h"
+#include "rendering/Font.h"
+#include "rendering/GLState.h"
+#include "rendering/GpuTimer.h"
+#include "rendering/LightRenderer.h"
+#include "rendering/RenderTarget.h"
+#include "rendering/Sprite.h"
+#include "rendering/SpriteCommandBuffer.h"
+#include "rendering/StreamBuffer.h"
+#include <cstdint>
 #include <vector>
 
 namespace Penumbra {
 namespace Rendering {
 
 // Forward declarations
-class Camera;
-
-/**
- * Sprite render data
- */
-struct Sprite {
-    Math::Vec2 position;
-    Math::Vec2 size;
-    Math::Rect textureRect;
-    Math::Color color;
-    float rotation;
-    Math::Vec2 origin;
-    int layer;
-
-    Sprite()
-        : position(0.0f, 0.0f)
-        , size(16.0f, 16.0f)
-        , textureRect(0.0f, 0.0f, 1.0f, 1.0f)
-        , color(Math::Color::White)
-        , rotation(0.0f)
-        , origin(0.5f, 0.5f)
-        , layer(0)
-    {}
-};
+class IsometricCamera;
 
 /**
  * Batch renderer for efficient sprite rendering
+ *
+ * Sprites are queued with a sort key (layer, depth, texture, shader) and
+ * radix-sorted when the batch is flushed, so callers may submit in any
+ * order. Sprites with equal layer and depth keep submission order; among
+ * those, texture and shader changes are grouped to minimize draw calls.
+ *
+ * Sprites may also be recorded on other threads into SpriteCommandBuffers
+ * and merged with submit(); only the render thread touches the batch.
  */
 class SpriteBatch {
 public:
@@ -42,15 +41,57 @@ public:
     ~SpriteBatch();
 
     /**
-     * Initialize sprite batch with maximum sprite count
+     * Largest batch addressable with 16-bit indices
+     */
+    static constexpr size_t MAX_BATCH_SPRITES = 65536 / 4;
+
+    /**
+     * Initialize sprite batch with maximum sprite count per draw call
+     * (clamped to MAX_BATCH_SPRITES in Vertices mode)
+     * All binds go through stateCache, which must outlive the batch
+     * @param mode Instanced moves transform work to the GPU; shaders passed
+     *             to begin() must then expand instance records
+     */
+    void initialize(GLStateCache& stateCache, size_t maxSprites = 10000,
+                    SpriteBatchMode mode = SpriteBatchMode::Vertices);
+
+    SpriteBatchMode getMode() const { return mode; }
+
+    /**
+     * Get the axes sprite quads are spanned along since the last begin()
      */
-    void initialize(size_t maxSprites = 10000);
+    const SpriteAxes& getAxes() const { return axes; }
+
+    /**
+     * Get the axes begin() would use for a camera
+     */
+    static SpriteAxes axesFor(const Camera& camera);
+    static SpriteAxes axesFor(const IsometricCamera& camera);
 
     /**
      * Begin batching sprites
      */
     void begin(const Camera& camera, Resources::Shader* shader, Resources::Texture* texture);
 
+    /**
+     * Begin batching sprites in an isometric view
+     * Sprites are anchored at (position, z) in world space and spanned along
+     * the camera's screen axes, so they face the camera at any yaw
+     */
+    void begin(const IsometricCamera& camera, Resources::Shader* shader, Resources::Texture* texture);
+
+    /**
+     * Set texture for following sprites (nullptr draws untextured)
+     * Switching is free: one draw call binds up to MAX_TEXTURE_SLOTS
+     * textures, and a batch only breaks when those run out
+     */
+    void setTexture(Resources::Texture* texture);
+
+    /**
+     * Set shader for following sprites
+     */
+    void setShader(Resources::Shader* shader);
+
     /**
      * Submit sprite to batch
      */
@@ -73,50 +114,99 @@ public:
               const Math::Color& color = Math::Color::White,
               float rotation = 0.0f);
 
+    /**
+     * Merge sprites recorded into buffer
+     * Records are copied on the next flush, so buffer must stay unchanged
+     * until then; its mode must match the batch's
+     */
+    void submit(const SpriteCommandBuffer& buffer);
+
     /**
      * End batching and render all sprites
      */
     void end();
 
     /**
-     * Flush current batch immediately
+     * Sort and render all queued sprites now
+     * Needed only before drawing something outside the batch that must
+     * layer correctly against it
      */
     void flush();
 
     /**
-     * Get number of sprites in current batch
+     * Get number of queued sprites
      */
-    size_t getSpriteCount() const { return spriteCount; }
+    size_t getSpriteCount() const { return commands.size(); }
 
     /**
-     * Get number of draw calls in last frame
+     * Get number of draw calls since the last begin()
      */
     size_t getDrawCalls() const { return drawCalls; }
 
-private:
-    struct Vertex {
-        Math::Vec3 position;
-        Math::Vec2 texCoord;
-        Math::Vec4 color;
-    };
+    /**
+     * Get number of sprites flushed since the last begin()
+     */
+    size_t getSpritesDrawn() const { return spritesDrawn; }
 
+private:
     unsigned int VAO;
-    unsigned int VBO;
     unsigned int EBO;
 
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    SpriteBatchMode mode;
+
+    // Sprite records (four SpriteVertex or one SpriteInstance each) are written straight
+    // into the mapped stream; writeTarget is non-null while a reservation is open
+    StreamBuffer vertexStream;
+    unsigned char* writeTarget;
+    size_t recordSize;
+    size_t batchCapacity;
+
+    GLStateCache* state;
 
     size_t maxSprites;
-    size_t spriteCount;
+    size_t spriteCount;  // Records written to the open GPU batch
     size_t drawCalls;
+    size_t spritesDrawn;
+
+    // Commands with this bit set in their index refer to submittedRecords
+    static constexpr uint32_t SUBMITTED_RECORD = 0x80000000u;
+
+    // Queued sprites and their sort keys; key slots index the per-flush tables
+    std::vector<Sprite> queued;
+    std::vector<const void*> submittedRecords;
+    std::vector<uint32_t> slotRemap;
+
+    // Run of sprites waiting for the vertex kernel, in key order, with their batch slots
+    std::vector<const Sprite*> pendingSprites;
+    std::vector<uint8_t> pendingSlots;
+    std::vector<DrawCommand> commands;
+    std::vector<DrawCommand> sortScratch;
+    std::vector<Resources::Texture*> textureSlots;
+    std::vector<Resources::Shader*> shaderSlots;
+    uint32_t currentTextureSlot;
+    uint32_t currentShaderSlot;
 
     Resources::Shader* currentShader;
     Resources::Texture* currentTexture;
+    // State of the open GPU batch: one shader, up to MAX_TEXTURE_SLOTS textures
+    Resources::Shader* batchShader;
+    std::vector<Resources::Texture*> batchTextures;
     Math::Mat4 viewProjection;
 
+    SpriteAxes axes;
+
     void setupBuffers();
-    void addSpriteVertices(const Sprite& sprite);
+    void beginBatch(Resources::Shader* shader, Resources::Texture* texture);
+    void resetQueue();
+    uint32_t textureSlotFor(Resources::Texture* texture);
+    uint32_t shaderSlotFor(Resources::Shader* shader);
+    uint8_t batchSlotFor(Resources::Texture* texture);
+    unsigned char* nextRecord();
+    void writePendingSprites();
+    void writeRecord(const void* record, uint8_t textureSlot);
+    void submitBatch(bool releaseSlots = true);
+    void reserveBatch();
+    void setInstanceAttributes(size_t offset);
 };
 
 /**
@@ -125,27 +215,148 @@ private:
 class Renderer {
 public:
     Renderer();
+    explicit Renderer(GLBackend& backend);
+    ~Renderer();
 
     /**
      * Initialize renderer
+     * @param batchMode Sprite submission path; the default shader matches it
      */
-    void initialize(int windowWidth, int windowHeight);
+    void initialize(int windowWidth, int windowHeight,
+                    SpriteBatchMode batchMode = SpriteBatchMode::Vertices);
 
     /**
      * Begin frame
+     * Uploads frame uniforms, clears, and begins the sprite batch with the
+     * default shader; callers draw through getSpriteBatch()
      */
     void beginFrame(const Camera& camera);
 
+    /**
+     * Begin a depth-tested isometric frame
+     * Opaque and cut-out sprites may be drawn in any order: the depth buffer
+     * resolves overlap, and texels with alpha below the alpha cutoff are
+     * discarded instead of writing depth
+     */
+    void beginFrame(const IsometricCamera& camera);
+
+    /**
+     * Switch an isometric frame to translucent sprites
+     * Flushes opaque sprites, then keeps depth testing but stops depth
+     * writes and alpha cutoff. Give translucent sprites
+     * IsometricCamera::getSortDepth() as their depth so the batch draws them
+     * back to front.
+     */
+    void beginTranslucentPass();
+
+    /**
+     * Set alpha below which isometric sprite texels are discarded (0-1)
+     */
+    void setAlphaCutoff(float cutoff) { alphaCutoff = Math::clamp(cutoff, 0.0f, 1.0f); }
+
+    /**
+     * Set number of command buffers sprites can be recorded into off the
+     * render thread, typically Jobs::JobSystem::getThreadCount()
+     */
+    void setCommandBufferCount(size_t count);
+
+    /**
+     * Get command buffer for a recording thread
+     * Buffers are begun by beginFrame() and merged into the sprite batch by
+     * submitCommandBuffers() or endFrame(). Distinct buffers may be filled
+     * concurrently, e.g. one per thread index from JobSystem::dispatch().
+     */
+    SpriteCommandBuffer& getCommandBuffer(size_t thread) { return commandBuffers[thread]; }
+    size_t getCommandBufferCount() const { return commandBuffers.size(); }
+
+    /**
+     * Merge and draw everything recorded into command buffers so far, then
+     * clear them for further recording
+     * Call before beginTranslucentPass() if workers recorded opaque sprites.
+     */
+    void submitCommandBuffers();
+
+    /**
+     * Finish the world and start drawing UI at window resolution
+     * Submits command buffers and flushes the world; with a world
+     * resolution set, integer-upscales the world target to the window
+     * through the post settings. The sprite batch and command buffers are
+     * then begun again with a 2D camera spanning the window in pixels,
+     * depth testing off.
+     * Called by endFrame() if not called before
+     */
+    void beginOverlay();
+
     /**
      * End frame
+     * Submits command buffers, then draws the rest of the sprite batch
      */
     void endFrame();
 
+    /**
+     * Render the world offscreen at a fixed low resolution
+     * Frames are drawn into a width x height target and integer-upscaled
+     * to the window by beginOverlay(), so fill cost drops with the square
+     * of the scale. Cameras passed to beginFrame() should use the world
+     * size as their viewport. 0 x 0 draws straight to the window.
+     * Requires the GL context
+     */
+    void setWorldResolution(int width, int height);
+
+    /**
+     * Get size frames are rendered at (the window's without a world target)
+     */
+    int getWorldWidth() const { return worldTarget.isValid() ? worldTarget.getWidth() : windowWidth; }
+    int getWorldHeight() const { return worldTarget.isValid() ? worldTarget.getHeight() : windowHeight; }
+
+    /**
+     * Scale the world target's rendered area with GPU frame time
+     * Each frame renders into the bottom-left scale x scale of the world
+     * target, picked by getDynamicResolution() from timer queries, and the
+     * upscale stretches that area over the same window rect, so UI and the
+     * letterbox don't move. Needs a world resolution; off by default
+     */
+    void setDynamicResolution(bool enabled);
+    bool isDynamicResolution() const { return dynamicResolutionEnabled; }
+
+    /**
+     * Get dynamic resolution controller (e.g. to set its frame budget)
+     */
+    DynamicResolution& getDynamicResolution() { return dynamicResolution; }
+
+    /**
+     * Set effects applied when the world target is upscaled
+     */
+    void setPostSettings(const PostSettings& settings) { post = settings; }
+    const PostSettings& getPostSettings() const { return post; }
+
     /**
      * Get sprite batch for rendering
      */
     SpriteBatch& getSpriteBatch() { return spriteBatch; }
 
+    /**
+     * Get shader sprites use unless told otherwise
+     */
+    Resources::Shader* getDefaultShader() { return &defaultShader; }
+
+    /**
+     * Get the built-in 5x7 pixel font (page uploaded by initialize())
+     * Immutable after initialize(), so any thread may lay text out with it
+     */
+    const Font& getDefaultFont() const { return defaultFont; }
+
+    /**
+     * Get GL state cache; code that binds GL state directly must call
+     * invalidate() on it afterwards
+     */
+    GLStateCache& getStateCache() { return glState; }
+
+    /**
+     * Get per-frame uniform buffer (uploaded from the camera in beginFrame)
+     */
+    const FrameUniforms& getFrameUniforms() const { return frameUniforms; }
+
     /**
      * Set clear color
      */
@@ -172,6 +383,26 @@ public:
     void drawLine(const Math::Vec2& start, const Math::Vec2& end,
                   const Math::Color& color, float thickness = 1.0f);
 
+    /**
+     * Draw a debug queue over everything drawn so far
+     * Flushes the sprite batch, then draws all triangles and all lines in
+     * one draw call each with depth testing off; call last in the frame.
+     * Does nothing when PENUMBRA_DEBUG_DRAW is off
+     */
+    void drawDebug(const DebugDrawQueue& queue);
+
+    /**
+     * Multiply a frame's light map over everything drawn so far
+     * Flushes the sprite batch first; sprites queued afterwards (UI) stay
+     * unlit. 2D frames only
+     */
+    void drawLighting(const LightFrame& frame);
+
+    /**
+     * Get light map renderer (e.g. to change its blur)
+     */
+    LightRenderer& getLightRenderer() { return lightRenderer; }
+
     /**
      * Enable/disable debug rendering
      */
@@ -185,14 +416,59 @@ public:
         size_t drawCalls;
         size_t spritesDrawn;
         size_t verticesDrawn;
+        size_t stateChanges;         // Program/texture/VAO/blend/viewport changes sent to GL
+        size_t stateChangesAvoided;  // Redundant changes skipped by the state cache
+        float resolutionScale;       // Fraction of the world resolution rendered, per axis
+        double gpuFrameTime;         // Seconds; from timer queries, a few frames old
     };
     const Stats& getStats() const { return stats; }
 
 private:
+    GLStateCache glState;
     SpriteBatch spriteBatch;
+    std::vector<SpriteCommandBuffer> commandBuffers;
+    FrameUniforms frameUniforms;
+    Resources::Shader defaultShader;
+    Font defaultFont;
+    Resources::Texture defaultFontPage;
+    LightRenderer lightRenderer;
+    size_t lightDrawCalls;
+    int windowWidth;
+    int windowHeight;
+
+    // Low-resolution world (see setWorldResolution)
+    RenderTarget worldTarget;
+    PostSettings post;
+    Resources::Shader upscaleShader;
+    Resources::Shader postShader;
+    unsigned int fullscreenVAO;
+    Camera overlayCamera;
+    bool overlayBegun;
+    int renderWidth;   // Part of the world target drawn this frame
+    int renderHeight;
+    GpuTimer gpuTimer;
+    DynamicResolution dynamicResolution;
+    bool dynamicResolutionEnabled;
+    size_t worldDrawCalls;
+    size_t worldSpritesDrawn;
+
+    double lastFrameTime;
     Math::Color clearColor;
+    float alphaCutoff;
     bool debugMode;
     Stats stats;
+
+#if PENUMBRA_DEBUG_DRAW
+    unsigned int debugVAO;
+    unsigned int debugVBO;
+    Resources::Shader debugShader;
+    size_t debugDrawCalls;
+#endif
+
+    float prepareFrame(DepthMode depthMode);
+    void beginCommandBuffers();
+    void drawUpscale();
+    void applyRenderScale(float scale);
 };
 
 } // namespace Rendering
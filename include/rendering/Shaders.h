@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Resources.h"
 #include <string>
 
 namespace Penumbra {
@@ -21,6 +22,12 @@ extern const char* DEFAULT_VERTEX_SHADER;
  */
 extern const char* DEFAULT_FRAGMENT_SHADER;
 
+/**
+ * Instanced sprite vertex shader
+ * Expands one SpriteBatch instance record into a quad from gl_VertexID
+ */
+extern const char* INSTANCED_SPRITE_VERTEX_SHADER;
+
 /**
  * Passthrough vertex shader (no transformations)
  */
@@ -32,10 +39,82 @@ extern const char* PASSTHROUGH_VERTEX_SHADER;
 extern const char* SOLID_COLOR_FRAGMENT_SHADER;
 
 /**
- * Debug wireframe fragment shader
+ * Debug primitive vertex shader (DebugVertex: aPosition, aColor)
+ */
+extern const char* DEBUG_VERTEX_SHADER;
+
+/**
+ * Debug primitive fragment shader (premultiplied vertex color)
  */
 extern const char* DEBUG_FRAGMENT_SHADER;
 
+/**
+ * Fullscreen triangle vertex shader
+ * Needs no vertex buffer: draw 3 vertices from an empty VAO; outputs vTexCoord
+ */
+extern const char* FULLSCREEN_VERTEX_SHADER;
+
+/**
+ * Fullscreen triangle sampling only the bottom-left uSourceRegion
+ * (fraction of the texture per axis); for dynamic resolution upscales
+ */
+extern const char* UPSCALE_VERTEX_SHADER;
+
+/**
+ * Texture copy fragment shader (uTexture at vTexCoord)
+ */
+extern const char* COPY_FRAGMENT_SHADER;
+
+/**
+ * Post-processing fragment shader (uTexture at vTexCoord)
+ * Color grade (uGrade: brightness, contrast, saturation; uTint) then
+ * vignette (uVignette: strength, radius, softness); see PostSettings
+ */
+extern const char* POST_FRAGMENT_SHADER;
+
+/**
+ * Separable 9-tap Gaussian blur fragment shader
+ * uTexelStep is one texel along the blur axis
+ */
+extern const char* BLUR_FRAGMENT_SHADER;
+
+/**
+ * Light fan shaders (world-space aPosition)
+ * Radial falloff from uLightPosition, masked to a cone when uLightCone.x > -1
+ */
+extern const char* LIGHT_VERTEX_SHADER;
+extern const char* LIGHT_FRAGMENT_SHADER;
+
+/**
+ * Name and binding point of the per-frame std140 uniform block (see FrameUniforms)
+ */
+constexpr const char* FRAME_UNIFORM_BLOCK = "FrameData";
+constexpr unsigned int FRAME_UNIFORM_BINDING = 0;
+
+/**
+ * Pre-hashed names of uniforms used by the built-in shaders
+ */
+constexpr Resources::UniformID UNIFORM_TEXTURE("uTexture");
+constexpr Resources::UniformID UNIFORM_TEXTURES("uTextures");
+constexpr Resources::UniformID UNIFORM_COLOR("uColor");
+constexpr Resources::UniformID UNIFORM_TEXEL_STEP("uTexelStep");
+constexpr Resources::UniformID UNIFORM_SOURCE_REGION("uSourceRegion");
+constexpr Resources::UniformID UNIFORM_GRADE("uGrade");
+constexpr Resources::UniformID UNIFORM_TINT("uTint");
+constexpr Resources::UniformID UNIFORM_VIGNETTE("uVignette");
+constexpr Resources::UniformID UNIFORM_LIGHT_POSITION("uLightPosition");
+constexpr Resources::UniformID UNIFORM_LIGHT_RADIUS("uLightRadius");
+constexpr Resources::UniformID UNIFORM_LIGHT_COLOR("uLightColor");
+constexpr Resources::UniformID UNIFORM_LIGHT_DIRECTION("uLightDirection");
+constexpr Resources::UniformID UNIFORM_LIGHT_CONE("uLightCone");
+
+/**
+ * Sampler slots in the sprite shaders' uTextures array
+ * Sprites carry a slot per vertex/instance; TEXTURE_SLOT_NONE is untextured
+ */
+constexpr unsigned int MAX_TEXTURE_SLOTS = 8;
+constexpr unsigned int TEXTURE_SLOT_NONE = 255;
+
 /**
  * Utility function to compile shader from source
  * @param source Shader source code
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "core/Math.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Sprite render data
+ */
+struct Sprite {
+    Math::Vec2 position;
+    Math::Vec2 size;
+    Math::Rect textureRect;
+    Math::Color color;
+    float rotation;     // Radians, about origin
+    Math::Vec2 origin;  // Normalized pivot within size
+    int layer;          // Draw order; higher layers draw on top
+    float depth;        // Order within a layer (e.g. isometric depth); higher draws on top
+    float z;            // World height under an IsometricCamera; ignored in 2D
+
+    Sprite()
+        : position(0.0f, 0.0f)
+        , size(16.0f, 16.0f)
+        , textureRect(0.0f, 0.0f, 1.0f, 1.0f)
+        , color(Math::Color::White)
+        , rotation(0.0f)
+        , origin(0.5f, 0.5f)
+        , layer(0)
+        , depth(0.0f)
+        , z(0.0f)
+    {}
+};
+
+/**
+ * How SpriteBatch feeds sprites to the GPU
+ */
+enum class SpriteBatchMode {
+    Vertices,   // Four pre-transformed vertices per sprite (any vertex shader using aPosition)
+    Instanced   // One instance record per sprite, expanded by INSTANCED_SPRITE_VERTEX_SHADER
+};
+
+/**
+ * Packed quad vertex (24 bytes)
+ * UVs are normalized 16-bit, so texture rects must lie within [0, 1]
+ */
+struct SpriteVertex {
+    float x, y, z;
+    uint16_t u, v;
+    uint8_t r, g, b, a;  // Premultiplied
+    uint8_t textureSlot;
+    uint8_t padding[3];
+};
+static_assert(sizeof(SpriteVertex) == 24, "SpriteVertex must stay tightly packed");
+
+/**
+ * Per-sprite instance record (44 bytes)
+ */
+struct SpriteInstance {
+    float x, y, z, rotation;
+    float width, height;
+    uint16_t u0, v0, u1, v1;   // Normalized texture rect
+    uint16_t originX, originY; // Normalized pivot
+    uint8_t r, g, b, a;        // Premultiplied
+    uint8_t textureSlot;
+    uint8_t padding[3];
+};
+static_assert(sizeof(SpriteInstance) == 44, "SpriteInstance must stay tightly packed");
+
+/**
+ * World directions sprite quads are spanned along
+ * In 2D these are the X and Y axes; under an IsometricCamera they are the
+ * camera's screen axes, and quads are anchored at (position, z)
+ */
+struct SpriteAxes {
+    bool billboard;
+    Math::Vec3 right;
+    Math::Vec3 down;
+
+    SpriteAxes()
+        : billboard(false)
+        , right(1.0f, 0.0f, 0.0f)
+        , down(0.0f, 1.0f, 0.0f)
+    {}
+};
+
+/**
+ * Write a sprite's four vertices (top-left, top-right, bottom-right, bottom-left)
+ * out may be write-combined GPU memory: it is written whole and never read
+ */
+void writeSpriteVertices(const Sprite& sprite, uint8_t textureSlot, const SpriteAxes& axes, SpriteVertex* out);
+
+/**
+ * Write quads for count sprites, four vertices each, into out
+ *
+ * Matches writeSpriteVertices to within float rounding of sin/cos (the
+ * rotation is reduced to +-pi/4, so keep it within a few thousand turns).
+ * Sprites are transformed in groups of 4 (SSE2) or 8 (AVX2, see
+ * PENUMBRA_AVX2), groups with no rotation skip the trig, and 16-byte aligned
+ * destinations get streaming stores. Other targets use the scalar path.
+ */
+void writeSpriteVerticesBatch(const Sprite* const* sprites, const uint8_t* textureSlots, size_t count,
+                              const SpriteAxes& axes, SpriteVertex* out);
+
+/**
+ * Name of the kernel writeSpriteVerticesBatch uses ("AVX2", "SSE2" or "scalar")
+ */
+const char* getSpriteKernelName();
+
+/**
+ * Write a sprite's instance record
+ */
+void writeSpriteInstance(const Sprite& sprite, uint8_t textureSlot, const SpriteAxes& axes, SpriteInstance* out);
+
+} // namespace Rendering
+} // namespace Penumbra
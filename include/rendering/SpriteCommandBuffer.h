@@ -0,0 +1,109 @@
+#pragma once
+
+#include "core/Resources.h"
+#include "rendering/DrawSort.h"
+#include "rendering/Sprite.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Sprites recorded off the render thread, for SpriteBatch::submit()
+ *
+ * Each recording thread owns one buffer, so draw() takes no locks: sprites
+ * are transformed into the buffer's own vertex or instance arena straight
+ * away, and their sort keys use the buffer's own texture and shader slots.
+ * SpriteBatch::submit() remaps those slots and merges the commands into
+ * its queue, so buffers and sprites drawn on the render thread sort
+ * together on the next flush.
+ *
+ * Sprites with equal layer and depth keep submission order only within
+ * one buffer; record sprites that rely on that order from one thread.
+ */
+class SpriteCommandBuffer {
+public:
+    SpriteCommandBuffer();
+
+    /**
+     * Start recording for a batch in the given mode and orientation
+     * (SpriteBatch::getMode() and getAxes(), after SpriteBatch::begin())
+     * @param shader Shader for sprites recorded before any setShader()
+     */
+    void begin(SpriteBatchMode mode, const SpriteAxes& axes, Resources::Shader* shader);
+
+    /**
+     * Drop recorded sprites, keeping the mode, orientation and arena capacity
+     */
+    void clear();
+
+    /**
+     * Set texture for following sprites (nullptr draws untextured)
+     */
+    void setTexture(Resources::Texture* texture);
+
+    /**
+     * Set shader for following sprites
+     */
+    void setShader(Resources::Shader* shader);
+
+    /**
+     * Record sprite
+     */
+    void draw(const Sprite& sprite);
+
+    /**
+     * Record count sprites sharing one layer and depth and return their
+     * instance records for the caller to fill (Instanced mode only)
+     * Records must be written whole; their texture slot is assigned by the
+     * batch. The pointer is valid until the next draw, drawInstances() or clear()
+     */
+    SpriteInstance* drawInstances(size_t count, int layer, float depth = 0.0f);
+
+    /**
+     * Get number of recorded sprites
+     */
+    size_t getSpriteCount() const { return commands.size(); }
+
+    SpriteBatchMode getMode() const { return mode; }
+
+    /**
+     * Recorded commands; keys use this buffer's slots and index the records
+     */
+    const std::vector<DrawCommand>& getCommands() const { return commands; }
+
+    /**
+     * Get a command's record: four SpriteVertex or one SpriteInstance,
+     * with texture slot 0 until the batch assigns one
+     */
+    const void* getRecord(uint32_t index) const
+    {
+        return mode == SpriteBatchMode::Instanced ? static_cast<const void*>(&instances[index])
+                                                  : static_cast<const void*>(&vertices[index * 4]);
+    }
+
+    /**
+     * Slot tables the command keys refer to
+     */
+    const std::vector<Resources::Texture*>& getTextures() const { return textureSlots; }
+    const std::vector<Resources::Shader*>& getShaders() const { return shaderSlots; }
+
+private:
+    SpriteBatchMode mode;
+    SpriteAxes axes;
+    Resources::Shader* defaultShader;
+
+    std::vector<DrawCommand> commands;
+    std::vector<SpriteVertex> vertices;
+    std::vector<SpriteInstance> instances;
+
+    std::vector<Resources::Texture*> textureSlots;
+    std::vector<Resources::Shader*> shaderSlots;
+    uint32_t currentTextureSlot;
+    uint32_t currentShaderSlot;
+};
+
+} // namespace Rendering
+} // namespace Penumbra
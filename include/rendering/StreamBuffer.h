@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * Ring buffer for streaming vertex data written by the CPU every frame
+ *
+ * The ring is split into SEGMENT_COUNT segments. A fence is inserted when
+ * writing leaves a segment and waited on when writing re-enters it, so the
+ * CPU only blocks if the GPU falls a full ring behind.
+ *
+ * With GL_ARB_buffer_storage (core in 4.4) the buffer is mapped once,
+ * persistently and coherently, and callers write straight into GPU-visible
+ * memory. Otherwise each reservation maps an unsynchronized range that no
+ * pending draw reads, and the buffer is orphaned when the ring wraps.
+ */
+class StreamBuffer {
+public:
+    static constexpr size_t SEGMENT_COUNT = 3;
+
+    StreamBuffer();
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * Create buffer storage
+     * Requires a current GL context
+     * @param target Buffer target, e.g. GL_ARRAY_BUFFER
+     * @param segmentSize Bytes per segment; a multiple of alignment
+     * @param alignment Offset granularity of reservations (the vertex stride,
+     *                  so offsets can be used as base vertices)
+     */
+    void initialize(unsigned int target, size_t segmentSize, size_t alignment);
+
+    /**
+     * Reserve space to write into
+     * @param minBytes Smallest useful reservation; at most the segment size
+     * @param outAvailable Receives the writable byte count (>= minBytes)
+     * @return Write-only pointer, valid until commit()
+     */
+    void* reserve(size_t minBytes, size_t& outAvailable);
+
+    /**
+     * Finish writing the current reservation
+     * @param bytes Bytes actually written (0 releases the reservation)
+     * @return Buffer offset of the written data
+     */
+    size_t commit(size_t bytes);
+
+    unsigned int getID() const { return buffer; }
+    bool isPersistent() const { return persistent; }
+
+    /**
+     * Streaming statistics since initialize()
+     */
+    struct Stats {
+        size_t bytesStreamed;
+        size_t fenceWaits;  // Times the CPU had to wait for the GPU
+        size_t orphans;     // Buffer reallocations (fallback path only)
+    };
+    const Stats& getStats() const { return stats; }
+
+private:
+    unsigned int target;
+    unsigned int buffer;
+    size_t segmentSize;
+    size_t alignment;
+    size_t cursor;
+    size_t segment;
+    bool persistent;
+    bool mapped;
+    unsigned char* persistentData;
+    void* fences[SEGMENT_COUNT];
+    Stats stats;
+
+    void enterSegment(size_t next);
+    void waitFence(size_t index);
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "core/Math.h"
+#include "rendering/Font.h"
+#include "rendering/Sprite.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+
+/**
+ * One laid-out glyph, relative to the text's top-left corner
+ */
+struct GlyphQuad {
+    Math::Vec2 position;
+    Math::Vec2 size;
+    Math::Rect textureRect;
+};
+
+/**
+ * Cached layout of a UTF-8 string in a Font
+ *
+ * Keep one per label and call set() every frame: it only lays the text out
+ * again when the string, font or wrap width changed, so static labels cost
+ * nothing beyond queueing their quads.
+ */
+class TextLayout {
+public:
+    TextLayout();
+
+    /**
+     * Lay out text, breaking lines at '\n'
+     * @param wrapWidth Also break at spaces to keep lines within this many
+     *                  pixels (0 disables wrapping)
+     * @return true if the layout was rebuilt
+     */
+    bool set(const Font& font, const std::string& text, float wrapWidth = 0.0f);
+
+    const std::string& getText() const { return text; }
+    const std::vector<GlyphQuad>& getQuads() const { return quads; }
+
+    /**
+     * Get size of the laid-out text in pixels (unscaled)
+     */
+    const Math::Vec2& getSize() const { return size; }
+    size_t getLineCount() const { return lineCount; }
+
+    /**
+     * Queue the glyphs into a SpriteBatch or SpriteCommandBuffer
+     * All glyphs sample the font page, so text shares the batch's draw call
+     * with everything else on the page's texture slot. Leaves the page set
+     * as the target's texture.
+     * @param scale Pixel scale; integers keep bitmap fonts crisp
+     */
+    template<typename SpriteTarget>
+    void draw(SpriteTarget& target, const Math::Vec2& position, const Math::Color& color,
+              float scale = 1.0f, int layer = 0) const;
+
+private:
+    const Font* font;
+    uint32_t fontRevision;
+    std::string text;
+    float wrapWidth;
+
+    std::vector<GlyphQuad> quads;
+    Math::Vec2 size;
+    size_t lineCount;
+
+    void layout();
+};
+
+template<typename SpriteTarget>
+void TextLayout::draw(SpriteTarget& target, const Math::Vec2& position, const Math::Color& color,
+                      float scale, int layer) const
+{
+    if (font == nullptr || quads.empty())
+    {
+        return;
+    }
+
+    target.setTexture(font->getPage());
+
+    Sprite sprite;
+    sprite.origin = Math::Vec2(0.0f, 0.0f);
+    sprite.color = color;
+    sprite.layer = layer;
+    for (const GlyphQuad& quad : quads)
+    {
+        sprite.position = position + quad.position * scale;
+        sprite.size = quad.size * scale;
+        sprite.textureRect = quad.textureRect;
+        target.draw(sprite);
+    }
+}
+
+} // namespace Rendering
+} // namespace Penumbra
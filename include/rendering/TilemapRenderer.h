@@ -0,0 +1,159 @@
+#pragma once
+
+#include "core/Resources.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Penumbra {
+
+namespace Game {
+class TileGrid;
+}
+
+namespace Rendering {
+
+// Forward declarations
+class Camera;
+class GLStateCache;
+class IsometricCamera;
+class SpriteBatch;
+
+/**
+ * Draws a TileGrid, visiting only cells the camera can see
+ *
+ * The visible cell range comes from Camera::getVisibleBounds, so per-frame
+ * cost scales with screen size, not room size.
+ *
+ * Three paths share the culling:
+ *  - draw() queues visible tiles into a SpriteBatch every frame
+ *  - drawRetained() bakes each TileGrid::CHUNK_SIZE chunk into its own
+ *    vertex buffer once and issues one draw call per visible chunk; chunks
+ *    are re-baked only when TileGrid::getChunkRevision says they changed
+ *  - drawIsometric() does the same with every level of the grid baked as
+ *    blocks; faces no camera can see (pressed against solid neighbors) are
+ *    dropped at bake time, and faces turned away from the current view are
+ *    skipped at draw time
+ */
+class TilemapRenderer {
+public:
+    TilemapRenderer();
+    ~TilemapRenderer();
+
+    /**
+     * Create GL resources for drawRetained() and drawIsometric()
+     * All binds go through stateCache, which must outlive the renderer
+     */
+    void initialize(GLStateCache& stateCache);
+
+    /**
+     * Set tileset texture
+     * A tile's textureIndex selects a cell, row-major, in a columns x rows grid
+     * Changing the tileset layout re-bakes every chunk
+     */
+    void setTileset(Resources::Texture* texture, int columns, int rows);
+
+    /**
+     * Set sprite layer tiles are drawn on
+     */
+    void setLayer(int layer) { this->layer = layer; }
+
+    /**
+     * Set extra world-space border around the view
+     * Covers camera shake and sprites that overhang their cell
+     */
+    void setCullMargin(float margin) { cullMargin = margin; }
+
+    /**
+     * Set how many chunks drawRetained() may re-bake per frame
+     * Visible chunks over budget are drawn through the batch for that frame
+     */
+    void setRebuildBudget(size_t chunksPerFrame) { rebuildBudget = chunksPerFrame; }
+
+    /**
+     * Queue visible, non-empty tiles into batch
+     */
+    void draw(SpriteBatch& batch, const Game::TileGrid& grid, const Camera& camera);
+
+    /**
+     * Draw visible chunks from their cached meshes
+     * Flushes batch first, so sprites queued earlier stay beneath the tiles
+     * and sprites queued afterwards draw on top
+     */
+    void drawRetained(SpriteBatch& batch, const Game::TileGrid& grid, const Camera& camera);
+
+    /**
+     * Draw visible chunks as stacked blocks under an isometric camera
+     * Expects Renderer::beginFrame(const IsometricCamera&) so depth testing
+     * resolves overlap. Chunks over the rebuild budget keep their previous
+     * mesh for a frame; chunks never baked appear once they are.
+     */
+    void drawIsometric(SpriteBatch& batch, const Game::TileGrid& grid, const IsometricCamera& camera);
+
+    /**
+     * Drop every cached chunk mesh (e.g. on room change)
+     */
+    void releaseChunks();
+
+    /**
+     * Get number of cells visited and tiles queued through the batch by the last draw
+     */
+    size_t getCellsVisited() const { return cellsVisited; }
+    size_t getTilesDrawn() const { return tilesDrawn; }
+
+    /**
+     * Get retained-path counters for the last drawRetained() or drawIsometric()
+     */
+    size_t getChunksDrawn() const { return chunksDrawn; }
+    size_t getChunksRebuilt() const { return chunksRebuilt; }
+    size_t getFacesDrawn() const { return facesDrawn; }
+
+private:
+    // Face groups in a baked mesh, in Game::TileFace order; flat meshes only use the first
+    static constexpr int FACE_GROUPS = 5;
+
+    /**
+     * Baked chunk mesh; revision 0 means never baked
+     * Quads are stored grouped by face direction so a view draws only the
+     * groups facing it
+     */
+    struct Chunk {
+        unsigned int VAO;
+        unsigned int VBO;
+        uint32_t revision;
+        bool blocks;  // Baked by drawIsometric() rather than drawRetained()
+        uint32_t groupStart[FACE_GROUPS];
+        uint32_t groupCount[FACE_GROUPS];
+    };
+
+    Resources::Texture* tileset;
+    int columns;
+    int rows;
+    int layer;
+    float cullMargin;
+    size_t rebuildBudget;
+    size_t cellsVisited;
+    size_t tilesDrawn;
+    size_t chunksDrawn;
+    size_t chunksRebuilt;
+    size_t facesDrawn;
+
+    GLStateCache* state;
+    Resources::Shader chunkShader;
+    unsigned int EBO;
+
+    // Chunk table for the grid it was built from, row-major like the grid's
+    const Game::TileGrid* chunkGrid;
+    int chunkColumns;
+    int chunkRows;
+    std::vector<Chunk> chunks;
+
+    void queueTiles(SpriteBatch& batch, const Game::TileGrid& grid,
+                    int minX, int minY, int maxX, int maxY);
+    void bindChunkTable(const Game::TileGrid& grid);
+    void rebuildChunk(Chunk& chunk, const Game::TileGrid& grid, int chunkX, int chunkY, bool blocks);
+    void bindChunkProgram();
+};
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,467 @@
+#include "core/CookedAssets.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace Penumbra {
+namespace Assets {
+
+namespace {
+
+/**
+ * Append-only little-endian byte writer
+ */
+class BlobWriter {
+public:
+    template<typename T>
+    void write(const T& value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.append(bytes, sizeof(T));
+    }
+
+    void writeBytes(const void* bytes, size_t size)
+    {
+        data.append(static_cast<const char*>(bytes), size);
+    }
+
+    void writeString(const std::string& value)
+    {
+        write(static_cast<uint32_t>(value.size()));
+        data.append(value);
+    }
+
+    bool saveTo(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(file);
+    }
+
+private:
+    std::string data;
+};
+
+/**
+ * Bounds-checked reader over a loaded blob; any overrun latches failure
+ */
+class BlobReader {
+public:
+    explicit BlobReader(const std::vector<uint8_t>& data) : data(data), cursor(0), failed(false) {}
+
+    template<typename T>
+    T read()
+    {
+        T value{};
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void readBytes(void* out, size_t size)
+    {
+        if (failed || size > data.size() - cursor)
+        {
+            failed = true;
+            return;
+        }
+        std::memcpy(out, data.data() + cursor, size);
+        cursor += size;
+    }
+
+    std::string readString()
+    {
+        uint32_t length = read<uint32_t>();
+        if (failed || length > data.size() - cursor)
+        {
+            failed = true;
+            return std::string();
+        }
+        std::string value(reinterpret_cast<const char*>(data.data() + cursor), length);
+        cursor += length;
+        return value;
+    }
+
+    size_t position() const { return cursor; }
+    size_t remaining() const { return data.size() - cursor; }
+    bool ok() const { return !failed; }
+
+private:
+    const std::vector<uint8_t>& data;
+    size_t cursor;
+    bool failed;
+};
+
+bool loadBlob(const std::string& path, std::vector<uint8_t>& outData)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    outData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool readHeader(BlobReader& reader, uint32_t magic)
+{
+    uint32_t fileMagic = reader.read<uint32_t>();
+    uint32_t version = reader.read<uint32_t>();
+    return reader.ok() && fileMagic == magic && version == COOK_FORMAT_VERSION;
+}
+
+void writeHeader(BlobWriter& writer, uint32_t magic)
+{
+    writer.write(magic);
+    writer.write(COOK_FORMAT_VERSION);
+}
+
+std::string replaceExtension(const std::string& path, const char* extension)
+{
+    size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return path + extension;
+    }
+    return path.substr(0, dot) + extension;
+}
+
+} // namespace
+
+bool readTexture(const std::string& path, CookedTexture& outTexture)
+{
+    std::vector<uint8_t> blob;
+    if (!loadBlob(path, blob))
+    {
+        return false;
+    }
+
+    BlobReader reader(blob);
+    if (!readHeader(reader, TEXTURE_MAGIC))
+    {
+        return false;
+    }
+
+    outTexture.width = reader.read<int32_t>();
+    outTexture.height = reader.read<int32_t>();
+    uint32_t levelCount = reader.read<uint32_t>();
+    if (!reader.ok() || levelCount == 0 || levelCount > 32)
+    {
+        return false;
+    }
+
+    outTexture.levels.resize(levelCount);
+    size_t pixelBytes = 0;
+    for (auto& level : outTexture.levels)
+    {
+        level.width = reader.read<int32_t>();
+        level.height = reader.read<int32_t>();
+        level.size = static_cast<size_t>(level.width) * static_cast<size_t>(level.height) * 4;
+        pixelBytes += level.size;
+    }
+
+    if (!reader.ok() || reader.remaining() != pixelBytes)
+    {
+        return false;
+    }
+
+    // Keep the file buffer as-is and point the levels into it (no copy)
+    size_t offset = reader.position();
+    for (auto& level : outTexture.levels)
+    {
+        level.offset = offset;
+        offset += level.size;
+    }
+    outTexture.pixels = std::move(blob);
+    return true;
+}
+
+bool writeTexture(const std::string& path, const CookedTexture& texture)
+{
+    BlobWriter writer;
+    writeHeader(writer, TEXTURE_MAGIC);
+    writer.write(static_cast<int32_t>(texture.width));
+    writer.write(static_cast<int32_t>(texture.height));
+    writer.write(static_cast<uint32_t>(texture.levels.size()));
+    for (const auto& level : texture.levels)
+    {
+        writer.write(static_cast<int32_t>(level.width));
+        writer.write(static_cast<int32_t>(level.height));
+    }
+    for (size_t i = 0; i < texture.levels.size(); ++i)
+    {
+        writer.writeBytes(texture.levelData(i), texture.levels[i].size);
+    }
+    return writer.saveTo(path);
+}
+
+bool readShaderBundle(const std::string& path, ShaderBundle& outBundle)
+{
+    std::vector<uint8_t> blob;
+    if (!loadBlob(path, blob))
+    {
+        return false;
+    }
+
+    BlobReader reader(blob);
+    if (!readHeader(reader, SHADER_BUNDLE_MAGIC))
+    {
+        return false;
+    }
+
+    uint32_t count = reader.read<uint32_t>();
+    outBundle.sources.clear();
+    for (uint32_t i = 0; i < count && reader.ok(); ++i)
+    {
+        std::string name = reader.readString();
+        std::string source = reader.readString();
+        outBundle.sources[name] = std::move(source);
+    }
+    return reader.ok();
+}
+
+bool writeShaderBundle(const std::string& path, const ShaderBundle& bundle)
+{
+    BlobWriter writer;
+    writeHeader(writer, SHADER_BUNDLE_MAGIC);
+    writer.write(static_cast<uint32_t>(bundle.sources.size()));
+    for (const auto& entry : bundle.sources)
+    {
+        writer.writeString(entry.first);
+        writer.writeString(entry.second);
+    }
+    return writer.saveTo(path);
+}
+
+bool readRoom(const std::string& path, CookedRoom& outRoom)
+{
+    std::vector<uint8_t> blob;
+    if (!loadBlob(path, blob))
+    {
+        return false;
+    }
+
+    BlobReader reader(blob);
+    if (!readHeader(reader, ROOM_MAGIC))
+    {
+        return false;
+    }
+
+    outRoom.name = reader.readString();
+    outRoom.width = reader.read<int32_t>();
+    outRoom.height = reader.read<int32_t>();
+    if (!reader.ok() || outRoom.width < 0 || outRoom.height < 0)
+    {
+        return false;
+    }
+
+    size_t cellCount = static_cast<size_t>(outRoom.width) * static_cast<size_t>(outRoom.height);
+    if (cellCount * (sizeof(uint8_t) + sizeof(uint16_t)) > reader.remaining())
+    {
+        return false;
+    }
+    outRoom.tileTypes.resize(cellCount);
+    outRoom.textureIndices.resize(cellCount);
+    reader.readBytes(outRoom.tileTypes.data(), cellCount * sizeof(uint8_t));
+    reader.readBytes(outRoom.textureIndices.data(), cellCount * sizeof(uint16_t));
+
+    outRoom.spawnX = reader.read<float>();
+    outRoom.spawnY = reader.read<float>();
+    outRoom.northRoom = reader.readString();
+    outRoom.southRoom = reader.readString();
+    outRoom.eastRoom = reader.readString();
+    outRoom.westRoom = reader.readString();
+    reader.readBytes(outRoom.background, sizeof(outRoom.background));
+    outRoom.musicTrack = reader.readString();
+
+    uint32_t enemyCount = reader.read<uint32_t>();
+    outRoom.enemies.clear();
+    for (uint32_t i = 0; i < enemyCount && reader.ok(); ++i)
+    {
+        CookedRoom::EnemySpawn enemy;
+        enemy.type = reader.readString();
+        enemy.x = reader.read<float>();
+        enemy.y = reader.read<float>();
+        outRoom.enemies.push_back(std::move(enemy));
+    }
+
+    uint32_t platformCount = reader.read<uint32_t>();
+    outRoom.platforms.clear();
+    for (uint32_t i = 0; i < platformCount && reader.ok(); ++i)
+    {
+        CookedRoom::PlatformSpawn platform;
+        platform.pattern = reader.readString();
+        platform.x = reader.read<float>();
+        platform.y = reader.read<float>();
+        platform.width = reader.read<float>();
+        platform.height = reader.read<float>();
+        outRoom.platforms.push_back(std::move(platform));
+    }
+
+    return reader.ok();
+}
+
+bool writeRoom(const std::string& path, const CookedRoom& room)
+{
+    size_t cellCount = static_cast<size_t>(room.width) * static_cast<size_t>(room.height);
+    if (room.tileTypes.size() != cellCount || room.textureIndices.size() != cellCount)
+    {
+        return false;
+    }
+
+    BlobWriter writer;
+    writeHeader(writer, ROOM_MAGIC);
+    writer.writeString(room.name);
+    writer.write(static_cast<int32_t>(room.width));
+    writer.write(static_cast<int32_t>(room.height));
+    writer.writeBytes(room.tileTypes.data(), cellCount * sizeof(uint8_t));
+    writer.writeBytes(room.textureIndices.data(), cellCount * sizeof(uint16_t));
+    writer.write(room.spawnX);
+    writer.write(room.spawnY);
+    writer.writeString(room.northRoom);
+    writer.writeString(room.southRoom);
+    writer.writeString(room.eastRoom);
+    writer.writeString(room.westRoom);
+    writer.writeBytes(room.background, sizeof(room.background));
+    writer.writeString(room.musicTrack);
+
+    writer.write(static_cast<uint32_t>(room.enemies.size()));
+    for (const auto& enemy : room.enemies)
+    {
+        writer.writeString(enemy.type);
+        writer.write(enemy.x);
+        writer.write(enemy.y);
+    }
+
+    writer.write(static_cast<uint32_t>(room.platforms.size()));
+    for (const auto& platform : room.platforms)
+    {
+        writer.writeString(platform.pattern);
+        writer.write(platform.x);
+        writer.write(platform.y);
+        writer.write(platform.width);
+        writer.write(platform.height);
+    }
+
+    return writer.saveTo(path);
+}
+
+bool readFont(const std::string& path, CookedFont& outFont)
+{
+    std::vector<uint8_t> blob;
+    if (!loadBlob(path, blob))
+    {
+        return false;
+    }
+
+    BlobReader reader(blob);
+    if (!readHeader(reader, FONT_MAGIC))
+    {
+        return false;
+    }
+
+    outFont.lineHeight = reader.read<int32_t>();
+    outFont.base = reader.read<int32_t>();
+    outFont.pageWidth = reader.read<int32_t>();
+    outFont.pageHeight = reader.read<int32_t>();
+    outFont.page = reader.readString();
+
+    uint32_t glyphCount = reader.read<uint32_t>();
+    outFont.glyphs.clear();
+    for (uint32_t i = 0; i < glyphCount && reader.ok(); ++i)
+    {
+        CookedFont::Glyph glyph;
+        glyph.codepoint = reader.read<uint32_t>();
+        glyph.x = reader.read<uint16_t>();
+        glyph.y = reader.read<uint16_t>();
+        glyph.width = reader.read<uint16_t>();
+        glyph.height = reader.read<uint16_t>();
+        glyph.offsetX = reader.read<int16_t>();
+        glyph.offsetY = reader.read<int16_t>();
+        glyph.advance = reader.read<int16_t>();
+        outFont.glyphs.push_back(glyph);
+    }
+
+    uint32_t kerningCount = reader.read<uint32_t>();
+    outFont.kernings.clear();
+    for (uint32_t i = 0; i < kerningCount && reader.ok(); ++i)
+    {
+        CookedFont::Kerning kerning;
+        kerning.first = reader.read<uint32_t>();
+        kerning.second = reader.read<uint32_t>();
+        kerning.amount = reader.read<int16_t>();
+        outFont.kernings.push_back(kerning);
+    }
+
+    return reader.ok();
+}
+
+bool writeFont(const std::string& path, const CookedFont& font)
+{
+    BlobWriter writer;
+    writeHeader(writer, FONT_MAGIC);
+    writer.write(static_cast<int32_t>(font.lineHeight));
+    writer.write(static_cast<int32_t>(font.base));
+    writer.write(static_cast<int32_t>(font.pageWidth));
+    writer.write(static_cast<int32_t>(font.pageHeight));
+    writer.writeString(font.page);
+
+    // Field by field: the structs have padding
+    writer.write(static_cast<uint32_t>(font.glyphs.size()));
+    for (const auto& glyph : font.glyphs)
+    {
+        writer.write(glyph.codepoint);
+        writer.write(glyph.x);
+        writer.write(glyph.y);
+        writer.write(glyph.width);
+        writer.write(glyph.height);
+        writer.write(glyph.offsetX);
+        writer.write(glyph.offsetY);
+        writer.write(glyph.advance);
+    }
+
+    writer.write(static_cast<uint32_t>(font.kernings.size()));
+    for (const auto& kerning : font.kernings)
+    {
+        writer.write(kerning.first);
+        writer.write(kerning.second);
+        writer.write(kerning.amount);
+    }
+
+    return writer.saveTo(path);
+}
+
+std::string cookedTexturePath(const std::string& sourcePath)
+{
+    return replaceExtension(sourcePath, TEXTURE_EXTENSION);
+}
+
+std::string cookedRoomPath(const std::string& sourcePath)
+{
+    return replaceExtension(sourcePath, ROOM_EXTENSION);
+}
+
+std::string cookedFontPath(const std::string& sourcePath)
+{
+    return replaceExtension(sourcePath, FONT_EXTENSION);
+}
+
+uint64_t hashContent(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace Assets
+} // namespace Penumbra
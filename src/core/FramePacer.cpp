@@ -0,0 +1,129 @@
+#include "core/FramePacer.h"
+#include "core/Platform.h"
+#include <SDL2/SDL.h>
+#include <iostream>
+
+namespace Penumbra {
+namespace Platform {
+
+FramePacer::FramePacer()
+    : mode(PresentMode::VSync)
+    , targetRate(60.0)
+    , lateInputSampling(false)
+    , frameStart(-1.0)
+    , nextDeadline(0.0)
+{
+}
+
+void FramePacer::setMode(PresentMode newMode, double rate)
+{
+    mode = newMode;
+    targetRate = rate > 0.0 ? rate : 60.0;
+    nextDeadline = 0.0;
+    frameTimes.clear();
+}
+
+PresentMode FramePacer::applySwapInterval()
+{
+    switch (mode)
+    {
+        case PresentMode::AdaptiveVSync:
+            if (SDL_GL_SetSwapInterval(-1) == 0)
+            {
+                break;
+            }
+            std::cerr << "FramePacer: adaptive vsync unsupported, using vsync" << std::endl;
+            mode = PresentMode::VSync;
+            SDL_GL_SetSwapInterval(1);
+            break;
+
+        case PresentMode::VSync:
+            SDL_GL_SetSwapInterval(1);
+            break;
+
+        case PresentMode::Uncapped:
+        case PresentMode::Limited:
+            SDL_GL_SetSwapInterval(0);
+            break;
+    }
+    return mode;
+}
+
+double FramePacer::beginFrame()
+{
+    if (mode == PresentMode::Limited)
+    {
+        double period = 1.0 / targetRate;
+        double now = Time::getTime();
+
+        // More than a frame behind: start over rather than rush to catch up
+        if (nextDeadline == 0.0 || now - nextDeadline > period)
+        {
+            nextDeadline = now;
+        }
+        waitUntil(nextDeadline);
+        nextDeadline += period;
+    }
+
+    double now = Time::getTime();
+    double deltaTime = frameStart < 0.0 ? 0.0 : now - frameStart;
+    if (frameStart >= 0.0)
+    {
+        frameTimes.add(deltaTime);
+    }
+    frameStart = now;
+    return deltaTime;
+}
+
+double FramePacer::markInputSampled()
+{
+    return Time::getTime();
+}
+
+void FramePacer::recordPresent(double inputTime)
+{
+    double latency = Time::getTime() - inputTime;
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    latencies.add(latency);
+}
+
+FramePacingReport FramePacer::getReport() const
+{
+    FramePacingReport report;
+    report.frameTimeMean = frameTimes.getMean();
+    report.frameTimeStdDev = frameTimes.getStdDev();
+    report.frameTimeMax = frameTimes.getMax();
+
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    report.latencyMean = latencies.getMean();
+    report.latencyMax = latencies.getMax();
+    return report;
+}
+
+void FramePacer::waitUntil(double deadline)
+{
+    double remaining = deadline - Time::getTime();
+    if (remaining > SPIN_MARGIN)
+    {
+        Time::sleep(static_cast<unsigned int>((remaining - SPIN_MARGIN) * 1000.0));
+    }
+
+    while (Time::getTime() < deadline)
+    {
+    }
+}
+
+const char* getPresentModeName(PresentMode mode)
+{
+    switch (mode)
+    {
+        case PresentMode::Uncapped:      return "uncapped";
+        case PresentMode::VSync:         return "vsync";
+        case PresentMode::AdaptiveVSync: return "adaptive";
+        case PresentMode::Limited:       return "limited";
+    }
+    return "unknown";
+}
+
+} // namespace Platform
+} // namespace Penumbra
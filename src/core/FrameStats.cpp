@@ -0,0 +1,79 @@
+#include "core/FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Penumbra {
+namespace Platform {
+
+FrameStats::FrameStats(size_t windowSize)
+    : samples(std::max<size_t>(windowSize, 1), 0.0)
+    , next(0)
+    , count(0)
+{
+}
+
+void FrameStats::add(double sample)
+{
+    samples[next] = sample;
+    next = (next + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+}
+
+void FrameStats::clear()
+{
+    next = 0;
+    count = 0;
+}
+
+double FrameStats::getMean() const
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += samples[i];
+    }
+    return sum / static_cast<double>(count);
+}
+
+double FrameStats::getStdDev() const
+{
+    if (count < 2)
+    {
+        return 0.0;
+    }
+
+    double mean = getMean();
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double d = samples[i] - mean;
+        sum += d * d;
+    }
+    return std::sqrt(sum / static_cast<double>(count));
+}
+
+double FrameStats::getMin() const
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return *std::min_element(samples.begin(), samples.begin() + count);
+}
+
+double FrameStats::getMax() const
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return *std::max_element(samples.begin(), samples.begin() + count);
+}
+
+} // namespace Platform
+} // namespace Penumbra
@@ -0,0 +1,110 @@
+#include "core/JobSystem.h"
+
+namespace Penumbra {
+namespace Jobs {
+
+JobSystem::JobSystem(size_t workerCount)
+    : job(nullptr)
+    , pieceCount(0)
+    , nextPiece(0)
+    , busyWorkers(0)
+    , generation(0)
+    , stopping(false)
+{
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        // Thread 0 is the dispatching thread
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+size_t JobSystem::defaultWorkerCount()
+{
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void JobSystem::dispatch(size_t count, const std::function<void(size_t piece, size_t thread)>& work)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (workers.empty() || count == 1)
+    {
+        for (size_t piece = 0; piece < count; ++piece)
+        {
+            work(piece, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &work;
+        pieceCount = count;
+        nextPiece.store(0, std::memory_order_relaxed);
+        busyWorkers = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    runPieces(0);
+
+    // Workers still finishing their last piece hold a pointer to work
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void JobSystem::workerLoop(size_t thread)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+        }
+
+        runPieces(thread);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0)
+        {
+            done.notify_one();
+        }
+    }
+}
+
+void JobSystem::runPieces(size_t thread)
+{
+    // Pieces are claimed one at a time, so uneven pieces still balance
+    for (size_t piece = nextPiece.fetch_add(1, std::memory_order_relaxed); piece < pieceCount;
+         piece = nextPiece.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*job)(piece, thread);
+    }
+}
+
+} // namespace Jobs
+} // namespace Penumbra
@@ -0,0 +1,15 @@
+#include "core/Math.h"
+
+namespace Penumbra {
+namespace Math {
+
+const Color Color::White(1.0f, 1.0f, 1.0f, 1.0f);
+const Color Color::Black(0.0f, 0.0f, 0.0f, 1.0f);
+const Color Color::Red(1.0f, 0.0f, 0.0f, 1.0f);
+const Color Color::Green(0.0f, 1.0f, 0.0f, 1.0f);
+const Color Color::Blue(0.0f, 0.0f, 1.0f, 1.0f);
+const Color Color::Yellow(1.0f, 1.0f, 0.0f, 1.0f);
+const Color Color::Transparent(0.0f, 0.0f, 0.0f, 0.0f);
+
+} // namespace Math
+} // namespace Penumbra
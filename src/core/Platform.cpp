@@ -0,0 +1,143 @@
+#include "core/Platform.h"
+#include <SDL2/SDL.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+namespace Penumbra {
+namespace Platform {
+
+namespace {
+
+/**
+ * Match filename against a pattern with '*' and '?' wildcards
+ */
+bool matchPattern(const char* pattern, const char* name)
+{
+    if (*pattern == '\0')
+    {
+        return *name == '\0';
+    }
+    if (*pattern == '*')
+    {
+        return matchPattern(pattern + 1, name) || (*name != '\0' && matchPattern(pattern, name + 1));
+    }
+    if (*name != '\0' && (*pattern == '?' || *pattern == *name))
+    {
+        return matchPattern(pattern + 1, name + 1);
+    }
+    return false;
+}
+
+/**
+ * Take ownership of an SDL-allocated path string
+ */
+std::string takeSDLPath(char* path)
+{
+    if (path == nullptr)
+    {
+        return std::string();
+    }
+    std::string result(path);
+    SDL_free(path);
+    return result;
+}
+
+} // namespace
+
+std::string FileSystem::getBasePath()
+{
+    return takeSDLPath(SDL_GetBasePath());
+}
+
+std::string FileSystem::getUserDataPath()
+{
+    return takeSDLPath(SDL_GetPrefPath("ceruleanoak", "penumbra"));
+}
+
+bool FileSystem::fileExists(const std::string& path)
+{
+    std::error_code error;
+    return fs::is_regular_file(path, error);
+}
+
+bool FileSystem::readFile(const std::string& path, std::string& outContent)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    outContent.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool FileSystem::writeFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return static_cast<bool>(file);
+}
+
+std::vector<std::string> FileSystem::listFiles(const std::string& directory,
+                                               const std::string& pattern)
+{
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error))
+    {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && matchPattern(pattern.c_str(), name.c_str()))
+        {
+            files.push_back(entry.path().string());
+        }
+    }
+    return files;
+}
+
+bool FileSystem::createDirectory(const std::string& path)
+{
+    std::error_code error;
+    fs::create_directories(path, error);
+    return fs::is_directory(path, error);
+}
+
+std::string FileSystem::joinPath(const std::string& base, const std::string& component)
+{
+    if (base.empty())
+    {
+        return component;
+    }
+    return (fs::path(base) / component).string();
+}
+
+std::string FileSystem::getExtension(const std::string& path)
+{
+    return fs::path(path).extension().string();
+}
+
+std::string FileSystem::getFilename(const std::string& path)
+{
+    return fs::path(path).filename().string();
+}
+
+double Time::getTime()
+{
+    static const Uint64 start = SDL_GetPerformanceCounter();
+    static const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+}
+
+void Time::sleep(unsigned int milliseconds)
+{
+    SDL_Delay(milliseconds);
+}
+
+} // namespace Platform
+} // namespace Penumbra
@@ -0,0 +1,571 @@
+#include "core/Resources.h"
+#include "core/OpenGL.h"
+#include "core/Platform.h"
+#include "rendering/GLState.h"
+#include "rendering/Shaders.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace Penumbra {
+namespace Resources {
+
+namespace {
+
+/**
+ * Drop every name that maps to handle (unload is rare, so a scan is fine)
+ */
+template<typename T>
+void eraseName(std::unordered_map<std::string, Handle<T>>& names, Handle<T> handle)
+{
+    for (auto it = names.begin(); it != names.end();)
+    {
+        if (it->second == handle)
+        {
+            it = names.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Find handle for name, or a null handle
+ */
+template<typename T>
+Handle<T> findName(const std::unordered_map<std::string, Handle<T>>& names,
+                   const std::string& name)
+{
+    auto it = names.find(name);
+    return it != names.end() ? it->second : Handle<T>();
+}
+
+// Default texture budget; well under the 512MB whole-game memory target
+constexpr size_t DEFAULT_TEXTURE_BUDGET = 256 * 1024 * 1024;
+
+} // namespace
+
+ResourceManager::ResourceManager()
+    : state(nullptr)
+    , textureMemory(0)
+    , textureBudget(DEFAULT_TEXTURE_BUDGET)
+    , texturesEvicted(0)
+    , frameIndex(1)
+{
+}
+
+ResourceManager& ResourceManager::getInstance()
+{
+    static ResourceManager instance;
+    return instance;
+}
+
+void ResourceManager::initialize(const std::string& assetBasePath)
+{
+    basePath = assetBasePath;
+
+    std::string bundlePath = Platform::FileSystem::joinPath(basePath, Assets::SHADER_BUNDLE_FILE);
+    if (!Assets::readShaderBundle(bundlePath, shaderBundle))
+    {
+        std::cerr << "No cooked shader bundle at " << bundlePath
+                  << "; shaders will be read from source files" << std::endl;
+    }
+}
+
+TextureHandle ResourceManager::loadTexture(const std::string& name, const std::string& path)
+{
+    TextureHandle existing = findName(textureNames, name);
+    if (textures.isValid(existing))
+    {
+        return existing;
+    }
+
+    auto texture = std::make_unique<Texture>();
+    if (!texture->loadFromFile(Platform::FileSystem::joinPath(basePath, Assets::cookedTexturePath(path)), state))
+    {
+        std::cerr << "Failed to load texture '" << name << "' from " << path << std::endl;
+        return TextureHandle();
+    }
+
+    textureMemory += texture->getMemorySize();
+    TextureHandle handle = textures.insert(std::move(texture));
+    textureNames[name] = handle;
+
+    // Stamp as used so the new texture survives the budget check it triggers
+    textures.get(handle, frameIndex);
+    enforceBudget();
+    return handle;
+}
+
+TextureHandle ResourceManager::getTexture(const std::string& name) const
+{
+    return findName(textureNames, name);
+}
+
+void ResourceManager::unloadTexture(TextureHandle handle)
+{
+    if (!textures.isValid(handle))
+    {
+        return;
+    }
+
+    textureMemory -= textures.get(handle)->getMemorySize();
+    eraseName(textureNames, handle);
+    retireTexture(textures.take(handle));
+}
+
+void ResourceManager::retireTexture(std::unique_ptr<Texture> texture)
+{
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    retiredTextures.push_back(std::move(texture));
+}
+
+void ResourceManager::releaseRetiredTextures()
+{
+    // Deleted when released goes out of scope, outside the lock
+    std::vector<std::unique_ptr<Texture>> released;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        released.swap(retiredTextures);
+    }
+}
+
+ShaderHandle ResourceManager::loadShader(const std::string& name,
+                                         const std::string& vertexPath,
+                                         const std::string& fragmentPath)
+{
+    ShaderHandle existing = findName(shaderNames, name);
+    if (shaders.isValid(existing))
+    {
+        return existing;
+    }
+
+    auto shader = std::make_unique<Shader>();
+    const std::string* vertexSource = shaderBundle.find(vertexPath);
+    const std::string* fragmentSource = shaderBundle.find(fragmentPath);
+    bool loaded = vertexSource && fragmentSource
+        ? shader->loadFromSource(*vertexSource, *fragmentSource)
+        : shader->loadFromFiles(Platform::FileSystem::joinPath(basePath, vertexPath),
+                                Platform::FileSystem::joinPath(basePath, fragmentPath));
+    if (!loaded)
+    {
+        std::cerr << "Failed to load shader '" << name << "'" << std::endl;
+        return ShaderHandle();
+    }
+
+    ShaderHandle handle = shaders.insert(std::move(shader));
+    shaderNames[name] = handle;
+    return handle;
+}
+
+ShaderHandle ResourceManager::getShader(const std::string& name) const
+{
+    return findName(shaderNames, name);
+}
+
+void ResourceManager::unloadShader(ShaderHandle handle)
+{
+    eraseName(shaderNames, handle);
+    shaders.remove(handle);
+}
+
+SoundHandle ResourceManager::loadSound(const std::string& name, const std::string& path)
+{
+    SoundHandle existing = findName(soundNames, name);
+    if (sounds.isValid(existing))
+    {
+        return existing;
+    }
+
+    auto sound = std::make_unique<Sound>();
+    if (!sound->loadFromFile(Platform::FileSystem::joinPath(basePath, path)))
+    {
+        std::cerr << "Failed to load sound '" << name << "' from " << path << std::endl;
+        return SoundHandle();
+    }
+
+    SoundHandle handle = sounds.insert(std::move(sound));
+    soundNames[name] = handle;
+    return handle;
+}
+
+SoundHandle ResourceManager::getSound(const std::string& name) const
+{
+    return findName(soundNames, name);
+}
+
+void ResourceManager::unloadSound(SoundHandle handle)
+{
+    eraseName(soundNames, handle);
+    sounds.remove(handle);
+}
+
+void ResourceManager::setTextureBudget(size_t bytes)
+{
+    textureBudget = bytes;
+    enforceBudget();
+}
+
+void ResourceManager::beginFrame()
+{
+    ++frameIndex;
+    enforceBudget();
+}
+
+size_t ResourceManager::enforceBudget()
+{
+    if (textureBudget == 0 || textureMemory <= textureBudget)
+    {
+        return 0;
+    }
+
+    // Candidates: unreferenced and not touched this frame or the last (the
+    // render thread may still be drawing last frame's packet)
+    std::vector<std::pair<uint64_t, TextureHandle>> candidates;
+    textures.forEach([&](TextureHandle handle, const Texture&) {
+        if (textures.refCount(handle) == 0 && textures.lastUsed(handle) + 1 < frameIndex)
+        {
+            candidates.emplace_back(textures.lastUsed(handle), handle);
+        }
+    });
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    size_t evicted = 0;
+    for (const auto& candidate : candidates)
+    {
+        if (textureMemory <= textureBudget)
+        {
+            break;
+        }
+        unloadTexture(candidate.second);
+        ++evicted;
+    }
+
+    texturesEvicted += evicted;
+    return evicted;
+}
+
+ResourceManager::Stats ResourceManager::getStats() const
+{
+    Stats stats{};
+    stats.textureCount = textures.size();
+    stats.shaderCount = shaders.size();
+    stats.soundCount = sounds.size();
+    stats.textureMemory = textureMemory;
+    stats.textureBudget = textureBudget;
+    stats.texturesEvicted = texturesEvicted;
+
+    textures.forEach([&](TextureHandle handle, const Texture&) {
+        if (textures.refCount(handle) > 0)
+        {
+            ++stats.texturesReferenced;
+        }
+    });
+    return stats;
+}
+
+void ResourceManager::clearAll()
+{
+    clearTextures();
+    clearShaders();
+    clearSounds();
+}
+
+void ResourceManager::clearTextures()
+{
+    std::vector<TextureHandle> handles;
+    textures.forEach([&](TextureHandle handle, const Texture&) { handles.push_back(handle); });
+    for (TextureHandle handle : handles)
+    {
+        retireTexture(textures.take(handle));
+    }
+    textures.clear();
+    textureNames.clear();
+    textureMemory = 0;
+}
+
+void ResourceManager::clearShaders()
+{
+    shaders.clear();
+    shaderNames.clear();
+}
+
+void ResourceManager::clearSounds()
+{
+    sounds.clear();
+    soundNames.clear();
+}
+
+Texture::~Texture()
+{
+    if (textureID != 0)
+    {
+        glDeleteTextures(1, &textureID);
+        if (state != nullptr)
+        {
+            state->forgetTexture(textureID);
+        }
+    }
+}
+
+void Texture::beginUpload(Rendering::GLStateCache* stateCache)
+{
+    state = stateCache;
+    if (textureID == 0)
+    {
+        glGenTextures(1, &textureID);
+    }
+    if (state != nullptr)
+    {
+        state->bindTexture(0, textureID);
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+    }
+}
+
+void Texture::endUpload()
+{
+    // A cache keeps tracking the binding; without one, leave nothing bound
+    if (state == nullptr)
+    {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+}
+
+bool Texture::loadFromFile(const std::string& path, Rendering::GLStateCache* stateCache)
+{
+    Assets::CookedTexture cooked;
+    if (!Assets::readTexture(path, cooked))
+    {
+        std::cerr << "Missing or out-of-date cooked texture: " << path << std::endl;
+        return false;
+    }
+
+    beginUpload(stateCache);
+
+    // Cooked levels are tightly packed RGBA8, uploaded straight from the file buffer
+    for (size_t level = 0; level < cooked.levels.size(); ++level)
+    {
+        const auto& info = cooked.levels[level];
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA8,
+                     info.width, info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     cooked.levelData(level));
+    }
+
+    // Pixel art: nearest sampling, nearest mip when minified
+    bool hasMips = cooked.levels.size() > 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(cooked.levels.size() - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, hasMips ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    endUpload();
+
+    width = cooked.width;
+    height = cooked.height;
+    channels = 4;
+    return true;
+}
+
+bool Texture::loadFromPixels(const uint8_t* pixels, int pixelWidth, int pixelHeight,
+                             Rendering::GLStateCache* stateCache)
+{
+    if (pixels == nullptr || pixelWidth <= 0 || pixelHeight <= 0)
+    {
+        return false;
+    }
+
+    beginUpload(stateCache);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pixelWidth, pixelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    endUpload();
+
+    width = pixelWidth;
+    height = pixelHeight;
+    channels = 4;
+    return true;
+}
+
+void Texture::bind() const
+{
+    if (state != nullptr)
+    {
+        state->bindTexture(0, textureID);
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, textureID);
+}
+
+void Texture::unbind() const
+{
+    if (state != nullptr)
+    {
+        state->bindTexture(0, 0);
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool Shader::loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath)
+{
+    std::string vertexSource;
+    std::string fragmentSource;
+    if (!Platform::FileSystem::readFile(vertexPath, vertexSource) ||
+        !Platform::FileSystem::readFile(fragmentPath, fragmentSource))
+    {
+        std::cerr << "Failed to read shader sources: " << vertexPath << ", " << fragmentPath << std::endl;
+        return false;
+    }
+    return loadFromSource(vertexSource, fragmentSource);
+}
+
+bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource)
+{
+    unsigned int program = 0;
+    if (!Rendering::Shaders::createShaderProgram(vertexSource, fragmentSource, program))
+    {
+        return false;
+    }
+
+    if (programID != 0)
+    {
+        glDeleteProgram(programID);
+    }
+    programID = program;
+    reflectUniforms();
+    return true;
+}
+
+Shader::~Shader()
+{
+    if (programID != 0)
+    {
+        glDeleteProgram(programID);
+    }
+}
+
+void Shader::use(Rendering::GLStateCache& stateCache) const
+{
+    stateCache.useProgram(programID);
+}
+
+void Shader::reflectUniforms()
+{
+    uniforms.clear();
+
+    GLint count = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> name(static_cast<size_t>(maxNameLength > 0 ? maxNameLength : 1));
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programID, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                           nullptr, &size, &type, name.data());
+
+        // Block members have no location; they're fed by uniform buffers
+        GLint location = glGetUniformLocation(programID, name.data());
+        if (location < 0)
+        {
+            continue;
+        }
+
+        // Arrays report "name[0]"; register them under the bare name
+        if (char* bracket = std::strchr(name.data(), '['))
+        {
+            *bracket = '\0';
+        }
+        uniforms.push_back({UniformID::hashName(name.data()), location});
+    }
+
+    std::sort(uniforms.begin(), uniforms.end(),
+              [](const UniformSlot& a, const UniformSlot& b) { return a.hash < b.hash; });
+
+    for (size_t i = 1; i < uniforms.size(); ++i)
+    {
+        if (uniforms[i].hash == uniforms[i - 1].hash)
+        {
+            std::cerr << "Uniform name hash collision in program " << programID << std::endl;
+        }
+    }
+}
+
+int Shader::getUniformLocation(UniformID id) const
+{
+    auto it = std::lower_bound(uniforms.begin(), uniforms.end(), id.hash,
+                               [](const UniformSlot& slot, uint32_t hash) { return slot.hash < hash; });
+    return it != uniforms.end() && it->hash == id.hash ? it->location : -1;
+}
+
+void Shader::setInt(UniformID id, int value) const
+{
+    glUniform1i(getUniformLocation(id), value);
+}
+
+void Shader::setIntArray(UniformID id, const int* values, int count) const
+{
+    glUniform1iv(getUniformLocation(id), count, values);
+}
+
+void Shader::setFloat(UniformID id, float value) const
+{
+    glUniform1f(getUniformLocation(id), value);
+}
+
+void Shader::setVec2(UniformID id, float x, float y) const
+{
+    glUniform2f(getUniformLocation(id), x, y);
+}
+
+void Shader::setVec3(UniformID id, float x, float y, float z) const
+{
+    glUniform3f(getUniformLocation(id), x, y, z);
+}
+
+void Shader::setVec4(UniformID id, float x, float y, float z, float w) const
+{
+    glUniform4f(getUniformLocation(id), x, y, z, w);
+}
+
+void Shader::setMat4(UniformID id, const float* value) const
+{
+    glUniformMatrix4fv(getUniformLocation(id), 1, GL_FALSE, value);
+}
+
+// No audio backend yet: sounds only check that their file can be read, so
+// loading can be wired up (and fail on missing assets) ahead of playback
+bool Sound::loadFromFile(const std::string& path)
+{
+    std::string data;
+    if (!Platform::FileSystem::readFile(path, data) || data.empty())
+    {
+        return false;
+    }
+    return true;
+}
+
+void Sound::play()
+{
+}
+
+void Sound::stop()
+{
+}
+
+} // namespace Resources
+} // namespace Penumbra
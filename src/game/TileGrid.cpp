@@ -0,0 +1,228 @@
+#include "game/TileGrid.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Penumbra {
+namespace Game {
+
+namespace {
+
+// Returned for out-of-range queries so callers never see a dangling reference
+const Tile EMPTY_TILE;
+
+} // namespace
+
+TileGrid::TileGrid()
+    : width(0)
+    , height(0)
+    , levels(0)
+    , chunkColumns(0)
+    , chunkRows(0)
+    , revision(0)
+{
+}
+
+TileGrid::TileGrid(int width, int height, int levels)
+    : TileGrid()
+{
+    initialize(width, height, levels);
+}
+
+void TileGrid::initialize(int newWidth, int newHeight, int newLevels)
+{
+    width = std::max(newWidth, 0);
+    height = std::max(newHeight, 0);
+    levels = std::max(newLevels, 1);
+    tiles.assign(static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(levels), Tile());
+
+    chunkColumns = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkRows = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkRevisions.resize(static_cast<size_t>(chunkColumns) * static_cast<size_t>(chunkRows));
+    touchAllChunks();
+}
+
+void TileGrid::touchAllChunks()
+{
+    std::fill(chunkRevisions.begin(), chunkRevisions.end(), ++revision);
+}
+
+void TileGrid::touchChunk(int x, int y)
+{
+    chunkRevisions[static_cast<size_t>(y / CHUNK_SIZE) * static_cast<size_t>(chunkColumns) +
+                   static_cast<size_t>(x / CHUNK_SIZE)] = revision;
+}
+
+void TileGrid::setTile(int x, int y, const Tile& tile)
+{
+    setTile(x, y, 0, tile);
+}
+
+void TileGrid::setTile(int x, int y, int z, const Tile& tile)
+{
+    if (!isValidPosition(x, y, z))
+    {
+        return;
+    }
+    tiles[toIndex(x, y, z)] = tile;
+
+    // Neighbors across a chunk edge may have gained or lost an exposed face
+    ++revision;
+    touchChunk(x, y);
+    if (x % CHUNK_SIZE == 0 && x > 0) touchChunk(x - 1, y);
+    if (x % CHUNK_SIZE == CHUNK_SIZE - 1 && x + 1 < width) touchChunk(x + 1, y);
+    if (y % CHUNK_SIZE == 0 && y > 0) touchChunk(x, y - 1);
+    if (y % CHUNK_SIZE == CHUNK_SIZE - 1 && y + 1 < height) touchChunk(x, y + 1);
+}
+
+const Tile& TileGrid::getTile(int x, int y) const
+{
+    return getTile(x, y, 0);
+}
+
+const Tile& TileGrid::getTile(int x, int y, int z) const
+{
+    return isValidPosition(x, y, z) ? tiles[toIndex(x, y, z)] : EMPTY_TILE;
+}
+
+bool TileGrid::isValidPosition(int x, int y) const
+{
+    return x >= 0 && y >= 0 && x < width && y < height;
+}
+
+bool TileGrid::isValidPosition(int x, int y, int z) const
+{
+    return isValidPosition(x, y) && z >= 0 && z < levels;
+}
+
+bool TileGrid::isFaceExposed(int x, int y, int z, TileFace face) const
+{
+    if (getTile(x, y, z).type == TileType::Empty)
+    {
+        return false;
+    }
+
+    switch (face)
+    {
+        case TileFace::Top:   return !getTile(x, y, z + 1).isSolid();
+        case TileFace::North: return !getTile(x, y - 1, z).isSolid();
+        case TileFace::East:  return !getTile(x + 1, y, z).isSolid();
+        case TileFace::South: return !getTile(x, y + 1, z).isSolid();
+        case TileFace::West:  return !getTile(x - 1, y, z).isSolid();
+    }
+    return false;
+}
+
+void TileGrid::worldToGrid(float worldX, float worldY, int& outGridX, int& outGridY) const
+{
+    outGridX = static_cast<int>(std::floor(worldX / TILE_SIZE));
+    outGridY = static_cast<int>(std::floor(worldY / TILE_SIZE));
+}
+
+void TileGrid::gridToWorld(int gridX, int gridY, float& outWorldX, float& outWorldY) const
+{
+    outWorldX = static_cast<float>(gridX * TILE_SIZE);
+    outWorldY = static_cast<float>(gridY * TILE_SIZE);
+}
+
+void TileGrid::getCellRange(const Math::AABB& bounds, int& outMinX, int& outMinY,
+                            int& outMaxX, int& outMaxY) const
+{
+    // Max edge is exclusive: a box ending exactly on a tile boundary doesn't touch the next tile
+    outMinX = std::max(static_cast<int>(std::floor(bounds.min.x / TILE_SIZE)), 0);
+    outMinY = std::max(static_cast<int>(std::floor(bounds.min.y / TILE_SIZE)), 0);
+    outMaxX = std::min(static_cast<int>(std::ceil(bounds.max.x / TILE_SIZE)), width);
+    outMaxY = std::min(static_cast<int>(std::ceil(bounds.max.y / TILE_SIZE)), height);
+}
+
+bool TileGrid::checkCollision(const Math::AABB& bounds) const
+{
+    return !getCollidingTiles(bounds).empty();
+}
+
+std::vector<Math::AABB> TileGrid::getCollidingTiles(const Math::AABB& bounds) const
+{
+    std::vector<Math::AABB> result;
+
+    int minX, minY, maxX, maxY;
+    getCellRange(bounds, minX, minY, maxX, maxY);
+
+    for (int y = minY; y < maxY; ++y)
+    {
+        const Tile* row = getRow(y);
+        for (int x = minX; x < maxX; ++x)
+        {
+            if (row[x].isCollidable())
+            {
+                result.emplace_back(static_cast<float>(x * TILE_SIZE), static_cast<float>(y * TILE_SIZE),
+                                    static_cast<float>(TILE_SIZE), static_cast<float>(TILE_SIZE));
+            }
+        }
+    }
+    return result;
+}
+
+bool TileGrid::loadFromJson(const std::string& jsonData)
+{
+    // Schema: {"width": W, "height": H, "levels": L, "tiles": [type, ...], "textures": [index, ...]}
+    // Row-major, level by level from the ground up, matching the cooked room layout;
+    // "levels" is optional and defaults to 1
+    nlohmann::json root = nlohmann::json::parse(jsonData, nullptr, false);
+    if (root.is_discarded() || !root.is_object())
+    {
+        std::cerr << "TileGrid: invalid JSON" << std::endl;
+        return false;
+    }
+
+    int newWidth = root.value("width", 0);
+    int newHeight = root.value("height", 0);
+    int newLevels = root.value("levels", 1);
+    const nlohmann::json& types = root["tiles"];
+    size_t count = static_cast<size_t>(std::max(newWidth, 0)) * static_cast<size_t>(std::max(newHeight, 0)) *
+                   static_cast<size_t>(std::max(newLevels, 1));
+    if (!types.is_array() || types.size() != count)
+    {
+        std::cerr << "TileGrid: tile array doesn't match " << newWidth << "x" << newHeight << "x" << newLevels
+                  << std::endl;
+        return false;
+    }
+
+    const nlohmann::json textures = root.value("textures", nlohmann::json::array());
+    initialize(newWidth, newHeight, newLevels);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int textureIndex = i < textures.size() ? textures[i].get<int>() : 0;
+        tiles[i] = Tile(static_cast<TileType>(types[i].get<int>()), textureIndex);
+    }
+    touchAllChunks();
+    return true;
+}
+
+std::string TileGrid::saveToJson() const
+{
+    nlohmann::json types = nlohmann::json::array();
+    nlohmann::json textures = nlohmann::json::array();
+    for (const Tile& tile : tiles)
+    {
+        types.push_back(static_cast<int>(tile.type));
+        textures.push_back(tile.textureIndex);
+    }
+
+    nlohmann::json root;
+    root["width"] = width;
+    root["height"] = height;
+    root["levels"] = levels;
+    root["tiles"] = types;
+    root["textures"] = textures;
+    return root.dump();
+}
+
+void TileGrid::clear()
+{
+    std::fill(tiles.begin(), tiles.end(), Tile());
+    touchAllChunks();
+}
+
+} // namespace Game
+} // namespace Penumbra
@@ -1,19 +1,34 @@
 #include <SDL2/SDL.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
 
-// OpenGL headers - macOS specific
-#ifdef __APPLE__
-#include <OpenGL/gl3.h>
-#else
-#include <GL/gl.h>
-#endif
+#include "core/FramePacer.h"
+#include "core/OpenGL.h"
+#include "core/Platform.h"
+#include "core/Resources.h"
+#include "rendering/Camera.h"
+#include "rendering/ProgramCache.h"
+#include "rendering/RenderThread.h"
+#include "rendering/Renderer.h"
+#include "rendering/Text.h"
 
 // Global constants
 constexpr int SCREEN_WIDTH = 1024;
 constexpr int SCREEN_HEIGHT = 768;
+
+// World resolution: 16px tiles drawn 1:1, integer-upscaled 4x to the window
+constexpr int WORLD_WIDTH = 256;
+constexpr int WORLD_HEIGHT = 192;
 constexpr const char* WINDOW_TITLE = "PENUMBRA";
 
+// Debug overlay, toggled with F1 (debug builds only)
+bool debugOverlay = false;
+constexpr int OVERLAY_LAYER = 120;  // Sort keys clamp layers to -128..127
+
 /**
  * Initialize SDL2 and create window with OpenGL context
  *
@@ -71,14 +86,16 @@ bool initSDL(SDL_Window** window, SDL_GLContext* context)
         return false;
     }
 
-    // Enable VSync
-    SDL_GL_SetSwapInterval(1);
-
     // Print OpenGL version info
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
     std::cout << "GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
     std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
 
+    // Program binary cache lets warm starts skip shader compilation
+    using Penumbra::Platform::FileSystem;
+    Penumbra::Rendering::ProgramCache::getInstance().initialize(
+        FileSystem::joinPath(FileSystem::getUserDataPath(), "shader_cache"));
+
     return true;
 }
 
@@ -101,6 +118,10 @@ bool handleEvents(const SDL_Event& event)
             {
                 return false;
             }
+            if (event.key.keysym.sym == SDLK_F1 && PENUMBRA_DEBUG_DRAW)
+            {
+                debugOverlay = !debugOverlay;
+            }
             // TODO: Phase-specific input handling will be added here
             // - Player movement (arrow keys, WASD)
             // - Action keys (Space, Shift)
@@ -118,6 +139,25 @@ bool handleEvents(const SDL_Event& event)
     return true;
 }
 
+/**
+ * Drain the SDL event queue
+ *
+ * @return false if quit requested, true otherwise
+ */
+bool pollEvents()
+{
+    bool running = true;
+    SDL_Event event;
+    while (SDL_PollEvent(&event))
+    {
+        if (!handleEvents(event))
+        {
+            running = false;
+        }
+    }
+    return running;
+}
+
 /**
  * Update game state
  *
@@ -133,13 +173,23 @@ void update(float deltaTime)
 }
 
 /**
- * Render frame
+ * Record frame
+ * Runs on the simulation thread; nothing here may call GL, the render
+ * thread draws the packet afterwards
+ *
+ * @param frame Packet for this frame
+ * @param debug Debug primitives, drawn over the frame while the overlay is on
  */
-void render()
+void render(Penumbra::Rendering::FramePacket& frame, Penumbra::Rendering::DebugDrawQueue& debug)
 {
-    // Clear screen to dark gray (temporary - will be replaced with actual rendering)
-    glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // Dark gray background (temporary - will be replaced with actual rendering)
+    frame.clearColor = Penumbra::Math::Color(0.2f, 0.2f, 0.2f, 1.0f);
+
+    frame.debug = debugOverlay;
+    if (debugOverlay)
+    {
+        debug.text(Penumbra::Math::Vec2(8.0f, 8.0f), "DEBUG", Penumbra::Math::Color::Yellow);
+    }
 
     // TODO: Phase 1 - Sprite batch rendering
     // - Render TileGrid
@@ -154,13 +204,92 @@ void render()
     // TODO: Phase 4 - Add room transition effects
 }
 
+/**
+ * Record the debug overlay's frame statistics
+ * The text is refreshed twice a second and its cached layout reused in
+ * between; the whole overlay shares one draw call with the font page
+ *
+ * @param frame Packet for this frame
+ * @param font Font to draw with
+ * @param pacer Source of the statistics
+ */
+void drawOverlay(Penumbra::Rendering::FramePacket& frame, const Penumbra::Rendering::Font& font,
+                 const Penumbra::Platform::FramePacer& pacer)
+{
+    static Penumbra::Rendering::TextLayout layout;
+    if (frame.frameNumber % 30 == 0 || layout.getQuads().empty())
+    {
+        Penumbra::Platform::FramePacingReport report = pacer.getReport();
+        char text[160];
+        std::snprintf(text, sizeof(text), "FRAME %.2f MS (SD %.2f, MAX %.2f)\nLATENCY %.2f MS (MAX %.2f)",
+                      report.frameTimeMean * 1000.0, report.frameTimeStdDev * 1000.0,
+                      report.frameTimeMax * 1000.0, report.latencyMean * 1000.0, report.latencyMax * 1000.0);
+        layout.set(font, text);
+    }
+    layout.draw(frame.overlay, Penumbra::Math::Vec2(8.0f, 24.0f), Penumbra::Math::Color::White, 2.0f,
+                OVERLAY_LAYER);
+}
+
 /**
  * Main game loop
  */
 int main(int argc, char* argv[])
 {
-    (void)argc; // Suppress unused parameter warnings
-    (void)argv;
+    using Penumbra::Platform::PresentMode;
+
+    // --no-render-thread renders and presents inline: one frame less latency, no overlap
+    // --present uncapped|vsync|adaptive, --fps <rate> limits without vsync,
+    // --late-input polls input after the pacing wait instead of before it
+    // --world-resolution <w>x<h> sets the offscreen world size, 0x0 renders at window size
+    // --dynamic-resolution lowers the world's rendered resolution while GPU time is over budget
+    bool renderThreaded = true;
+    bool dynamicResolution = false;
+    int worldWidth = WORLD_WIDTH;
+    int worldHeight = WORLD_HEIGHT;
+    Penumbra::Platform::FramePacer pacer;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--no-render-thread") == 0)
+        {
+            renderThreaded = false;
+        }
+        else if (std::strcmp(argv[i], "--present") == 0 && i + 1 < argc)
+        {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "uncapped") == 0)
+            {
+                pacer.setMode(PresentMode::Uncapped);
+            }
+            else if (std::strcmp(name, "adaptive") == 0)
+            {
+                pacer.setMode(PresentMode::AdaptiveVSync);
+            }
+            else
+            {
+                pacer.setMode(PresentMode::VSync);
+            }
+        }
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+        {
+            pacer.setMode(PresentMode::Limited, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--late-input") == 0)
+        {
+            pacer.setLateInputSampling(true);
+        }
+        else if (std::strcmp(argv[i], "--dynamic-resolution") == 0)
+        {
+            dynamicResolution = true;
+        }
+        else if (std::strcmp(argv[i], "--world-resolution") == 0 && i + 1 < argc)
+        {
+            if (std::sscanf(argv[++i], "%dx%d", &worldWidth, &worldHeight) != 2)
+            {
+                worldWidth = WORLD_WIDTH;
+                worldHeight = WORLD_HEIGHT;
+            }
+        }
+    }
 
     SDL_Window* window = nullptr;
     SDL_GLContext context = nullptr;
@@ -171,44 +300,94 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // Owns GL objects: destroyed explicitly while the context still exists
+    auto renderer = std::make_unique<Penumbra::Rendering::Renderer>();
+    renderer->initialize(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // Cooked assets (cook_assets writes them next to the executable)
+    Penumbra::Resources::ResourceManager& resources = Penumbra::Resources::ResourceManager::getInstance();
+    resources.initialize(Penumbra::Platform::FileSystem::joinPath(
+        Penumbra::Platform::FileSystem::getBasePath(), "assets"));
+    resources.setStateCache(&renderer->getStateCache());
+
+    renderer->setWorldResolution(worldWidth, worldHeight);
+    renderer->setDynamicResolution(dynamicResolution);
+    Penumbra::Rendering::Camera camera(static_cast<float>(renderer->getWorldWidth()),
+                                       static_cast<float>(renderer->getWorldHeight()));
+
+    Penumbra::Rendering::RenderThread::Hooks hooks;
+    hooks.bindContext = [window, context](bool current) {
+        SDL_GL_MakeCurrent(window, current ? context : nullptr);
+    };
+    hooks.present = [window] { SDL_GL_SwapWindow(window); };
+    hooks.presented = [&pacer](const Penumbra::Rendering::FramePacket& frame) {
+        pacer.recordPresent(frame.inputTime);
+    };
+    pacer.applySwapInterval();
+    auto renderThread = std::make_unique<Penumbra::Rendering::RenderThread>(*renderer, hooks);
+    renderThread->setThreaded(renderThreaded);
+
     std::cout << "PENUMBRA initialized successfully" << std::endl;
+    std::cout << "Render thread: " << (renderThreaded ? "on" : "off") << std::endl;
+    std::cout << "Present mode: " << Penumbra::Platform::getPresentModeName(pacer.getMode());
+    if (pacer.getMode() == PresentMode::Limited)
+    {
+        std::cout << " (" << pacer.getTargetRate() << " Hz)";
+    }
+    std::cout << (pacer.getLateInputSampling() ? ", late input sampling" : "") << std::endl;
+    std::cout << "World resolution: " << renderer->getWorldWidth() << "x" << renderer->getWorldHeight()
+              << (dynamicResolution ? ", dynamic" : "") << std::endl;
     std::cout << "Press ESC to quit" << std::endl;
 
     // Game loop state
     bool running = true;
-    Uint64 lastTime = SDL_GetPerformanceCounter();
-    const Uint64 perfFreq = SDL_GetPerformanceFrequency();
 
     // Main game loop
     while (running)
     {
-        // Calculate delta time
-        Uint64 currentTime = SDL_GetPerformanceCounter();
-        float deltaTime = static_cast<float>(currentTime - lastTime) / static_cast<float>(perfFreq);
-        lastTime = currentTime;
-
-        // Process events
-        SDL_Event event;
-        while (SDL_PollEvent(&event))
+        // Process events; late sampling polls after the pacing wait so input is fresher
+        if (!pacer.getLateInputSampling())
         {
-            if (!handleEvents(event))
-            {
-                running = false;
-            }
+            running = pollEvents();
+        }
+        float deltaTime = static_cast<float>(pacer.beginFrame());
+        if (pacer.getLateInputSampling())
+        {
+            running = pollEvents();
         }
+        double inputTime = pacer.markInputSampled();
 
-        // Update game state
+        // Update game state; texture eviction bookkeeping runs here, GL
+        // deletes happen on the render thread
+        resources.beginFrame();
         update(deltaTime);
 
-        // Render frame
-        render();
-
-        // Swap buffers
-        SDL_GL_SwapWindow(window);
+        // Record frame; with the render thread on, frame N is drawn and
+        // presented while frame N + 1 simulates
+        Penumbra::Rendering::FramePacket& frame = renderThread->beginFrame(camera);
+        frame.inputTime = inputTime;
+        render(frame, renderThread->getDebugDraw());
+        if (debugOverlay)
+        {
+            drawOverlay(frame, renderer->getDefaultFont(), pacer);
+        }
+        renderThread->submitFrame();
     }
 
     // Cleanup
     std::cout << "Shutting down..." << std::endl;
+    renderThread.reset();  // Presents the last frame and hands the context back
+    resources.clearAll();
+    resources.releaseRetiredTextures();
+    resources.setStateCache(nullptr);
+    renderer.reset();
+
+    Penumbra::Platform::FramePacingReport report = pacer.getReport();
+    std::cout << "Frame time: " << report.frameTimeMean * 1000.0 << " ms mean, "
+              << report.frameTimeStdDev * 1000.0 << " ms std dev, "
+              << report.frameTimeMax * 1000.0 << " ms max" << std::endl;
+    std::cout << "Input to present: " << report.latencyMean * 1000.0 << " ms mean, "
+              << report.latencyMax * 1000.0 << " ms max" << std::endl;
     SDL_GL_DeleteContext(context);
     SDL_DestroyWindow(window);
     SDL_Quit();
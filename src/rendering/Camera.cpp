@@ -0,0 +1,198 @@
+#include "rendering/Camera.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+constexpr float MIN_ZOOM = 0.01f;
+
+// Lerp speed is tuned per 60 Hz frame and rescaled for the actual delta
+constexpr float REFERENCE_FRAME_RATE = 60.0f;
+
+} // namespace
+
+Camera::Camera()
+    : Camera(0.0f, 0.0f)
+{
+}
+
+Camera::Camera(float viewportWidth, float viewportHeight)
+    : position(0.0f, 0.0f)
+    , targetPosition(0.0f, 0.0f)
+    , mode(CameraMode::Fixed)
+    , lerpSpeed(0.1f)
+    , deadZoneSize(64.0f, 48.0f)
+    , hasBounds(false)
+    , boundsMin(0.0f, 0.0f)
+    , boundsMax(0.0f, 0.0f)
+    , viewportWidth(viewportWidth)
+    , viewportHeight(viewportHeight)
+    , zoom(1.0f)
+    , shakeIntensity(0.0f)
+    , shakeDuration(0.0f)
+    , shakeTimer(0.0f)
+{
+}
+
+void Camera::initialize(float width, float height)
+{
+    setViewportSize(width, height);
+    zoom = 1.0f;
+}
+
+void Camera::update(float deltaTime)
+{
+    switch (mode)
+    {
+        case CameraMode::Fixed:
+            break;
+
+        case CameraMode::FollowPlayer:
+            position = targetPosition;
+            break;
+
+        case CameraMode::Lerp:
+        {
+            float t = 1.0f - std::pow(1.0f - lerpSpeed, deltaTime * REFERENCE_FRAME_RATE);
+            position = Math::lerp(position, targetPosition, t);
+            break;
+        }
+
+        case CameraMode::DeadZone:
+        {
+            // Only move far enough to keep the target inside the zone
+            Math::Vec2 halfZone = deadZoneSize * 0.5f;
+            Math::Vec2 offset = targetPosition - position;
+            if (offset.x > halfZone.x) position.x = targetPosition.x - halfZone.x;
+            if (offset.x < -halfZone.x) position.x = targetPosition.x + halfZone.x;
+            if (offset.y > halfZone.y) position.y = targetPosition.y - halfZone.y;
+            if (offset.y < -halfZone.y) position.y = targetPosition.y + halfZone.y;
+            break;
+        }
+    }
+
+    if (shakeTimer > 0.0f)
+    {
+        shakeTimer = std::max(0.0f, shakeTimer - deltaTime);
+    }
+
+    applyBounds();
+}
+
+void Camera::setPosition(float x, float y)
+{
+    setPosition(Math::Vec2(x, y));
+}
+
+void Camera::setPosition(const Math::Vec2& newPosition)
+{
+    position = newPosition;
+    applyBounds();
+}
+
+void Camera::setTarget(const Math::Vec2& target)
+{
+    targetPosition = target;
+}
+
+void Camera::setDeadZone(float width, float height)
+{
+    deadZoneSize = Math::Vec2(width, height);
+}
+
+void Camera::setBounds(float minX, float minY, float maxX, float maxY)
+{
+    hasBounds = true;
+    boundsMin = Math::Vec2(minX, minY);
+    boundsMax = Math::Vec2(maxX, maxY);
+    applyBounds();
+}
+
+void Camera::clearBounds()
+{
+    hasBounds = false;
+}
+
+Math::Mat4 Camera::getViewMatrix() const
+{
+    // World (y-down, camera position at viewport center) to screen pixels
+    Math::Vec2 eye = position + getShakeOffset();
+    Math::Mat4 view(1.0f);
+    view = glm::translate(view, Math::Vec3(viewportWidth * 0.5f, viewportHeight * 0.5f, 0.0f));
+    view = glm::scale(view, Math::Vec3(zoom, zoom, 1.0f));
+    view = glm::translate(view, Math::Vec3(-eye.x, -eye.y, 0.0f));
+    return view;
+}
+
+Math::Mat4 Camera::getProjectionMatrix() const
+{
+    // Screen pixels with origin top-left
+    return glm::ortho(0.0f, viewportWidth, viewportHeight, 0.0f, -1.0f, 1.0f);
+}
+
+void Camera::setZoom(float newZoom)
+{
+    zoom = std::max(newZoom, MIN_ZOOM);
+}
+
+Math::Vec2 Camera::screenToWorld(float screenX, float screenY) const
+{
+    Math::Vec2 eye = position + getShakeOffset();
+    return Math::Vec2((screenX - viewportWidth * 0.5f) / zoom + eye.x,
+                      (screenY - viewportHeight * 0.5f) / zoom + eye.y);
+}
+
+Math::Vec2 Camera::worldToScreen(float worldX, float worldY) const
+{
+    Math::Vec2 eye = position + getShakeOffset();
+    return Math::Vec2((worldX - eye.x) * zoom + viewportWidth * 0.5f,
+                      (worldY - eye.y) * zoom + viewportHeight * 0.5f);
+}
+
+Math::AABB Camera::getVisibleBounds(float margin) const
+{
+    Math::Vec2 topLeft = screenToWorld(0.0f, 0.0f);
+    Math::Vec2 bottomRight = screenToWorld(viewportWidth, viewportHeight);
+    Math::Vec2 border(margin, margin);
+    return Math::AABB(glm::min(topLeft, bottomRight) - border, glm::max(topLeft, bottomRight) + border);
+}
+
+void Camera::setViewportSize(float width, float height)
+{
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void Camera::shake(float intensity, float duration)
+{
+    shakeIntensity = intensity;
+    shakeDuration = duration;
+    shakeTimer = duration;
+}
+
+void Camera::applyBounds()
+{
+    if (hasBounds)
+    {
+        position.x = Math::clamp(position.x, boundsMin.x, boundsMax.x);
+        position.y = Math::clamp(position.y, boundsMin.y, boundsMax.y);
+    }
+}
+
+Math::Vec2 Camera::getShakeOffset() const
+{
+    if (shakeTimer <= 0.0f || shakeDuration <= 0.0f)
+    {
+        return Math::Vec2(0.0f, 0.0f);
+    }
+
+    // Decaying, deterministic jitter; incommensurate frequencies avoid a visible pattern
+    float strength = shakeIntensity * (shakeTimer / shakeDuration);
+    return Math::Vec2(std::sin(shakeTimer * 97.0f), std::cos(shakeTimer * 61.0f)) * strength;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,297 @@
+#include "rendering/DebugDraw.h"
+
+#if PENUMBRA_DEBUG_DRAW
+
+#include <cctype>
+#include <cmath>
+#include <string>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+/**
+ * 16-segment display strokes in a 1 x 2 cell, y down
+ * a/A top halves, b/c right, d/D bottom halves, e/f left, g/G middle halves,
+ * h/i/j upper diagonal-vertical-diagonal, k/l/m lower
+ */
+struct Segment {
+    char name;
+    float x0, y0, x1, y1;
+};
+
+const Segment SEGMENTS[] = {
+    {'a', 0.0f, 0.0f, 0.5f, 0.0f}, {'A', 0.5f, 0.0f, 1.0f, 0.0f},
+    {'b', 1.0f, 0.0f, 1.0f, 1.0f}, {'c', 1.0f, 1.0f, 1.0f, 2.0f},
+    {'d', 0.0f, 2.0f, 0.5f, 2.0f}, {'D', 0.5f, 2.0f, 1.0f, 2.0f},
+    {'e', 0.0f, 1.0f, 0.0f, 2.0f}, {'f', 0.0f, 0.0f, 0.0f, 1.0f},
+    {'g', 0.0f, 1.0f, 0.5f, 1.0f}, {'G', 0.5f, 1.0f, 1.0f, 1.0f},
+    {'h', 0.0f, 0.0f, 0.5f, 1.0f}, {'i', 0.5f, 0.0f, 0.5f, 1.0f}, {'j', 1.0f, 0.0f, 0.5f, 1.0f},
+    {'k', 0.5f, 1.0f, 0.0f, 2.0f}, {'l', 0.5f, 1.0f, 0.5f, 2.0f}, {'m', 0.5f, 1.0f, 1.0f, 2.0f},
+};
+
+/**
+ * Segments lit per printable character; lowercase draws as uppercase
+ */
+const char* glyphSegments(char c)
+{
+    switch (std::toupper(static_cast<unsigned char>(c)))
+    {
+        case '0': return "aAbcdDefjk";
+        case '1': return "bcj";
+        case '2': return "aAbgGedD";
+        case '3': return "aAbcdDG";
+        case '4': return "fgGbc";
+        case '5': return "aAfgGcdD";
+        case '6': return "aAfgGcdDe";
+        case '7': return "aAbc";
+        case '8': return "aAbcdDefgG";
+        case '9': return "aAbcdDfgG";
+        case 'A': return "aAbcefgG";
+        case 'B': return "aAbcdDGil";
+        case 'C': return "aAdDef";
+        case 'D': return "aAbcdDil";
+        case 'E': return "aAdDefg";
+        case 'F': return "aAefg";
+        case 'G': return "aAcdDefG";
+        case 'H': return "bcefgG";
+        case 'I': return "aAdDil";
+        case 'J': return "bcdDe";
+        case 'K': return "efgjm";
+        case 'L': return "dDef";
+        case 'M': return "bcefhj";
+        case 'N': return "bcefhm";
+        case 'O': return "aAbcdDef";
+        case 'P': return "aAbefgG";
+        case 'Q': return "aAbcdDefm";
+        case 'R': return "aAbefgGm";
+        case 'S': return "aAfgGcdD";
+        case 'T': return "aAil";
+        case 'U': return "bcdDef";
+        case 'V': return "efjk";
+        case 'W': return "bcefkm";
+        case 'X': return "hjkm";
+        case 'Y': return "hjl";
+        case 'Z': return "aAjkdD";
+        case '-': return "gG";
+        case '+': return "gGil";
+        case '=': return "gGdD";
+        case '_': return "dD";
+        case '/': return "jk";
+        case '\\': return "hm";
+        case '(': return "jm";
+        case ')': return "hk";
+        case '*': return "gGhijklm";
+        case '.': return "d";
+        case ',': return "k";
+        case ':': return "il";
+        case '%': return "afgjkGcD";
+        default: return "";
+    }
+}
+
+DebugVertex makeVertex(float x, float y, float z, const Math::Color& color)
+{
+    auto pack = [](float value) {
+        return static_cast<uint8_t>(Math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+
+    DebugVertex vertex;
+    vertex.x = x;
+    vertex.y = y;
+    vertex.z = z;
+    vertex.r = pack(color.r * color.a);
+    vertex.g = pack(color.g * color.a);
+    vertex.b = pack(color.b * color.a);
+    vertex.a = pack(color.a);
+    return vertex;
+}
+
+} // namespace
+
+DebugDrawQueue::DebugDrawQueue()
+    : persistentLines(0)
+    , persistentTriangles(0)
+{
+}
+
+DebugVertex* DebugDrawQueue::append(std::vector<DebugVertex>& list, size_t& persistentCount,
+                                    size_t count, DebugLifetime lifetime)
+{
+    if (lifetime == DebugLifetime::Frame)
+    {
+        list.resize(list.size() + count);
+        return &list[list.size() - count];
+    }
+
+    // Rare; shifts this frame's primitives back to keep persistent ones in front
+    list.insert(list.begin() + static_cast<std::ptrdiff_t>(persistentCount), count, DebugVertex());
+    persistentCount += count;
+    return &list[persistentCount - count];
+}
+
+DebugVertex* DebugDrawQueue::appendLines(size_t lineCount, DebugLifetime lifetime)
+{
+    return append(lines, persistentLines, lineCount * 2, lifetime);
+}
+
+DebugVertex* DebugDrawQueue::appendTriangles(size_t triangleCount, DebugLifetime lifetime)
+{
+    return append(triangles, persistentTriangles, triangleCount * 3, lifetime);
+}
+
+void DebugDrawQueue::line(const Math::Vec2& start, const Math::Vec2& end, const Math::Color& color,
+                          DebugLifetime lifetime)
+{
+    DebugVertex* out = appendLines(1, lifetime);
+    out[0] = makeVertex(start.x, start.y, 0.0f, color);
+    out[1] = makeVertex(end.x, end.y, 0.0f, color);
+}
+
+void DebugDrawQueue::line(const Math::Vec3& start, const Math::Vec3& end, const Math::Color& color,
+                          DebugLifetime lifetime)
+{
+    DebugVertex* out = appendLines(1, lifetime);
+    out[0] = makeVertex(start.x, start.y, start.z, color);
+    out[1] = makeVertex(end.x, end.y, end.z, color);
+}
+
+void DebugDrawQueue::rect(const Math::Rect& bounds, const Math::Color& color, bool filled,
+                          DebugLifetime lifetime)
+{
+    float left = bounds.x;
+    float top = bounds.y;
+    float right = bounds.x + bounds.width;
+    float bottom = bounds.y + bounds.height;
+
+    if (filled)
+    {
+        DebugVertex* out = appendTriangles(2, lifetime);
+        out[0] = makeVertex(left, top, 0.0f, color);
+        out[1] = makeVertex(right, top, 0.0f, color);
+        out[2] = makeVertex(right, bottom, 0.0f, color);
+        out[3] = out[0];
+        out[4] = out[2];
+        out[5] = makeVertex(left, bottom, 0.0f, color);
+        return;
+    }
+
+    DebugVertex corners[4] = {
+        makeVertex(left, top, 0.0f, color),
+        makeVertex(right, top, 0.0f, color),
+        makeVertex(right, bottom, 0.0f, color),
+        makeVertex(left, bottom, 0.0f, color),
+    };
+    DebugVertex* out = appendLines(4, lifetime);
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i * 2] = corners[i];
+        out[i * 2 + 1] = corners[(i + 1) % 4];
+    }
+}
+
+void DebugDrawQueue::circle(const Math::Vec2& center, float radius, const Math::Color& color, bool filled,
+                            DebugLifetime lifetime)
+{
+    DebugVertex rim[CIRCLE_SEGMENTS];
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i)
+    {
+        float angle = Math::toRadians(360.0f * static_cast<float>(i) / static_cast<float>(CIRCLE_SEGMENTS));
+        rim[i] = makeVertex(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius,
+                            0.0f, color);
+    }
+
+    if (filled)
+    {
+        DebugVertex middle = makeVertex(center.x, center.y, 0.0f, color);
+        DebugVertex* out = appendTriangles(CIRCLE_SEGMENTS, lifetime);
+        for (int i = 0; i < CIRCLE_SEGMENTS; ++i)
+        {
+            out[i * 3] = middle;
+            out[i * 3 + 1] = rim[i];
+            out[i * 3 + 2] = rim[(i + 1) % CIRCLE_SEGMENTS];
+        }
+        return;
+    }
+
+    DebugVertex* out = appendLines(CIRCLE_SEGMENTS, lifetime);
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i)
+    {
+        out[i * 2] = rim[i];
+        out[i * 2 + 1] = rim[(i + 1) % CIRCLE_SEGMENTS];
+    }
+}
+
+void DebugDrawQueue::text(const Math::Vec2& position, const std::string& message, const Math::Color& color,
+                          float height, DebugLifetime lifetime)
+{
+    // The cell is 1 x 2 units; glyphs advance by 1.5 cell widths
+    float unit = height * 0.5f;
+    float advance = unit * 1.5f;
+
+    size_t strokeCount = 0;
+    for (char c : message)
+    {
+        strokeCount += std::char_traits<char>::length(glyphSegments(c));
+    }
+    if (strokeCount == 0)
+    {
+        return;
+    }
+
+    DebugVertex* out = appendLines(strokeCount, lifetime);
+    float penX = position.x;
+    float penY = position.y;
+    for (char c : message)
+    {
+        if (c == '\n')
+        {
+            penX = position.x;
+            penY += height + unit;
+            continue;
+        }
+
+        for (const char* name = glyphSegments(c); *name != '\0'; ++name)
+        {
+            for (const Segment& segment : SEGMENTS)
+            {
+                if (segment.name != *name)
+                {
+                    continue;
+                }
+                *out++ = makeVertex(penX + segment.x0 * unit, penY + segment.y0 * unit, 0.0f, color);
+                *out++ = makeVertex(penX + segment.x1 * unit, penY + segment.y1 * unit, 0.0f, color);
+                break;
+            }
+        }
+        penX += advance;
+    }
+}
+
+void DebugDrawQueue::endFrame()
+{
+    lines.resize(persistentLines);
+    triangles.resize(persistentTriangles);
+}
+
+void DebugDrawQueue::clearPersistent()
+{
+    lines.erase(lines.begin(), lines.begin() + static_cast<std::ptrdiff_t>(persistentLines));
+    triangles.erase(triangles.begin(), triangles.begin() + static_cast<std::ptrdiff_t>(persistentTriangles));
+    persistentLines = 0;
+    persistentTriangles = 0;
+}
+
+void DebugDrawQueue::clear()
+{
+    lines.clear();
+    triangles.clear();
+    persistentLines = 0;
+    persistentTriangles = 0;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
+
+#endif // PENUMBRA_DEBUG_DRAW
@@ -0,0 +1,85 @@
+#include "rendering/DrawSort.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+/**
+ * Map float bits to an unsigned value with the same ordering
+ */
+uint32_t orderedFloatBits(float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+}
+
+} // namespace
+
+uint64_t makeSortKey(int layer, float depth, uint32_t textureSlot, uint32_t shaderSlot)
+{
+    uint64_t layerBits = static_cast<uint64_t>(std::min(std::max(layer, -128), 127) + 128);
+    return (layerBits << 56) |
+           (static_cast<uint64_t>(orderedFloatBits(depth)) << 24) |
+           (static_cast<uint64_t>(textureSlot & 0xFFFFu) << 8) |
+           static_cast<uint64_t>(shaderSlot & 0xFFu);
+}
+
+void radixSort(std::vector<DrawCommand>& commands, std::vector<DrawCommand>& scratch)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+    {
+        return;
+    }
+    scratch.resize(count);
+
+    // One histogram pass over the input serves all eight digit passes
+    size_t histograms[8][256] = {};
+    for (const DrawCommand& command : commands)
+    {
+        for (int byte = 0; byte < 8; ++byte)
+        {
+            ++histograms[byte][(command.key >> (byte * 8)) & 0xFF];
+        }
+    }
+
+    DrawCommand* source = commands.data();
+    DrawCommand* dest = scratch.data();
+    for (int byte = 0; byte < 8; ++byte)
+    {
+        size_t* histogram = histograms[byte];
+        unsigned int shift = static_cast<unsigned int>(byte * 8);
+
+        // Every key has the same digit: this pass wouldn't move anything
+        if (histogram[(source[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            size_t bucketCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += bucketCount;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            dest[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, dest);
+    }
+
+    if (source != commands.data())
+    {
+        std::copy(source, source + count, commands.data());
+    }
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,78 @@
+#include "rendering/DynamicResolution.h"
+#include "core/Math.h"
+
+namespace Penumbra {
+namespace Rendering {
+
+DynamicResolution::DynamicResolution()
+{
+    reset();
+}
+
+void DynamicResolution::setSettings(const DynamicResolutionSettings& newSettings)
+{
+    settings = newSettings;
+    reset();
+}
+
+void DynamicResolution::reset()
+{
+    scale = settings.maxScale;
+    smoothedTime = 0.0;
+    overFrames = 0;
+    underFrames = 0;
+    settling = 0;
+    hasSample = false;
+}
+
+bool DynamicResolution::update(double gpuFrameTime)
+{
+    if (settling > 0)
+    {
+        --settling;
+        return false;
+    }
+
+    smoothedTime = hasSample ? smoothedTime + (gpuFrameTime - smoothedTime) * settings.smoothing : gpuFrameTime;
+    hasSample = true;
+
+    if (smoothedTime > settings.targetFrameTime * settings.shrinkAbove)
+    {
+        underFrames = 0;
+        if (++overFrames >= settings.shrinkFrames && scale > settings.minScale)
+        {
+            setScale(scale - settings.step);
+            return true;
+        }
+    }
+    else if (smoothedTime < settings.targetFrameTime * settings.growBelow)
+    {
+        overFrames = 0;
+        if (++underFrames >= settings.growFrames && scale < settings.maxScale)
+        {
+            setScale(scale + settings.step);
+            return true;
+        }
+    }
+    else
+    {
+        overFrames = 0;
+        underFrames = 0;
+    }
+    return false;
+}
+
+void DynamicResolution::setScale(float newScale)
+{
+    scale = Math::clamp(newScale, settings.minScale, settings.maxScale);
+    overFrames = 0;
+    underFrames = 0;
+
+    // Times measured at the old scale are still in flight; start the
+    // average over from the first sample at the new one
+    settling = settings.settleFrames;
+    hasSample = false;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
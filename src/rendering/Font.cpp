@@ -0,0 +1,274 @@
+#include "rendering/Font.h"
+#include "core/CookedAssets.h"
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Built-in font layout: 5x7 glyphs in 6x9 cells (one pixel gap right, two below)
+constexpr int BUILTIN_FIRST = 32;
+constexpr int BUILTIN_COUNT = 95;
+constexpr int BUILTIN_GLYPH_WIDTH = 5;
+constexpr int BUILTIN_GLYPH_HEIGHT = 7;
+constexpr int BUILTIN_CELL_WIDTH = 6;
+constexpr int BUILTIN_CELL_HEIGHT = 9;
+constexpr int BUILTIN_COLUMNS = 16;
+
+// One byte per row, top to bottom; bit 4 is the leftmost pixel
+const uint8_t BUILTIN_GLYPHS[BUILTIN_COUNT][BUILTIN_GLYPH_HEIGHT] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // space
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // !
+    {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00},  // "
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},  // #
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},  // $
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // %
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},  // &
+    {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},  // quote
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // (
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // )
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},  // *
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // +
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},  // ,
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // -
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // .
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},  // ;
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // <
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},  // =
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // >
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // ?
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E},  // @
+    {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11},  // A
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // D
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},  // [
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // backslash
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},  // ]
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},  // ^
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},  // _
+    {0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},  // `
+    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F},  // a
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E},  // b
+    {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E},  // c
+    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F},  // d
+    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E},  // e
+    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08},  // f
+    {0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // g
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11},  // h
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E},  // i
+    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C},  // j
+    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12},  // k
+    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // l
+    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11},  // m
+    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11},  // n
+    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E},  // o
+    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10},  // p
+    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01},  // q
+    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10},  // r
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E},  // s
+    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06},  // t
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D},  // u
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04},  // v
+    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A},  // w
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11},  // x
+    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // y
+    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F},  // z
+    {0x03, 0x04, 0x04, 0x08, 0x04, 0x04, 0x03},  // {
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // |
+    {0x18, 0x04, 0x04, 0x02, 0x04, 0x04, 0x18},  // }
+    {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00},  // ~
+};
+
+uint64_t kerningKey(uint32_t first, uint32_t second)
+{
+    return (static_cast<uint64_t>(first) << 32) | second;
+}
+
+} // namespace
+
+Font::Font()
+    : page(nullptr)
+    , revision(0)
+{
+    reset(0, 0);
+}
+
+void Font::reset(int width, int height)
+{
+    glyphs.clear();
+    otherGlyphs.clear();
+    kernings.clear();
+    for (int32_t& index : asciiGlyphs)
+    {
+        index = NO_GLYPH;
+    }
+
+    lineHeight = 0.0f;
+    baseline = 0.0f;
+    pageWidth = width;
+    pageHeight = height;
+    pagePath.clear();
+    ++revision;
+}
+
+void Font::addGlyph(uint32_t codepoint, const Glyph& glyph)
+{
+    int32_t index = static_cast<int32_t>(glyphs.size());
+    glyphs.push_back(glyph);
+    if (codepoint < ASCII_COUNT)
+    {
+        asciiGlyphs[codepoint] = index;
+    }
+    else
+    {
+        otherGlyphs[codepoint] = index;
+    }
+}
+
+bool Font::loadFromFile(const std::string& path)
+{
+    Assets::CookedFont cooked;
+    if (!Assets::readFont(path, cooked))
+    {
+        std::cerr << "Missing or out-of-date cooked font: " << path << std::endl;
+        return false;
+    }
+    if (cooked.pageWidth <= 0 || cooked.pageHeight <= 0)
+    {
+        std::cerr << "Cooked font has an empty page: " << path << std::endl;
+        return false;
+    }
+
+    reset(cooked.pageWidth, cooked.pageHeight);
+    lineHeight = static_cast<float>(cooked.lineHeight);
+    baseline = static_cast<float>(cooked.base);
+    pagePath = cooked.page;
+
+    float inverseWidth = 1.0f / static_cast<float>(pageWidth);
+    float inverseHeight = 1.0f / static_cast<float>(pageHeight);
+    glyphs.reserve(cooked.glyphs.size());
+    for (const auto& source : cooked.glyphs)
+    {
+        Glyph glyph;
+        glyph.textureRect = Math::Rect(source.x * inverseWidth, source.y * inverseHeight,
+                                       source.width * inverseWidth, source.height * inverseHeight);
+        glyph.size = Math::Vec2(source.width, source.height);
+        glyph.offset = Math::Vec2(source.offsetX, source.offsetY);
+        glyph.advance = static_cast<float>(source.advance);
+        addGlyph(source.codepoint, glyph);
+    }
+
+    for (const auto& kerning : cooked.kernings)
+    {
+        kernings[kerningKey(kerning.first, kerning.second)] = static_cast<float>(kerning.amount);
+    }
+    return true;
+}
+
+void Font::loadBuiltin(std::vector<uint8_t>& outPixels)
+{
+    int rows = (BUILTIN_COUNT + BUILTIN_COLUMNS - 1) / BUILTIN_COLUMNS;
+    reset(BUILTIN_COLUMNS * BUILTIN_CELL_WIDTH, rows * BUILTIN_CELL_HEIGHT);
+    lineHeight = static_cast<float>(BUILTIN_CELL_HEIGHT);
+    baseline = static_cast<float>(BUILTIN_GLYPH_HEIGHT);
+
+    outPixels.assign(static_cast<size_t>(pageWidth) * static_cast<size_t>(pageHeight) * 4, 0);
+    float inverseWidth = 1.0f / static_cast<float>(pageWidth);
+    float inverseHeight = 1.0f / static_cast<float>(pageHeight);
+
+    for (int i = 0; i < BUILTIN_COUNT; ++i)
+    {
+        int cellX = (i % BUILTIN_COLUMNS) * BUILTIN_CELL_WIDTH;
+        int cellY = (i / BUILTIN_COLUMNS) * BUILTIN_CELL_HEIGHT;
+        for (int y = 0; y < BUILTIN_GLYPH_HEIGHT; ++y)
+        {
+            for (int x = 0; x < BUILTIN_GLYPH_WIDTH; ++x)
+            {
+                if ((BUILTIN_GLYPHS[i][y] >> (BUILTIN_GLYPH_WIDTH - 1 - x)) & 1)
+                {
+                    size_t offset = (static_cast<size_t>(cellY + y) * static_cast<size_t>(pageWidth) +
+                                     static_cast<size_t>(cellX + x)) * 4;
+                    outPixels[offset] = 255;
+                    outPixels[offset + 1] = 255;
+                    outPixels[offset + 2] = 255;
+                    outPixels[offset + 3] = 255;
+                }
+            }
+        }
+
+        Glyph glyph;
+        glyph.textureRect = Math::Rect(cellX * inverseWidth, cellY * inverseHeight,
+                                       BUILTIN_GLYPH_WIDTH * inverseWidth, BUILTIN_GLYPH_HEIGHT * inverseHeight);
+        glyph.size = Math::Vec2(BUILTIN_GLYPH_WIDTH, BUILTIN_GLYPH_HEIGHT);
+        glyph.offset = Math::Vec2(0.0f, 0.0f);
+        glyph.advance = static_cast<float>(BUILTIN_CELL_WIDTH);
+        addGlyph(static_cast<uint32_t>(BUILTIN_FIRST + i), glyph);
+    }
+}
+
+const Glyph* Font::getGlyph(uint32_t codepoint) const
+{
+    int32_t index = NO_GLYPH;
+    if (codepoint < ASCII_COUNT)
+    {
+        index = asciiGlyphs[codepoint];
+    }
+    else
+    {
+        auto it = otherGlyphs.find(codepoint);
+        if (it != otherGlyphs.end())
+        {
+            index = it->second;
+        }
+    }
+    return index == NO_GLYPH ? nullptr : &glyphs[static_cast<size_t>(index)];
+}
+
+float Font::getKerning(uint32_t first, uint32_t second) const
+{
+    if (kernings.empty())
+    {
+        return 0.0f;
+    }
+    auto it = kernings.find(kerningKey(first, second));
+    return it != kernings.end() ? it->second : 0.0f;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,87 @@
+#include "rendering/FrameUniforms.h"
+#include "rendering/Camera.h"
+#include "rendering/IsometricCamera.h"
+#include "rendering/Shaders.h"
+#include "core/OpenGL.h"
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+FrameData makeFrameData(const Math::Mat4& view, const Math::Mat4& projection,
+                        float width, float height, float time, float deltaTime)
+{
+    FrameData frameData;
+    frameData.view = view;
+    frameData.projection = projection;
+    frameData.viewProjection = projection * view;
+    frameData.viewport = Math::Vec4(width, height,
+                                    width > 0.0f ? 1.0f / width : 0.0f,
+                                    height > 0.0f ? 1.0f / height : 0.0f);
+    frameData.time = Math::Vec4(time, deltaTime, 0.0f, 0.0f);
+    frameData.cameraRight = Math::Vec4(1.0f, 0.0f, 0.0f, 0.0f);
+    frameData.cameraDown = Math::Vec4(0.0f, 1.0f, 0.0f, 0.0f);
+    return frameData;
+}
+
+} // namespace
+
+FrameUniforms::FrameUniforms()
+    : UBO(0)
+{
+    data.view = Math::Mat4(1.0f);
+    data.projection = Math::Mat4(1.0f);
+    data.viewProjection = Math::Mat4(1.0f);
+    data.viewport = Math::Vec4(0.0f);
+    data.time = Math::Vec4(0.0f);
+    data.cameraRight = Math::Vec4(1.0f, 0.0f, 0.0f, 0.0f);
+    data.cameraDown = Math::Vec4(0.0f, 1.0f, 0.0f, 0.0f);
+}
+
+FrameUniforms::~FrameUniforms()
+{
+    if (UBO != 0)
+    {
+        glDeleteBuffers(1, &UBO);
+    }
+}
+
+void FrameUniforms::initialize()
+{
+    if (UBO == 0)
+    {
+        glGenBuffers(1, &UBO);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &data, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Shaders::FRAME_UNIFORM_BINDING, UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::update(const Camera& camera, float time, float deltaTime)
+{
+    update(makeFrameData(camera.getViewMatrix(), camera.getProjectionMatrix(),
+                         camera.getViewportWidth(), camera.getViewportHeight(), time, deltaTime));
+}
+
+void FrameUniforms::update(const IsometricCamera& camera, float alphaCutoff, float time, float deltaTime)
+{
+    FrameData frameData = makeFrameData(camera.getViewMatrix(), camera.getProjectionMatrix(),
+                                        camera.getViewportWidth(), camera.getViewportHeight(),
+                                        time, deltaTime);
+    frameData.cameraRight = Math::Vec4(camera.getRight(), 0.0f);
+    frameData.cameraDown = Math::Vec4(camera.getDown(), alphaCutoff);
+    update(frameData);
+}
+
+void FrameUniforms::update(const FrameData& frameData)
+{
+    data = frameData;
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+} // namespace Rendering
+} // namespace Penumbra
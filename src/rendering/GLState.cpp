@@ -0,0 +1,270 @@
+#include "rendering/GLState.h"
+#include "core/OpenGL.h"
+#include <climits>
+#include <cstring>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Shadow value meaning "unknown"; no GL object name or viewport takes it
+constexpr unsigned int UNKNOWN_NAME = ~0u;
+constexpr int UNKNOWN_COORD = INT_MIN;
+
+/**
+ * Backend that forwards straight to the GL context
+ */
+class OpenGLBackend : public GLBackend {
+public:
+    void useProgram(unsigned int program) override
+    {
+        glUseProgram(program);
+    }
+
+    void activeTexture(unsigned int unit) override
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    void bindTexture(unsigned int target, unsigned int texture) override
+    {
+        glBindTexture(target, texture);
+    }
+
+    void bindVertexArray(unsigned int vertexArray) override
+    {
+        glBindVertexArray(vertexArray);
+    }
+
+    void setBlendEnabled(bool enabled) override
+    {
+        if (enabled)
+        {
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            glDisable(GL_BLEND);
+        }
+    }
+
+    void blendFunc(unsigned int sourceFactor, unsigned int destFactor) override
+    {
+        glBlendFunc(sourceFactor, destFactor);
+    }
+
+    void viewport(int x, int y, int width, int height) override
+    {
+        glViewport(x, y, width, height);
+    }
+
+    void setDepthTestEnabled(bool enabled) override
+    {
+        if (enabled)
+        {
+            glEnable(GL_DEPTH_TEST);
+        }
+        else
+        {
+            glDisable(GL_DEPTH_TEST);
+        }
+    }
+
+    void depthMask(bool write) override
+    {
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+    }
+};
+
+} // namespace
+
+bool hasGLVersion(int major, int minor)
+{
+    GLint contextMajor = 0;
+    GLint contextMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &contextMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &contextMinor);
+    return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+bool hasGLExtension(const char* extension)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const GLubyte* name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+        if (name && std::strcmp(reinterpret_cast<const char*>(name), extension) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+GLBackend& GLBackend::getOpenGL()
+{
+    static OpenGLBackend backend;
+    return backend;
+}
+
+GLStateCache::GLStateCache(GLBackend& backend)
+    : backend(backend)
+    , stats{0, 0}
+{
+    invalidate();
+}
+
+void GLStateCache::invalidate()
+{
+    program = UNKNOWN_NAME;
+    activeUnit = UNKNOWN_NAME;
+    for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit)
+    {
+        textures[unit] = UNKNOWN_NAME;
+        textureTargets[unit] = TEXTURE_2D;
+    }
+    vertexArray = UNKNOWN_NAME;
+    blendMode = BlendMode::None;
+    blendKnown = false;
+    depthMode = DepthMode::Disabled;
+    depthKnown = false;
+    for (int& value : viewportRect)
+    {
+        value = UNKNOWN_COORD;
+    }
+}
+
+void GLStateCache::forgetTexture(unsigned int texture)
+{
+    for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit)
+    {
+        if (textures[unit] == texture)
+        {
+            textures[unit] = UNKNOWN_NAME;
+        }
+    }
+}
+
+bool GLStateCache::skip(bool redundant)
+{
+    if (redundant)
+    {
+        ++stats.avoided;
+        return true;
+    }
+    ++stats.issued;
+    return false;
+}
+
+void GLStateCache::selectUnit(unsigned int unit)
+{
+    // Active unit is a selector, not draw state, so it isn't counted
+    if (activeUnit != unit)
+    {
+        backend.activeTexture(unit);
+        activeUnit = unit;
+    }
+}
+
+void GLStateCache::useProgram(unsigned int newProgram)
+{
+    if (skip(program == newProgram))
+    {
+        return;
+    }
+    backend.useProgram(newProgram);
+    program = newProgram;
+}
+
+void GLStateCache::bindTexture(unsigned int unit, unsigned int texture, unsigned int target)
+{
+    if (unit >= MAX_TEXTURE_UNITS)
+    {
+        return;
+    }
+    if (skip(textures[unit] == texture && textureTargets[unit] == target))
+    {
+        return;
+    }
+    selectUnit(unit);
+    backend.bindTexture(target, texture);
+    textures[unit] = texture;
+    textureTargets[unit] = target;
+}
+
+void GLStateCache::bindVertexArray(unsigned int newVertexArray)
+{
+    if (skip(vertexArray == newVertexArray))
+    {
+        return;
+    }
+    backend.bindVertexArray(newVertexArray);
+    vertexArray = newVertexArray;
+}
+
+void GLStateCache::setBlendMode(BlendMode mode)
+{
+    if (skip(blendKnown && blendMode == mode))
+    {
+        return;
+    }
+
+    switch (mode)
+    {
+        case BlendMode::None:
+            backend.setBlendEnabled(false);
+            break;
+        case BlendMode::Alpha:
+            backend.setBlendEnabled(true);
+            backend.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Premultiplied:
+            backend.setBlendEnabled(true);
+            backend.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Additive:
+            backend.setBlendEnabled(true);
+            backend.blendFunc(GL_ONE, GL_ONE);
+            break;
+        case BlendMode::Multiply:
+            backend.setBlendEnabled(true);
+            backend.blendFunc(GL_DST_COLOR, GL_ZERO);
+            break;
+    }
+    blendMode = mode;
+    blendKnown = true;
+}
+
+void GLStateCache::setDepthMode(DepthMode mode)
+{
+    if (skip(depthKnown && depthMode == mode))
+    {
+        return;
+    }
+
+    // Depth writes stay on when testing is off so glClear still reaches the depth buffer
+    backend.setDepthTestEnabled(mode != DepthMode::Disabled);
+    backend.depthMask(mode != DepthMode::TestOnly);
+    depthMode = mode;
+    depthKnown = true;
+}
+
+void GLStateCache::setViewport(int x, int y, int width, int height)
+{
+    bool redundant = viewportRect[0] == x && viewportRect[1] == y &&
+                     viewportRect[2] == width && viewportRect[3] == height;
+    if (skip(redundant))
+    {
+        return;
+    }
+    backend.viewport(x, y, width, height);
+    viewportRect[0] = x;
+    viewportRect[1] = y;
+    viewportRect[2] = width;
+    viewportRect[3] = height;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
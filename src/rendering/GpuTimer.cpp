@@ -0,0 +1,76 @@
+#include "rendering/GpuTimer.h"
+#include "core/OpenGL.h"
+
+namespace Penumbra {
+namespace Rendering {
+
+GpuTimer::GpuTimer()
+    : queries{}
+    , pending{}
+    , next(0)
+    , oldest(0)
+    , active(false)
+    , lastTime(0.0)
+{
+}
+
+GpuTimer::~GpuTimer()
+{
+    if (queries[0] != 0)
+    {
+        glDeleteQueries(QUERY_COUNT, queries);
+    }
+}
+
+void GpuTimer::initialize()
+{
+    glGenQueries(QUERY_COUNT, queries);
+}
+
+void GpuTimer::begin()
+{
+    if (queries[0] == 0 || pending[next])
+    {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, queries[next]);
+    active = true;
+}
+
+void GpuTimer::end()
+{
+    if (!active)
+    {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    pending[next] = true;
+    next = (next + 1) % QUERY_COUNT;
+    active = false;
+}
+
+bool GpuTimer::poll()
+{
+    // Queries finish in issue order; stop at the first one still running
+    bool updated = false;
+    while (pending[oldest])
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(queries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            break;
+        }
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[oldest], GL_QUERY_RESULT, &nanoseconds);
+        lastTime = static_cast<double>(nanoseconds) * 1e-9;
+        pending[oldest] = false;
+        oldest = (oldest + 1) % QUERY_COUNT;
+        updated = true;
+    }
+    return updated;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
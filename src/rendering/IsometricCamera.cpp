@@ -0,0 +1,186 @@
+#include "rendering/IsometricCamera.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+constexpr float MIN_ZOOM = 0.01f;
+constexpr float MIN_PITCH = 1.0f;
+constexpr float MAX_PITCH = 89.0f;
+constexpr float DEFAULT_ROTATION_SPEED = 360.0f;
+constexpr float DEFAULT_DEPTH_RANGE = 4096.0f;
+
+float wrapDegrees(float degrees)
+{
+    float wrapped = std::fmod(degrees, 360.0f);
+    return wrapped < 0.0f ? wrapped + 360.0f : wrapped;
+}
+
+} // namespace
+
+IsometricCamera::IsometricCamera()
+    : IsometricCamera(0.0f, 0.0f)
+{
+}
+
+IsometricCamera::IsometricCamera(float viewportWidth, float viewportHeight)
+    : target(0.0f, 0.0f, 0.0f)
+    , yaw(DEFAULT_YAW)
+    , targetYaw(DEFAULT_YAW)
+    , pitch(DEFAULT_PITCH)
+    , rotationSpeed(DEFAULT_ROTATION_SPEED)
+    , zoom(1.0f)
+    , depthRange(DEFAULT_DEPTH_RANGE)
+    , viewportWidth(viewportWidth)
+    , viewportHeight(viewportHeight)
+{
+}
+
+void IsometricCamera::initialize(float width, float height)
+{
+    setViewportSize(width, height);
+    zoom = 1.0f;
+}
+
+void IsometricCamera::update(float deltaTime)
+{
+    if (yaw == targetYaw)
+    {
+        return;
+    }
+
+    float remaining = targetYaw - yaw;
+    float step = rotationSpeed * deltaTime;
+    if (std::abs(remaining) <= step)
+    {
+        // Arrived: fold both back into [0, 360) so queued turns don't grow without bound
+        yaw = wrapDegrees(targetYaw);
+        targetYaw = yaw;
+    }
+    else
+    {
+        yaw += remaining > 0.0f ? step : -step;
+    }
+}
+
+void IsometricCamera::setYaw(float degrees)
+{
+    yaw = wrapDegrees(degrees);
+    targetYaw = yaw;
+}
+
+void IsometricCamera::setPitch(float degrees)
+{
+    pitch = Math::clamp(degrees, MIN_PITCH, MAX_PITCH);
+}
+
+void IsometricCamera::rotateQuarterTurn(int direction)
+{
+    if (direction > 0)
+    {
+        targetYaw += 90.0f;
+    }
+    else if (direction < 0)
+    {
+        targetYaw -= 90.0f;
+    }
+}
+
+int IsometricCamera::getQuarterTurn() const
+{
+    return static_cast<int>(wrapDegrees(targetYaw) / 90.0f) % 4;
+}
+
+void IsometricCamera::setZoom(float newZoom)
+{
+    zoom = std::max(newZoom, MIN_ZOOM);
+}
+
+void IsometricCamera::setDepthRange(float range)
+{
+    depthRange = std::max(range, 1.0f);
+}
+
+Math::Mat4 IsometricCamera::getViewMatrix() const
+{
+    // Rows grow southwards, which makes the world left-handed; build the
+    // view in a north-up frame and mirror Y on the way in so rooms keep the
+    // layout they have in 2D
+    const Math::Mat4 flipY = glm::scale(Math::Mat4(1.0f), Math::Vec3(1.0f, -1.0f, 1.0f));
+
+    float yawRadians = Math::toRadians(yaw);
+    float pitchRadians = Math::toRadians(pitch);
+    Math::Vec3 look(std::sin(yawRadians) * std::cos(pitchRadians),
+                    std::cos(yawRadians) * std::cos(pitchRadians),
+                    -std::sin(pitchRadians));
+
+    Math::Vec3 center(target.x, -target.y, target.z);
+    Math::Vec3 eye = center - look * depthRange;
+    return glm::lookAt(eye, center, Math::Vec3(0.0f, 0.0f, 1.0f)) * flipY;
+}
+
+Math::Mat4 IsometricCamera::getProjectionMatrix() const
+{
+    float halfWidth = viewportWidth * 0.5f / zoom;
+    float halfHeight = viewportHeight * 0.5f / zoom;
+    return glm::ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, 0.0f, 2.0f * depthRange);
+}
+
+Math::Vec3 IsometricCamera::getRight() const
+{
+    Math::Mat4 view = getViewMatrix();
+    return Math::Vec3(view[0][0], view[1][0], view[2][0]);
+}
+
+Math::Vec3 IsometricCamera::getDown() const
+{
+    Math::Mat4 view = getViewMatrix();
+    return -Math::Vec3(view[0][1], view[1][1], view[2][1]);
+}
+
+bool IsometricCamera::isFacing(const Math::Vec3& normal) const
+{
+    // Third row of the view rotation points from the scene back towards the camera
+    Math::Mat4 view = getViewMatrix();
+    return glm::dot(normal, Math::Vec3(view[0][2], view[1][2], view[2][2])) > 0.0f;
+}
+
+float IsometricCamera::getSortDepth(const Math::Vec3& world) const
+{
+    // View space looks down -Z, so nearer points have larger z
+    return (getViewMatrix() * Math::Vec4(world, 1.0f)).z;
+}
+
+Math::Vec2 IsometricCamera::worldToScreen(const Math::Vec3& world) const
+{
+    Math::Vec4 clip = getProjectionMatrix() * getViewMatrix() * Math::Vec4(world, 1.0f);
+    return Math::Vec2((clip.x * 0.5f + 0.5f) * viewportWidth,
+                      (0.5f - clip.y * 0.5f) * viewportHeight);
+}
+
+Math::Vec3 IsometricCamera::screenToWorld(float screenX, float screenY, float height) const
+{
+    float ndcX = viewportWidth > 0.0f ? screenX / viewportWidth * 2.0f - 1.0f : 0.0f;
+    float ndcY = viewportHeight > 0.0f ? 1.0f - screenY / viewportHeight * 2.0f : 0.0f;
+
+    Math::Mat4 inverse = glm::inverse(getProjectionMatrix() * getViewMatrix());
+    Math::Vec3 nearPoint = Math::Vec3(inverse * Math::Vec4(ndcX, ndcY, -1.0f, 1.0f));
+    Math::Vec3 farPoint = Math::Vec3(inverse * Math::Vec4(ndcX, ndcY, 1.0f, 1.0f));
+
+    // Orthographic rays are parallel; pitch is clamped above zero so they always cross the plane
+    Math::Vec3 ray = farPoint - nearPoint;
+    float t = (height - nearPoint.z) / ray.z;
+    return nearPoint + ray * t;
+}
+
+void IsometricCamera::setViewportSize(float width, float height)
+{
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
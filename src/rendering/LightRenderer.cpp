@@ -0,0 +1,180 @@
+#include "rendering/LightRenderer.h"
+#include "rendering/GLState.h"
+#include "rendering/Lighting.h"
+#include "rendering/Shaders.h"
+#include "core/OpenGL.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Half-angles at or above this light every direction
+constexpr float FULL_CONE = 3.14159f;
+
+// Fraction of a cone's half-angle faded in at its edge
+constexpr float CONE_FEATHER = 0.2f;
+
+} // namespace
+
+LightRenderer::LightRenderer()
+    : state(nullptr)
+    , lightVAO(0)
+    , lightVBO(0)
+    , fullscreenVAO(0)
+    , viewportWidth(0)
+    , viewportHeight(0)
+    , downscale(DEFAULT_DOWNSCALE)
+    , mapWidth(0)
+    , mapHeight(0)
+    , blurPasses(DEFAULT_BLUR_PASSES)
+    , drawCalls(0)
+{
+}
+
+LightRenderer::~LightRenderer()
+{
+    if (lightVAO != 0)
+    {
+        glDeleteVertexArrays(1, &lightVAO);
+    }
+    if (lightVBO != 0)
+    {
+        glDeleteBuffers(1, &lightVBO);
+    }
+    if (fullscreenVAO != 0)
+    {
+        glDeleteVertexArrays(1, &fullscreenVAO);
+    }
+}
+
+void LightRenderer::initialize(GLStateCache& stateCache, int width, int height, int mapDownscale)
+{
+    state = &stateCache;
+    downscale = std::max(mapDownscale, 1);
+
+    if (!lightShader.loadFromSource(Shaders::LIGHT_VERTEX_SHADER, Shaders::LIGHT_FRAGMENT_SHADER) ||
+        !blurShader.loadFromSource(Shaders::FULLSCREEN_VERTEX_SHADER, Shaders::BLUR_FRAGMENT_SHADER) ||
+        !compositeShader.loadFromSource(Shaders::FULLSCREEN_VERTEX_SHADER, Shaders::COPY_FRAGMENT_SHADER))
+    {
+        std::cerr << "Failed to create lighting shaders" << std::endl;
+    }
+    state->useProgram(blurShader.getID());
+    blurShader.setInt(Shaders::UNIFORM_TEXTURE, 0);
+    state->useProgram(compositeShader.getID());
+    compositeShader.setInt(Shaders::UNIFORM_TEXTURE, 0);
+
+    glGenVertexArrays(1, &lightVAO);
+    glGenBuffers(1, &lightVBO);
+    state->bindVertexArray(lightVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, lightVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Math::Vec2), nullptr);
+
+    glGenVertexArrays(1, &fullscreenVAO);
+
+    resize(width, height);
+}
+
+void LightRenderer::resize(int width, int height)
+{
+    viewportWidth = width;
+    viewportHeight = height;
+    mapWidth = std::max((viewportWidth + downscale - 1) / downscale, 1);
+    mapHeight = std::max((viewportHeight + downscale - 1) / downscale, 1);
+    for (RenderTarget& map : maps)
+    {
+        map.create(*state, mapWidth, mapHeight, RenderTargetFilter::Linear, false);
+    }
+}
+
+void LightRenderer::draw(const LightFrame& frame, unsigned int targetFramebuffer)
+{
+    drawCalls = 0;
+    if (!frame.enabled || state == nullptr)
+    {
+        return;
+    }
+
+    // Light map: ambient, plus every light's fan added on top
+    DepthMode frameDepthMode = state->getDepthMode();
+    glBindFramebuffer(GL_FRAMEBUFFER, maps[0].getFramebuffer());
+    state->setViewport(0, 0, mapWidth, mapHeight);
+    state->setDepthMode(DepthMode::Disabled);
+    glClearColor(frame.ambient.r, frame.ambient.g, frame.ambient.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!frame.lights.empty())
+    {
+        // Orphan, then fill: last frame's draw may still be reading the old storage
+        size_t bytes = frame.vertices.size() * sizeof(Math::Vec2);
+        state->bindVertexArray(lightVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, lightVBO);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), frame.vertices.data());
+
+        state->useProgram(lightShader.getID());
+        state->setBlendMode(BlendMode::Additive);
+        for (const VisibleLight& visible : frame.lights)
+        {
+            const Light& light = visible.light;
+            lightShader.setVec2(Shaders::UNIFORM_LIGHT_POSITION, light.position.x, light.position.y);
+            lightShader.setFloat(Shaders::UNIFORM_LIGHT_RADIUS, light.radius);
+            lightShader.setVec3(Shaders::UNIFORM_LIGHT_COLOR, light.color.r * light.intensity,
+                                light.color.g * light.intensity, light.color.b * light.intensity);
+            lightShader.setVec2(Shaders::UNIFORM_LIGHT_DIRECTION, light.direction.x, light.direction.y);
+            if (light.coneAngle >= FULL_CONE)
+            {
+                lightShader.setVec2(Shaders::UNIFORM_LIGHT_CONE, -2.0f, -2.0f);
+            }
+            else
+            {
+                lightShader.setVec2(Shaders::UNIFORM_LIGHT_CONE, std::cos(light.coneAngle),
+                                    std::cos(light.coneAngle * (1.0f - CONE_FEATHER)));
+            }
+            glDrawArrays(GL_TRIANGLE_FAN, static_cast<GLint>(visible.firstVertex),
+                         static_cast<GLsizei>(visible.vertexCount));
+            ++drawCalls;
+        }
+    }
+
+    // Penumbra: separable blur, ping-ponging so the result ends in map 0
+    state->setBlendMode(BlendMode::None);
+    state->useProgram(blurShader.getID());
+    for (int pass = 0; pass < blurPasses; ++pass)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, maps[1].getFramebuffer());
+        state->bindTexture(0, maps[0].getTexture());
+        blurShader.setVec2(Shaders::UNIFORM_TEXEL_STEP, 1.0f / static_cast<float>(mapWidth), 0.0f);
+        drawFullscreen();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, maps[0].getFramebuffer());
+        state->bindTexture(0, maps[1].getTexture());
+        blurShader.setVec2(Shaders::UNIFORM_TEXEL_STEP, 0.0f, 1.0f / static_cast<float>(mapHeight));
+        drawFullscreen();
+    }
+
+    // Multiply over the scene; bilinear sampling does the upscale
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    state->setViewport(0, 0, viewportWidth, viewportHeight);
+    state->setBlendMode(BlendMode::Multiply);
+    state->useProgram(compositeShader.getID());
+    state->bindTexture(0, maps[0].getTexture());
+    drawFullscreen();
+
+    state->setBlendMode(BlendMode::Premultiplied);
+    state->setDepthMode(frameDepthMode);
+}
+
+void LightRenderer::drawFullscreen()
+{
+    state->bindVertexArray(fullscreenVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    ++drawCalls;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
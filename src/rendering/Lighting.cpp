@@ -0,0 +1,371 @@
+#include "rendering/Lighting.h"
+#include "game/TileGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Angle either side of an occluder endpoint that rays are cast at, so they
+// slip past corners and find what lies behind
+constexpr float CORNER_EPSILON = 1.0e-4f;
+
+float cross(const Math::Vec2& a, const Math::Vec2& b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+bool isSolid(const Game::TileGrid& grid, int x, int y)
+{
+    return grid.getTile(x, y).isSolid();
+}
+
+} // namespace
+
+// ============================================================================
+// Light
+// ============================================================================
+
+Math::AABB Light::getBounds() const
+{
+    return Math::AABB(position - Math::Vec2(radius), position + Math::Vec2(radius));
+}
+
+// ============================================================================
+// OccluderCache
+// ============================================================================
+
+OccluderCache::OccluderCache()
+    : grid(nullptr)
+    , chunkColumns(0)
+    , chunkRows(0)
+    , revision(0)
+    , chunksRebuilt(0)
+{
+}
+
+bool OccluderCache::update(const Game::TileGrid& source)
+{
+    chunksRebuilt = 0;
+    if (grid != &source || chunkColumns != source.getChunkColumns() || chunkRows != source.getChunkRows())
+    {
+        clear();
+        grid = &source;
+        chunkColumns = source.getChunkColumns();
+        chunkRows = source.getChunkRows();
+        chunks.resize(static_cast<size_t>(chunkColumns) * static_cast<size_t>(chunkRows));
+    }
+
+    for (int chunkY = 0; chunkY < chunkRows; ++chunkY)
+    {
+        for (int chunkX = 0; chunkX < chunkColumns; ++chunkX)
+        {
+            Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                  static_cast<size_t>(chunkX)];
+            if (chunk.revision != source.getChunkRevision(chunkX, chunkY))
+            {
+                rebuildChunk(chunk, source, chunkX, chunkY);
+                ++chunksRebuilt;
+            }
+        }
+    }
+
+    if (chunksRebuilt == 0)
+    {
+        return false;
+    }
+    ++revision;
+    return true;
+}
+
+void OccluderCache::rebuildChunk(Chunk& chunk, const Game::TileGrid& source, int chunkX, int chunkY)
+{
+    const int chunkSize = Game::TileGrid::CHUNK_SIZE;
+    const float tileSize = static_cast<float>(Game::TileGrid::TILE_SIZE);
+    const int minX = chunkX * chunkSize;
+    const int minY = chunkY * chunkSize;
+    const int maxX = std::min(minX + chunkSize, source.getWidth());
+    const int maxY = std::min(minY + chunkSize, source.getHeight());
+
+    // A chunk owns the grid lines along its top and left edges and inside
+    // it; the bottom and right lines belong to the next chunk, except at
+    // the edge of the grid, where outside reads as empty
+    const int lastLineX = maxX == source.getWidth() ? maxX : maxX - 1;
+    const int lastLineY = maxY == source.getHeight() ? maxY : maxY - 1;
+
+    chunk.segments.clear();
+
+    // Horizontal lines: the edge at line y separates rows y - 1 and y
+    for (int y = minY; y <= lastLineY; ++y)
+    {
+        int runStart = -1;
+        for (int x = minX; x <= maxX; ++x)
+        {
+            bool edge = x < maxX && isSolid(source, x, y - 1) != isSolid(source, x, y);
+            if (edge && runStart < 0)
+            {
+                runStart = x;
+            }
+            else if (!edge && runStart >= 0)
+            {
+                float lineY = static_cast<float>(y) * tileSize;
+                chunk.segments.push_back({Math::Vec2(static_cast<float>(runStart) * tileSize, lineY),
+                                          Math::Vec2(static_cast<float>(x) * tileSize, lineY)});
+                runStart = -1;
+            }
+        }
+    }
+
+    // Vertical lines: the edge at line x separates columns x - 1 and x
+    for (int x = minX; x <= lastLineX; ++x)
+    {
+        int runStart = -1;
+        for (int y = minY; y <= maxY; ++y)
+        {
+            bool edge = y < maxY && isSolid(source, x - 1, y) != isSolid(source, x, y);
+            if (edge && runStart < 0)
+            {
+                runStart = y;
+            }
+            else if (!edge && runStart >= 0)
+            {
+                float lineX = static_cast<float>(x) * tileSize;
+                chunk.segments.push_back({Math::Vec2(lineX, static_cast<float>(runStart) * tileSize),
+                                          Math::Vec2(lineX, static_cast<float>(y) * tileSize)});
+                runStart = -1;
+            }
+        }
+    }
+
+    chunk.revision = source.getChunkRevision(chunkX, chunkY);
+}
+
+void OccluderCache::query(const Math::AABB& bounds, std::vector<OccluderSegment>& out) const
+{
+    if (grid == nullptr || chunks.empty())
+    {
+        return;
+    }
+
+    const float chunkWorldSize = static_cast<float>(Game::TileGrid::CHUNK_SIZE * Game::TileGrid::TILE_SIZE);
+    int minChunkX = std::max(static_cast<int>(std::floor(bounds.min.x / chunkWorldSize)), 0);
+    int minChunkY = std::max(static_cast<int>(std::floor(bounds.min.y / chunkWorldSize)), 0);
+    int maxChunkX = std::min(static_cast<int>(std::floor(bounds.max.x / chunkWorldSize)) + 1, chunkColumns);
+    int maxChunkY = std::min(static_cast<int>(std::floor(bounds.max.y / chunkWorldSize)) + 1, chunkRows);
+
+    for (int chunkY = minChunkY; chunkY < maxChunkY; ++chunkY)
+    {
+        for (int chunkX = minChunkX; chunkX < maxChunkX; ++chunkX)
+        {
+            const Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                        static_cast<size_t>(chunkX)];
+            for (const OccluderSegment& segment : chunk.segments)
+            {
+                Math::AABB segmentBounds(glm::min(segment.start, segment.end), glm::max(segment.start, segment.end));
+                if (segmentBounds.intersects(bounds))
+                {
+                    out.push_back(segment);
+                }
+            }
+        }
+    }
+}
+
+void OccluderCache::clear()
+{
+    if (!chunks.empty())
+    {
+        ++revision;
+    }
+    grid = nullptr;
+    chunkColumns = 0;
+    chunkRows = 0;
+    chunks.clear();
+}
+
+size_t OccluderCache::getSegmentCount() const
+{
+    size_t count = 0;
+    for (const Chunk& chunk : chunks)
+    {
+        count += chunk.segments.size();
+    }
+    return count;
+}
+
+// ============================================================================
+// VisibilityPolygon
+// ============================================================================
+
+void VisibilityPolygon::build(const Math::Vec2& origin, float radius, const std::vector<OccluderSegment>& occluders)
+{
+    walls.clear();
+    angles.clear();
+    points.clear();
+
+    Math::AABB bounds(origin - Math::Vec2(radius), origin + Math::Vec2(radius));
+    for (const OccluderSegment& segment : occluders)
+    {
+        Math::AABB segmentBounds(glm::min(segment.start, segment.end), glm::max(segment.start, segment.end));
+        if (segmentBounds.intersects(bounds))
+        {
+            walls.push_back(segment);
+        }
+    }
+
+    const Math::Vec2 corners[4] = {
+        bounds.min,
+        Math::Vec2(bounds.max.x, bounds.min.y),
+        bounds.max,
+        Math::Vec2(bounds.min.x, bounds.max.y)
+    };
+    for (int i = 0; i < 4; ++i)
+    {
+        walls.push_back({corners[i], corners[(i + 1) % 4]});
+    }
+
+    angles.reserve(walls.size() * 6);
+    for (const OccluderSegment& wall : walls)
+    {
+        for (const Math::Vec2& endpoint : {wall.start, wall.end})
+        {
+            float angle = std::atan2(endpoint.y - origin.y, endpoint.x - origin.x);
+            angles.push_back(angle - CORNER_EPSILON);
+            angles.push_back(angle);
+            angles.push_back(angle + CORNER_EPSILON);
+        }
+    }
+    std::sort(angles.begin(), angles.end());
+    angles.erase(std::unique(angles.begin(), angles.end()), angles.end());
+
+    // Nearest hit of each ray; the bounding square guarantees one
+    points.reserve(angles.size());
+    for (float angle : angles)
+    {
+        Math::Vec2 direction(std::cos(angle), std::sin(angle));
+        float nearest = radius * 2.0f;
+        for (const OccluderSegment& wall : walls)
+        {
+            Math::Vec2 edge = wall.end - wall.start;
+            float denominator = cross(direction, edge);
+            if (std::fabs(denominator) < 1.0e-8f)
+            {
+                continue;
+            }
+            Math::Vec2 toStart = wall.start - origin;
+            float t = cross(toStart, edge) / denominator;
+            float s = cross(toStart, direction) / denominator;
+            if (t >= 0.0f && t < nearest && s >= 0.0f && s <= 1.0f)
+            {
+                nearest = t;
+            }
+        }
+        points.push_back(origin + direction * nearest);
+    }
+}
+
+// ============================================================================
+// LightSystem
+// ============================================================================
+
+LightSystem::LightSystem()
+    : ambient(Math::Color::White)
+    , lightsCulled(0)
+    , polygonsBuilt(0)
+{
+}
+
+LightHandle LightSystem::addLight(const Light& light)
+{
+    return lights.insert(std::make_unique<Light>(light));
+}
+
+void LightSystem::removeLight(LightHandle handle)
+{
+    if (handle.index < caches.size())
+    {
+        caches[handle.index].generation = 0;
+        caches[handle.index].points.clear();
+    }
+    lights.remove(handle);
+}
+
+void LightSystem::clear()
+{
+    lights.clear();
+    caches.clear();
+}
+
+void LightSystem::update(const OccluderCache& occluders, const Math::AABB& view, LightFrame& out)
+{
+    out.clear();
+    out.enabled = true;
+    out.ambient = ambient;
+    lightsCulled = 0;
+    polygonsBuilt = 0;
+
+    lights.forEach([&](LightHandle handle, const Light& light) {
+        if (!light.getBounds().intersects(view))
+        {
+            ++lightsCulled;
+            return;
+        }
+
+        const std::vector<Math::Vec2>& outline = polygonFor(handle, light, occluders);
+        if (outline.empty())
+        {
+            return;
+        }
+
+        VisibleLight visible;
+        visible.light = light;
+        visible.firstVertex = static_cast<uint32_t>(out.vertices.size());
+        out.vertices.push_back(light.position);
+        out.vertices.insert(out.vertices.end(), outline.begin(), outline.end());
+        out.vertices.push_back(outline.front());
+        visible.vertexCount = static_cast<uint32_t>(out.vertices.size()) - visible.firstVertex;
+        out.lights.push_back(visible);
+    });
+}
+
+const std::vector<Math::Vec2>& LightSystem::polygonFor(LightHandle handle, const Light& light,
+                                                       const OccluderCache& occluders)
+{
+    if (!light.isStatic)
+    {
+        nearby.clear();
+        occluders.query(light.getBounds(), nearby);
+        visibility.build(light.position, light.radius, nearby);
+        ++polygonsBuilt;
+        return visibility.getPoints();
+    }
+
+    if (handle.index >= caches.size())
+    {
+        caches.resize(handle.index + 1, ShadowCache{0, 0, Math::Vec2(0.0f), 0.0f, {}});
+    }
+    ShadowCache& cache = caches[handle.index];
+    if (cache.generation == handle.generation && cache.occluderRevision == occluders.getRevision() &&
+        cache.position == light.position && cache.radius == light.radius)
+    {
+        return cache.points;
+    }
+
+    nearby.clear();
+    occluders.query(light.getBounds(), nearby);
+    visibility.build(light.position, light.radius, nearby);
+    ++polygonsBuilt;
+
+    cache.generation = handle.generation;
+    cache.occluderRevision = occluders.getRevision();
+    cache.position = light.position;
+    cache.radius = light.radius;
+    cache.points = visibility.getPoints();
+    return cache.points;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
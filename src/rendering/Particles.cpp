@@ -0,0 +1,464 @@
+#include "rendering/Particles.h"
+#include "rendering/SpriteCommandBuffer.h"
+#include "game/TileGrid.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define PENUMBRA_PARTICLE_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PENUMBRA_PARTICLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Streams are padded to whole groups of the widest kernel
+constexpr size_t GROUP_WIDTH = 8;
+
+uint8_t packUnorm8(float value)
+{
+    return static_cast<uint8_t>(Math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/**
+ * One-lane operations; the kernel for targets without SSE2
+ */
+struct PackScalar {
+    using F = float;
+    static constexpr int WIDTH = 1;
+
+    static F load(const float* p) { return *p; }
+    static void store(float* p, F v) { *p = v; }
+    static F set(float v) { return v; }
+    static F add(F a, F b) { return a + b; }
+    static F sub(F a, F b) { return a - b; }
+    static F mul(F a, F b) { return a * b; }
+    static F min(F a, F b) { return a < b ? a : b; }
+    static F max(F a, F b) { return a > b ? a : b; }
+};
+
+#ifdef PENUMBRA_PARTICLE_SSE2
+
+struct PackSse2 {
+    using F = __m128;
+    static constexpr int WIDTH = 4;
+
+    static F load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static F set(float v) { return _mm_set1_ps(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+};
+
+#endif
+
+#ifdef PENUMBRA_PARTICLE_AVX2
+
+struct PackAvx2 {
+    using F = __m256;
+    static constexpr int WIDTH = 8;
+
+    static F load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static F set(float v) { return _mm256_set1_ps(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+};
+
+using ParticleKernel = PackAvx2;
+constexpr const char* PARTICLE_KERNEL_NAME = "AVX2";
+
+#elif defined(PENUMBRA_PARTICLE_SSE2)
+
+using ParticleKernel = PackSse2;
+constexpr const char* PARTICLE_KERNEL_NAME = "SSE2";
+
+#else
+
+using ParticleKernel = PackScalar;
+constexpr const char* PARTICLE_KERNEL_NAME = "scalar";
+
+#endif
+
+/**
+ * Per-update constants shared by every lane
+ */
+struct Integration {
+    float deltaTime;
+    float accelerationX;  // Acceleration * deltaTime
+    float accelerationY;
+    float damping;        // Velocity scale for this step
+    float startSize;
+    float sizeRange;      // End - start
+    float startColor[4];
+    float colorRange[4];
+};
+
+/**
+ * Integrate groupCount * P::WIDTH particles in place
+ * Padding lanes past the live count are integrated too; they are never read
+ */
+template <class P>
+void integrate(float* positionX, float* positionY, float* velocityX, float* velocityY,
+               float* life, const float* inverseLifetime, float* size, float* const color[4],
+               size_t groupCount, const Integration& step)
+{
+    using F = typename P::F;
+
+    const F deltaTime = P::set(step.deltaTime);
+    const F accelerationX = P::set(step.accelerationX);
+    const F accelerationY = P::set(step.accelerationY);
+    const F damping = P::set(step.damping);
+    const F zero = P::set(0.0f);
+    const F one = P::set(1.0f);
+    const F startSize = P::set(step.startSize);
+    const F sizeRange = P::set(step.sizeRange);
+    F startColor[4];
+    F colorRange[4];
+    for (int c = 0; c < 4; ++c)
+    {
+        startColor[c] = P::set(step.startColor[c]);
+        colorRange[c] = P::set(step.colorRange[c]);
+    }
+
+    const size_t end = groupCount * P::WIDTH;
+    for (size_t i = 0; i < end; i += P::WIDTH)
+    {
+        F vx = P::mul(P::add(P::load(velocityX + i), accelerationX), damping);
+        F vy = P::mul(P::add(P::load(velocityY + i), accelerationY), damping);
+        P::store(velocityX + i, vx);
+        P::store(velocityY + i, vy);
+        P::store(positionX + i, P::add(P::load(positionX + i), P::mul(vx, deltaTime)));
+        P::store(positionY + i, P::add(P::load(positionY + i), P::mul(vy, deltaTime)));
+
+        // Age as 0 at birth to 1 at death
+        F remaining = P::sub(P::load(life + i), deltaTime);
+        P::store(life + i, remaining);
+        F age = P::min(P::max(P::sub(one, P::mul(remaining, P::load(inverseLifetime + i))), zero), one);
+
+        P::store(size + i, P::add(startSize, P::mul(sizeRange, age)));
+        for (int c = 0; c < 4; ++c)
+        {
+            P::store(color[c] + i, P::add(startColor[c], P::mul(colorRange[c], age)));
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// SolidTileMask
+// ============================================================================
+
+SolidTileMask::SolidTileMask()
+    : grid(nullptr)
+    , width(0)
+    , height(0)
+    , chunkColumns(0)
+    , chunkRows(0)
+    , inverseTileSize(1.0f / static_cast<float>(Game::TileGrid::TILE_SIZE))
+{
+}
+
+void SolidTileMask::update(const Game::TileGrid& source)
+{
+    if (grid != &source || width != source.getWidth() || height != source.getHeight())
+    {
+        grid = &source;
+        width = source.getWidth();
+        height = source.getHeight();
+        chunkColumns = source.getChunkColumns();
+        chunkRows = source.getChunkRows();
+        chunkRevisions.assign(static_cast<size_t>(chunkColumns) * static_cast<size_t>(chunkRows), 0);
+        cells.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+    }
+
+    const int chunkSize = Game::TileGrid::CHUNK_SIZE;
+    for (int chunkY = 0; chunkY < chunkRows; ++chunkY)
+    {
+        for (int chunkX = 0; chunkX < chunkColumns; ++chunkX)
+        {
+            uint32_t& revision = chunkRevisions[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                                static_cast<size_t>(chunkX)];
+            if (revision == source.getChunkRevision(chunkX, chunkY))
+            {
+                continue;
+            }
+            revision = source.getChunkRevision(chunkX, chunkY);
+
+            const int minX = chunkX * chunkSize;
+            const int maxX = std::min(minX + chunkSize, width);
+            const int maxY = std::min((chunkY + 1) * chunkSize, height);
+            for (int y = chunkY * chunkSize; y < maxY; ++y)
+            {
+                const Game::Tile* row = source.getRow(y);
+                uint8_t* out = cells.data() + static_cast<size_t>(y) * static_cast<size_t>(width);
+                for (int x = minX; x < maxX; ++x)
+                {
+                    out[x] = row[x].isSolid() ? 1 : 0;
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// ParticlePool
+// ============================================================================
+
+ParticlePool::ParticlePool(const ParticleType& particleType)
+    : type(particleType)
+    , count(0)
+    , stride((particleType.capacity + GROUP_WIDTH - 1) / GROUP_WIDTH * GROUP_WIDTH)
+    , streams(stride * STREAM_COUNT, 0.0f)
+    , randomState(0x9E3779B9u)
+{
+}
+
+float ParticlePool::random()
+{
+    // xorshift32: emission only needs cheap, decorrelated noise
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<float>(randomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+size_t ParticlePool::emit(const Math::Vec2& position, size_t requested)
+{
+    size_t spawned = std::min(requested, type.capacity - count);
+    for (size_t i = count; i < count + spawned; ++i)
+    {
+        float lifetime = std::max(type.lifetime * (1.0f + type.lifetimeVariance * random()), 0.001f);
+        float angle = type.angle + type.spread * random();
+        float speed = type.speed * (1.0f + type.speedVariance * random());
+
+        stream(POSITION_X)[i] = position.x;
+        stream(POSITION_Y)[i] = position.y;
+        stream(VELOCITY_X)[i] = std::cos(angle) * speed;
+        stream(VELOCITY_Y)[i] = std::sin(angle) * speed;
+        stream(LIFE)[i] = lifetime;
+        stream(INVERSE_LIFETIME)[i] = 1.0f / lifetime;
+        stream(SIZE)[i] = type.startSize;
+        stream(COLOR_R)[i] = type.startColor.r;
+        stream(COLOR_G)[i] = type.startColor.g;
+        stream(COLOR_B)[i] = type.startColor.b;
+        stream(COLOR_A)[i] = type.startColor.a;
+    }
+    count += spawned;
+    return spawned;
+}
+
+void ParticlePool::update(float deltaTime, const SolidTileMask* tiles)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    Integration step;
+    step.deltaTime = deltaTime;
+    step.accelerationX = type.acceleration.x * deltaTime;
+    step.accelerationY = type.acceleration.y * deltaTime;
+    step.damping = std::max(1.0f - type.drag * deltaTime, 0.0f);
+    step.startSize = type.startSize;
+    step.sizeRange = type.endSize - type.startSize;
+    const Math::Color& start = type.startColor;
+    const Math::Color& end = type.endColor;
+    step.startColor[0] = start.r;
+    step.startColor[1] = start.g;
+    step.startColor[2] = start.b;
+    step.startColor[3] = start.a;
+    step.colorRange[0] = end.r - start.r;
+    step.colorRange[1] = end.g - start.g;
+    step.colorRange[2] = end.b - start.b;
+    step.colorRange[3] = end.a - start.a;
+
+    float* const color[4] = {stream(COLOR_R), stream(COLOR_G), stream(COLOR_B), stream(COLOR_A)};
+    size_t groups = (count + GROUP_WIDTH - 1) / GROUP_WIDTH * (GROUP_WIDTH / ParticleKernel::WIDTH);
+    integrate<ParticleKernel>(stream(POSITION_X), stream(POSITION_Y), stream(VELOCITY_X), stream(VELOCITY_Y),
+                              stream(LIFE), stream(INVERSE_LIFETIME), stream(SIZE), color, groups, step);
+
+    // Swap-compact: the last live particle fills each dead slot
+    const float* life = stream(LIFE);
+    const bool colliding = type.collide && tiles != nullptr;
+    size_t i = 0;
+    while (i < count)
+    {
+        if (life[i] <= 0.0f)
+        {
+            --count;
+            if (i != count)
+            {
+                for (size_t s = 0; s < STREAM_COUNT; ++s)
+                {
+                    streams[s * stride + i] = streams[s * stride + count];
+                }
+            }
+            continue;
+        }
+        if (colliding)
+        {
+            collide(i, deltaTime, *tiles);
+        }
+        ++i;
+    }
+}
+
+void ParticlePool::collide(size_t index, float deltaTime, const SolidTileMask& tiles)
+{
+    float* positionX = stream(POSITION_X);
+    float* positionY = stream(POSITION_Y);
+    float x = positionX[index];
+    float y = positionY[index];
+    if (!tiles.isSolidAt(x, y))
+    {
+        return;
+    }
+
+    // Step back along each axis to find which one crossed into the tile
+    float* velocityX = stream(VELOCITY_X);
+    float* velocityY = stream(VELOCITY_Y);
+    float previousX = x - velocityX[index] * deltaTime;
+    float previousY = y - velocityY[index] * deltaTime;
+    bool hitX = tiles.isSolidAt(x, previousY);
+    bool hitY = tiles.isSolidAt(previousX, y);
+    if (!hitX && !hitY)
+    {
+        hitX = true;
+        hitY = true;
+    }
+    if (hitX)
+    {
+        positionX[index] = previousX;
+        velocityX[index] *= -type.bounce;
+    }
+    if (hitY)
+    {
+        positionY[index] = previousY;
+        velocityY[index] *= -type.bounce;
+    }
+}
+
+void ParticlePool::draw(SpriteCommandBuffer& buffer) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+    buffer.setTexture(type.texture);
+
+    const float* positionX = stream(POSITION_X);
+    const float* positionY = stream(POSITION_Y);
+    const float* size = stream(SIZE);
+    const float* red = stream(COLOR_R);
+    const float* green = stream(COLOR_G);
+    const float* blue = stream(COLOR_B);
+    const float* alpha = stream(COLOR_A);
+
+    Sprite sprite;
+    sprite.textureRect = type.textureRect;
+    sprite.layer = type.layer;
+
+    if (buffer.getMode() != SpriteBatchMode::Instanced)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            sprite.position = Math::Vec2(positionX[i], positionY[i]);
+            sprite.size = Math::Vec2(size[i], size[i]);
+            sprite.color = Math::Color(red[i], green[i], blue[i], alpha[i]);
+            buffer.draw(sprite);
+        }
+        return;
+    }
+
+    // Only position, size and color vary; the rest comes from one template record
+    SpriteInstance base;
+    writeSpriteInstance(sprite, 0, SpriteAxes(), &base);
+    SpriteInstance* out = buffer.drawInstances(count, type.layer);
+    for (size_t i = 0; i < count; ++i)
+    {
+        SpriteInstance instance = base;
+        instance.x = positionX[i];
+        instance.y = positionY[i];
+        instance.width = size[i];
+        instance.height = size[i];
+        instance.r = packUnorm8(red[i] * alpha[i]);
+        instance.g = packUnorm8(green[i] * alpha[i]);
+        instance.b = packUnorm8(blue[i] * alpha[i]);
+        instance.a = packUnorm8(alpha[i]);
+        out[i] = instance;
+    }
+}
+
+const char* getParticleKernelName()
+{
+    return PARTICLE_KERNEL_NAME;
+}
+
+// ============================================================================
+// ParticleSystem
+// ============================================================================
+
+size_t ParticleSystem::addType(const ParticleType& type)
+{
+    pools.push_back(std::make_unique<ParticlePool>(type));
+    return pools.size() - 1;
+}
+
+size_t ParticleSystem::emit(size_t type, const Math::Vec2& position, size_t count)
+{
+    return pools[type]->emit(position, count);
+}
+
+void ParticleSystem::update(float deltaTime, const Game::TileGrid* grid)
+{
+    if (grid != nullptr)
+    {
+        tiles.update(*grid);
+    }
+    for (const std::unique_ptr<ParticlePool>& pool : pools)
+    {
+        pool->update(deltaTime, grid != nullptr ? &tiles : nullptr);
+    }
+}
+
+void ParticleSystem::draw(SpriteCommandBuffer& buffer) const
+{
+    for (const std::unique_ptr<ParticlePool>& pool : pools)
+    {
+        pool->draw(buffer);
+    }
+}
+
+void ParticleSystem::clear()
+{
+    for (const std::unique_ptr<ParticlePool>& pool : pools)
+    {
+        pool->clear();
+    }
+}
+
+size_t ParticleSystem::getParticleCount() const
+{
+    size_t total = 0;
+    for (const std::unique_ptr<ParticlePool>& pool : pools)
+    {
+        total += pool->getCount();
+    }
+    return total;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
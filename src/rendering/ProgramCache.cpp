@@ -0,0 +1,179 @@
+#include "rendering/ProgramCache.h"
+#include "rendering/GLState.h"
+#include "core/CookedAssets.h"
+#include "core/OpenGL.h"
+#include "core/Platform.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+constexpr uint32_t PROGRAM_BINARY_MAGIC = 0x4E494250;  // "PBIN"
+
+// Far above any real driver blob; a larger length means a corrupt entry
+constexpr uint32_t MAX_PROGRAM_BINARY_LENGTH = 64u * 1024u * 1024u;
+
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t binaryFormat;
+    uint32_t length;
+};
+
+std::string glString(GLenum name)
+{
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+} // namespace
+
+ProgramCache::ProgramCache()
+    : driverHash(0)
+    , supported(false)
+    , stats{0, 0, 0, 0}
+{
+}
+
+ProgramCache& ProgramCache::getInstance()
+{
+    static ProgramCache instance;
+    return instance;
+}
+
+void ProgramCache::initialize(const std::string& cacheDirectory)
+{
+    directory = cacheDirectory;
+    stats = Stats{0, 0, 0, 0};
+
+    // Any driver change (vendor, GPU, version string) must miss
+    std::string driver = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+    driverHash = Assets::hashContent(driver.data(), driver.size());
+
+    bool available = hasGLVersion(4, 1) || hasGLExtension("GL_ARB_get_program_binary");
+
+    // Some drivers expose the entry points but support zero binary formats
+    GLint formatCount = 0;
+    if (available)
+    {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+
+    supported = formatCount > 0 && Platform::FileSystem::createDirectory(directory);
+    std::cout << "Program binary cache: "
+              << (supported ? directory : std::string("unsupported by driver")) << std::endl;
+}
+
+uint64_t ProgramCache::makeKey(const std::string& vertexSource, const std::string& fragmentSource) const
+{
+    uint64_t key = Assets::hashContent(vertexSource.data(), vertexSource.size(), driverHash);
+    // Separator keeps ("ab", "c") and ("a", "bc") apart
+    const char separator = '\0';
+    key = Assets::hashContent(&separator, 1, key);
+    return Assets::hashContent(fragmentSource.data(), fragmentSource.size(), key);
+}
+
+bool ProgramCache::load(uint64_t key, unsigned int& outProgramID)
+{
+    if (!supported)
+    {
+        return false;
+    }
+
+    std::string path = getEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    EntryHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != PROGRAM_BINARY_MAGIC)
+    {
+        ++stats.misses;
+        return false;
+    }
+
+    // The length must match what's actually left in the file before
+    // anything is allocated for it; a truncated entry is just a miss
+    std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - start;
+    file.seekg(start);
+    if (header.length == 0 || header.length > MAX_PROGRAM_BINARY_LENGTH ||
+        remaining != static_cast<std::streamoff>(header.length))
+    {
+        ++stats.misses;
+        return false;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+    {
+        ++stats.misses;
+        return false;
+    }
+    file.close();
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        // Driver rejected the blob (format or driver change): drop it and rebuild from source
+        glDeleteProgram(program);
+        std::remove(path.c_str());
+        ++stats.rejected;
+        ++stats.misses;
+        return false;
+    }
+
+    outProgramID = program;
+    ++stats.hits;
+    return true;
+}
+
+void ProgramCache::store(uint64_t key, unsigned int programID)
+{
+    if (!supported)
+    {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(programID, length, &written, &binaryFormat, binary.data());
+    if (written <= 0)
+    {
+        return;
+    }
+
+    EntryHeader header{PROGRAM_BINARY_MAGIC, binaryFormat, static_cast<uint32_t>(written)};
+    std::ofstream file(getEntryPath(key), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), written);
+    if (file)
+    {
+        ++stats.stored;
+    }
+}
+
+std::string ProgramCache::getEntryPath(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return Platform::FileSystem::joinPath(directory, name);
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,84 @@
+#include "rendering/RenderTarget.h"
+#include "rendering/GLState.h"
+#include "core/OpenGL.h"
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+RenderTarget::RenderTarget()
+    : state(nullptr)
+    , framebuffer(0)
+    , texture(0)
+    , depthBuffer(0)
+    , width(0)
+    , height(0)
+{
+}
+
+RenderTarget::~RenderTarget()
+{
+    release();
+}
+
+bool RenderTarget::create(GLStateCache& stateCache, int targetWidth, int targetHeight,
+                          RenderTargetFilter filter, bool depth)
+{
+    release();
+    state = &stateCache;
+    width = std::max(targetWidth, 1);
+    height = std::max(targetHeight, 1);
+
+    GLint sampling = filter == RenderTargetFilter::Linear ? GL_LINEAR : GL_NEAREST;
+    glGenTextures(1, &texture);
+    state->bindTexture(0, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampling);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampling);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+    if (depth)
+    {
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    }
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete)
+    {
+        std::cerr << "RenderTarget: " << width << "x" << height << " framebuffer incomplete" << std::endl;
+        release();
+    }
+    return complete;
+}
+
+void RenderTarget::release()
+{
+    if (depthBuffer != 0)
+    {
+        glDeleteRenderbuffers(1, &depthBuffer);
+        depthBuffer = 0;
+    }
+    if (framebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (texture != 0)
+    {
+        glDeleteTextures(1, &texture);
+        state->forgetTexture(texture);
+        texture = 0;
+    }
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,249 @@
+#include "rendering/RenderThread.h"
+#include "rendering/Renderer.h"
+#include "core/Resources.h"
+#include <algorithm>
+
+namespace Penumbra {
+namespace Rendering {
+
+RenderThread::RenderThread(Renderer& renderer, const Hooks& hooks, size_t recordingThreads)
+    : renderer(renderer)
+    , hooks(hooks)
+    , writeIndex(0)
+    , frameNumber(0)
+    , threaded(false)
+    , pendingIndex(NO_PACKET)
+    , renderingIndex(NO_PACKET)
+    , task(nullptr)
+    , stopping(false)
+    , framesPresented(0)
+{
+    for (FramePacket& packet : packets)
+    {
+        packet.sprites.resize(std::max<size_t>(recordingThreads, 1));
+    }
+}
+
+RenderThread::~RenderThread()
+{
+    setThreaded(false);
+}
+
+void RenderThread::setThreaded(bool enable)
+{
+    if (enable == threaded)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        hooks.bindContext(false);
+        stopping = false;
+        threaded = true;
+        thread = std::thread(&RenderThread::threadLoop, this);
+        return;
+    }
+
+    // The thread presents anything still pending before it exits
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+    threaded = false;
+    hooks.bindContext(true);
+}
+
+FramePacket& RenderThread::beginFrame(const Camera& camera)
+{
+    FramePacket& packet = acquirePacket();
+    packet.isometric = false;
+    packet.camera = camera;
+
+    SpriteAxes axes = SpriteBatch::axesFor(camera);
+    for (SpriteCommandBuffer& buffer : packet.sprites)
+    {
+        buffer.begin(renderer.getSpriteBatch().getMode(), axes, renderer.getDefaultShader());
+    }
+    packet.overlay.begin(renderer.getSpriteBatch().getMode(), SpriteAxes(), renderer.getDefaultShader());
+    return packet;
+}
+
+FramePacket& RenderThread::beginFrame(const IsometricCamera& camera)
+{
+    FramePacket& packet = acquirePacket();
+    packet.isometric = true;
+    packet.isometricCamera = camera;
+
+    SpriteAxes axes = SpriteBatch::axesFor(camera);
+    for (SpriteCommandBuffer& buffer : packet.sprites)
+    {
+        buffer.begin(renderer.getSpriteBatch().getMode(), axes, renderer.getDefaultShader());
+    }
+    packet.overlay.begin(renderer.getSpriteBatch().getMode(), SpriteAxes(), renderer.getDefaultShader());
+    return packet;
+}
+
+FramePacket& RenderThread::acquirePacket()
+{
+    if (threaded)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return renderingIndex != writeIndex; });
+    }
+
+    FramePacket& packet = packets[writeIndex];
+    packet.frameNumber = frameNumber++;
+    return packet;
+}
+
+void RenderThread::submitFrame()
+{
+    FramePacket& packet = packets[writeIndex];
+    if (packet.debug)
+    {
+        packet.debugDraw = debugDraw;
+    }
+    debugDraw.endFrame();
+
+    if (!threaded)
+    {
+        renderPacket(packet);
+        presentPacket(packet);
+        ++framesPresented;
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return pendingIndex == NO_PACKET; });
+        pendingIndex = writeIndex;
+    }
+    changed.notify_all();
+    writeIndex ^= 1;
+}
+
+void RenderThread::runWithContext(const std::function<void()>& work)
+{
+    if (!threaded)
+    {
+        work();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return task == nullptr; });
+    task = &work;
+    changed.notify_all();
+    changed.wait(lock, [this, &work] { return task != &work; });
+}
+
+void RenderThread::waitIdle()
+{
+    if (!threaded)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return pendingIndex == NO_PACKET && renderingIndex == NO_PACKET; });
+}
+
+uint64_t RenderThread::getFramesPresented() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return framesPresented;
+}
+
+void RenderThread::threadLoop()
+{
+    hooks.bindContext(true);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        changed.wait(lock, [this] { return stopping || pendingIndex != NO_PACKET || task != nullptr; });
+
+        if (task != nullptr)
+        {
+            const std::function<void()>* work = task;
+            lock.unlock();
+            (*work)();
+            lock.lock();
+            task = nullptr;
+            changed.notify_all();
+            continue;
+        }
+
+        if (pendingIndex != NO_PACKET)
+        {
+            renderingIndex = pendingIndex;
+            pendingIndex = NO_PACKET;
+            changed.notify_all();
+
+            lock.unlock();
+            renderPacket(packets[renderingIndex]);
+            presentPacket(packets[renderingIndex]);
+            lock.lock();
+
+            renderingIndex = NO_PACKET;
+            ++framesPresented;
+            changed.notify_all();
+            continue;
+        }
+
+        break;
+    }
+    lock.unlock();
+
+    hooks.bindContext(false);
+}
+
+void RenderThread::renderPacket(const FramePacket& packet)
+{
+    // Textures the simulation thread unloaded; no packet still in flight uses them
+    Resources::ResourceManager::getInstance().releaseRetiredTextures();
+
+    renderer.setClearColor(packet.clearColor);
+    if (packet.isometric)
+    {
+        renderer.beginFrame(packet.isometricCamera);
+    }
+    else
+    {
+        renderer.beginFrame(packet.camera);
+    }
+
+    SpriteBatch& batch = renderer.getSpriteBatch();
+    for (const SpriteCommandBuffer& buffer : packet.sprites)
+    {
+        batch.submit(buffer);
+    }
+    if (packet.lighting.enabled && !packet.isometric)
+    {
+        renderer.drawLighting(packet.lighting);
+    }
+    if (packet.debug)
+    {
+        renderer.drawDebug(packet.debugDraw);
+    }
+
+    renderer.setPostSettings(packet.post);
+    renderer.beginOverlay();
+    batch.submit(packet.overlay);
+    renderer.endFrame();
+}
+
+void RenderThread::presentPacket(const FramePacket& packet)
+{
+    hooks.present();
+    if (hooks.presented)
+    {
+        hooks.presented(packet);
+    }
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,1004 @@
+#include "rendering/Renderer.h"
+#include "rendering/Camera.h"
+#include "rendering/IsometricCamera.h"
+#include "rendering/Lighting.h"
+#include "rendering/Shaders.h"
+#include "core/OpenGL.h"
+#include "core/Platform.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Half-covered texels are the usual edge of cut-out pixel art
+constexpr float DEFAULT_ALPHA_CUTOFF = 0.5f;
+
+// Smallest batch worth opening; a shorter tail of a stream segment is skipped
+constexpr size_t MIN_BATCH_SPRITES = 64;
+
+} // namespace
+
+// ============================================================================
+// SpriteBatch
+// ============================================================================
+
+SpriteBatch::SpriteBatch()
+    : VAO(0)
+    , EBO(0)
+    , mode(SpriteBatchMode::Vertices)
+    , writeTarget(nullptr)
+    , recordSize(4 * sizeof(SpriteVertex))
+    , batchCapacity(0)
+    , state(nullptr)
+    , maxSprites(0)
+    , spriteCount(0)
+    , drawCalls(0)
+    , spritesDrawn(0)
+    , currentTextureSlot(0)
+    , currentShaderSlot(0)
+    , currentShader(nullptr)
+    , currentTexture(nullptr)
+    , batchShader(nullptr)
+    , viewProjection(1.0f)
+{
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    if (VAO != 0)
+    {
+        glDeleteVertexArrays(1, &VAO);
+    }
+    if (EBO != 0)
+    {
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+void SpriteBatch::initialize(GLStateCache& stateCache, size_t spriteCapacity, SpriteBatchMode batchMode)
+{
+    state = &stateCache;
+    mode = batchMode;
+    recordSize = mode == SpriteBatchMode::Instanced ? sizeof(SpriteInstance) : 4 * sizeof(SpriteVertex);
+
+    // Instances are drawn without indices, so only the vertex path is bounded
+    maxSprites = mode == SpriteBatchMode::Instanced ? spriteCapacity
+                                                    : std::min(spriteCapacity, MAX_BATCH_SPRITES);
+    if (maxSprites < spriteCapacity)
+    {
+        std::cerr << "SpriteBatch: " << spriteCapacity << " sprites exceeds 16-bit indices, clamped to "
+                  << maxSprites << std::endl;
+    }
+
+    batchTextures.reserve(Shaders::MAX_TEXTURE_SLOTS);
+    queued.reserve(maxSprites);
+    pendingSprites.reserve(maxSprites);
+    pendingSlots.reserve(maxSprites);
+    commands.reserve(maxSprites);
+
+    setupBuffers();
+    resetQueue();
+}
+
+void SpriteBatch::setupBuffers()
+{
+    glGenVertexArrays(1, &VAO);
+
+    if (mode == SpriteBatchMode::Instanced)
+    {
+        vertexStream.initialize(GL_ARRAY_BUFFER, maxSprites * sizeof(SpriteInstance), sizeof(SpriteInstance));
+
+        state->bindVertexArray(VAO);
+        for (GLuint location = 0; location < 6; ++location)
+        {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+        setInstanceAttributes(0);
+        state->bindVertexArray(0);
+        return;
+    }
+
+    // One segment holds a full batch; offsets stay vertex-aligned for base vertex draws
+    vertexStream.initialize(GL_ARRAY_BUFFER, maxSprites * 4 * sizeof(SpriteVertex), sizeof(SpriteVertex));
+
+    // Quad indices never change: generate once, upload, and drop the CPU copy
+    std::vector<uint16_t> indices(maxSprites * 6);
+    for (size_t i = 0; i < maxSprites; ++i)
+    {
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = static_cast<uint16_t>(base + 1);
+        indices[i * 6 + 2] = static_cast<uint16_t>(base + 2);
+        indices[i * 6 + 3] = static_cast<uint16_t>(base + 2);
+        indices[i * 6 + 4] = static_cast<uint16_t>(base + 3);
+        indices[i * 6 + 5] = base;
+    }
+
+    glGenBuffers(1, &EBO);
+
+    state->bindVertexArray(VAO);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint16_t)),
+                 indices.data(), GL_STATIC_DRAW);
+
+    // Attribute formats expand the packed fields back to the shader's float inputs
+    glBindBuffer(GL_ARRAY_BUFFER, vertexStream.getID());
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
+                          reinterpret_cast<void*>(offsetof(SpriteVertex, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(SpriteVertex),
+                          reinterpret_cast<void*>(offsetof(SpriteVertex, u)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteVertex),
+                          reinterpret_cast<void*>(offsetof(SpriteVertex, r)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(SpriteVertex),
+                           reinterpret_cast<void*>(offsetof(SpriteVertex, textureSlot)));
+
+    state->bindVertexArray(0);
+}
+
+void SpriteBatch::setInstanceAttributes(size_t offset)
+{
+    // GL 3.3 has no base instance, so each batch re-points the attributes at its ring offset
+    auto at = [offset](size_t member) { return reinterpret_cast<void*>(offset + member); };
+    const GLsizei stride = sizeof(SpriteInstance);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexStream.getID());
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, at(offsetof(SpriteInstance, width)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_SHORT, GL_TRUE, stride, at(offsetof(SpriteInstance, u0)));
+    glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, at(offsetof(SpriteInstance, originX)));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, at(offsetof(SpriteInstance, r)));
+    glVertexAttribIPointer(5, 1, GL_UNSIGNED_BYTE, stride, at(offsetof(SpriteInstance, textureSlot)));
+}
+
+void SpriteBatch::begin(const Camera& camera, Resources::Shader* shader, Resources::Texture* texture)
+{
+    viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
+    axes = axesFor(camera);
+    beginBatch(shader, texture);
+}
+
+void SpriteBatch::begin(const IsometricCamera& camera, Resources::Shader* shader, Resources::Texture* texture)
+{
+    viewProjection = camera.getProjectionMatrix() * camera.getViewMatrix();
+    axes = axesFor(camera);
+    beginBatch(shader, texture);
+}
+
+SpriteAxes SpriteBatch::axesFor(const Camera&)
+{
+    return SpriteAxes();
+}
+
+SpriteAxes SpriteBatch::axesFor(const IsometricCamera& camera)
+{
+    SpriteAxes isometric;
+    isometric.billboard = true;
+    isometric.right = camera.getRight();
+    isometric.down = camera.getDown();
+    return isometric;
+}
+
+void SpriteBatch::beginBatch(Resources::Shader* shader, Resources::Texture* texture)
+{
+    spriteCount = 0;
+    drawCalls = 0;
+    spritesDrawn = 0;
+
+    currentShader = shader;
+    currentTexture = texture;
+    resetQueue();
+}
+
+void SpriteBatch::resetQueue()
+{
+    queued.clear();
+    submittedRecords.clear();
+    commands.clear();
+    textureSlots.clear();
+    shaderSlots.clear();
+
+    // Slot tables only live for one flush; re-register the current state
+    textureSlots.push_back(currentTexture);
+    shaderSlots.push_back(currentShader);
+    currentTextureSlot = 0;
+    currentShaderSlot = 0;
+}
+
+void SpriteBatch::setTexture(Resources::Texture* texture)
+{
+    if (texture == currentTexture)
+    {
+        return;
+    }
+
+    currentTextureSlot = textureSlotFor(texture);
+    currentTexture = texture;
+}
+
+uint32_t SpriteBatch::textureSlotFor(Resources::Texture* texture)
+{
+    auto it = std::find(textureSlots.begin(), textureSlots.end(), texture);
+    if (it == textureSlots.end() && textureSlots.size() > 0xFFFF)
+    {
+        // Key field is full; sort and draw what we have
+        flush();
+        it = std::find(textureSlots.begin(), textureSlots.end(), texture);
+    }
+    if (it == textureSlots.end())
+    {
+        it = textureSlots.insert(textureSlots.end(), texture);
+    }
+    return static_cast<uint32_t>(it - textureSlots.begin());
+}
+
+void SpriteBatch::setShader(Resources::Shader* shader)
+{
+    if (shader == currentShader)
+    {
+        return;
+    }
+
+    currentShaderSlot = shaderSlotFor(shader);
+    currentShader = shader;
+}
+
+uint32_t SpriteBatch::shaderSlotFor(Resources::Shader* shader)
+{
+    auto it = std::find(shaderSlots.begin(), shaderSlots.end(), shader);
+    if (it == shaderSlots.end() && shaderSlots.size() > 0xFF)
+    {
+        flush();
+        it = std::find(shaderSlots.begin(), shaderSlots.end(), shader);
+    }
+    if (it == shaderSlots.end())
+    {
+        it = shaderSlots.insert(shaderSlots.end(), shader);
+    }
+    return static_cast<uint32_t>(it - shaderSlots.begin());
+}
+
+void SpriteBatch::draw(const Sprite& sprite)
+{
+    uint64_t key = makeSortKey(sprite.layer, sprite.depth, currentTextureSlot, currentShaderSlot);
+    commands.push_back({key, static_cast<uint32_t>(queued.size())});
+    queued.push_back(sprite);
+}
+
+void SpriteBatch::draw(const Math::Vec2& position,
+                       const Math::Vec2& size,
+                       const Math::Color& color,
+                       float rotation)
+{
+    Sprite sprite;
+    sprite.position = position;
+    sprite.size = size;
+    sprite.color = color;
+    sprite.rotation = rotation;
+    draw(sprite);
+}
+
+void SpriteBatch::draw(const Math::Vec2& position,
+                       const Math::Vec2& size,
+                       const Math::Rect& textureRect,
+                       const Math::Color& color,
+                       float rotation)
+{
+    Sprite sprite;
+    sprite.position = position;
+    sprite.size = size;
+    sprite.textureRect = textureRect;
+    sprite.color = color;
+    sprite.rotation = rotation;
+    draw(sprite);
+}
+
+void SpriteBatch::submit(const SpriteCommandBuffer& buffer)
+{
+    if (buffer.getSpriteCount() == 0)
+    {
+        return;
+    }
+    if (buffer.getMode() != mode)
+    {
+        std::cerr << "SpriteBatch: command buffer recorded for another batch mode, skipped" << std::endl;
+        return;
+    }
+
+    // Flush up front if the buffer's slots might not fit, so no flush can
+    // land between remapping and queueing
+    const std::vector<Resources::Texture*>& textures = buffer.getTextures();
+    const std::vector<Resources::Shader*>& shaders = buffer.getShaders();
+    if (textureSlots.size() + textures.size() > 0x10000 || shaderSlots.size() + shaders.size() > 0x100)
+    {
+        flush();
+    }
+
+    // Buffer slots -> batch slots; textures first, shaders after them
+    slotRemap.clear();
+    for (Resources::Texture* texture : textures)
+    {
+        slotRemap.push_back(textureSlotFor(texture));
+    }
+    for (Resources::Shader* shader : shaders)
+    {
+        slotRemap.push_back(shaderSlotFor(shader));
+    }
+    const uint32_t* textureRemap = slotRemap.data();
+    const uint32_t* shaderRemap = slotRemap.data() + textures.size();
+
+    for (const DrawCommand& command : buffer.getCommands())
+    {
+        // Layer and depth carry over; only the slot fields are rewritten
+        uint64_t key = (command.key & ~uint64_t(0xFFFFFF)) |
+                       (static_cast<uint64_t>(textureRemap[(command.key >> 8) & 0xFFFF]) << 8) |
+                       static_cast<uint64_t>(shaderRemap[command.key & 0xFF]);
+        commands.push_back({key, SUBMITTED_RECORD | static_cast<uint32_t>(submittedRecords.size())});
+        submittedRecords.push_back(buffer.getRecord(command.index));
+    }
+}
+
+void SpriteBatch::end()
+{
+    flush();
+
+    // Close an empty reservation so the fallback path doesn't stay mapped
+    if (writeTarget != nullptr)
+    {
+        vertexStream.commit(0);
+        writeTarget = nullptr;
+    }
+}
+
+void SpriteBatch::flush()
+{
+    if (commands.empty())
+    {
+        return;
+    }
+
+    radixSort(commands, sortScratch);
+
+    // Walk in key order; a GPU batch only breaks on a shader change or
+    // when a new texture finds every sampler slot taken. Sprites are
+    // collected into runs so the vertex kernel transforms them in groups.
+    for (const DrawCommand& command : commands)
+    {
+        Resources::Shader* shader = shaderSlots[command.key & 0xFF];
+        if (shader != batchShader && (spriteCount > 0 || !pendingSprites.empty()))
+        {
+            writePendingSprites();
+            submitBatch();
+        }
+        batchShader = shader;
+
+        uint8_t slot = batchSlotFor(textureSlots[(command.key >> 8) & 0xFFFF]);
+        if ((command.index & SUBMITTED_RECORD) != 0)
+        {
+            writePendingSprites();
+            writeRecord(submittedRecords[command.index & ~SUBMITTED_RECORD], slot);
+        }
+        else
+        {
+            pendingSprites.push_back(&queued[command.index]);
+            pendingSlots.push_back(slot);
+        }
+    }
+    writePendingSprites();
+    submitBatch();
+
+    resetQueue();
+}
+
+uint8_t SpriteBatch::batchSlotFor(Resources::Texture* texture)
+{
+    if (texture == nullptr)
+    {
+        return static_cast<uint8_t>(Shaders::TEXTURE_SLOT_NONE);
+    }
+
+    auto it = std::find(batchTextures.begin(), batchTextures.end(), texture);
+    if (it == batchTextures.end())
+    {
+        if (batchTextures.size() == Shaders::MAX_TEXTURE_SLOTS)
+        {
+            writePendingSprites();
+            submitBatch();
+        }
+        it = batchTextures.insert(batchTextures.end(), texture);
+    }
+    return static_cast<uint8_t>(it - batchTextures.begin());
+}
+
+unsigned char* SpriteBatch::nextRecord()
+{
+    // Slots stay assigned across a capacity split, so texture slots remain valid
+    if (writeTarget != nullptr && spriteCount >= batchCapacity)
+    {
+        submitBatch(false);
+    }
+    if (writeTarget == nullptr)
+    {
+        reserveBatch();
+        if (writeTarget == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    return writeTarget + spriteCount++ * recordSize;
+}
+
+void SpriteBatch::writePendingSprites()
+{
+    size_t written = 0;
+    while (written < pendingSprites.size())
+    {
+        // Slots stay assigned across a capacity split, so pending slots remain valid
+        if (writeTarget != nullptr && spriteCount >= batchCapacity)
+        {
+            submitBatch(false);
+        }
+        if (writeTarget == nullptr)
+        {
+            reserveBatch();
+            if (writeTarget == nullptr)
+            {
+                break;
+            }
+        }
+
+        size_t count = std::min(pendingSprites.size() - written, batchCapacity - spriteCount);
+        unsigned char* out = writeTarget + spriteCount * recordSize;
+        if (mode == SpriteBatchMode::Instanced)
+        {
+            SpriteInstance* instances = reinterpret_cast<SpriteInstance*>(out);
+            for (size_t i = 0; i < count; ++i)
+            {
+                writeSpriteInstance(*pendingSprites[written + i], pendingSlots[written + i], axes, &instances[i]);
+            }
+        }
+        else
+        {
+            writeSpriteVerticesBatch(pendingSprites.data() + written, pendingSlots.data() + written, count, axes,
+                                     reinterpret_cast<SpriteVertex*>(out));
+        }
+        spriteCount += count;
+        written += count;
+    }
+
+    pendingSprites.clear();
+    pendingSlots.clear();
+}
+
+void SpriteBatch::writeRecord(const void* record, uint8_t textureSlot)
+{
+    unsigned char* out = nextRecord();
+    if (out == nullptr)
+    {
+        return;
+    }
+
+    // Patch the slot in a local copy so the mapped stream only sees whole writes
+    if (mode == SpriteBatchMode::Instanced)
+    {
+        SpriteInstance instance = *static_cast<const SpriteInstance*>(record);
+        instance.textureSlot = textureSlot;
+        *reinterpret_cast<SpriteInstance*>(out) = instance;
+    }
+    else
+    {
+        const SpriteVertex* source = static_cast<const SpriteVertex*>(record);
+        SpriteVertex* destination = reinterpret_cast<SpriteVertex*>(out);
+        for (int i = 0; i < 4; ++i)
+        {
+            SpriteVertex vertex = source[i];
+            vertex.textureSlot = textureSlot;
+            destination[i] = vertex;
+        }
+    }
+}
+
+void SpriteBatch::submitBatch(bool releaseSlots)
+{
+    if (spriteCount == 0)
+    {
+        if (releaseSlots)
+        {
+            batchTextures.clear();
+        }
+        return;
+    }
+
+    size_t offset = vertexStream.commit(batchShader != nullptr ? spriteCount * recordSize : 0);
+    writeTarget = nullptr;
+
+    if (batchShader == nullptr)
+    {
+        spriteCount = 0;
+        if (releaseSlots)
+        {
+            batchTextures.clear();
+        }
+        return;
+    }
+
+    // uTextures samplers are bound to units once, at link time
+    state->useProgram(batchShader->getID());
+    for (size_t slot = 0; slot < batchTextures.size(); ++slot)
+    {
+        state->bindTexture(static_cast<unsigned int>(slot), batchTextures[slot]->getID());
+    }
+    state->bindVertexArray(VAO);
+
+    if (mode == SpriteBatchMode::Instanced)
+    {
+        setInstanceAttributes(offset);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(spriteCount));
+    }
+    else
+    {
+        // Vertices were written in place; the ring offset becomes the base vertex
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(spriteCount * 6), GL_UNSIGNED_SHORT,
+                                 nullptr, static_cast<GLint>(offset / sizeof(SpriteVertex)));
+    }
+
+    ++drawCalls;
+    spritesDrawn += spriteCount;
+    spriteCount = 0;
+    if (releaseSlots)
+    {
+        batchTextures.clear();
+    }
+}
+
+void SpriteBatch::reserveBatch()
+{
+    size_t available = 0;
+    void* data = vertexStream.reserve(std::min(maxSprites, MIN_BATCH_SPRITES) * recordSize, available);
+
+    writeTarget = static_cast<unsigned char*>(data);
+    batchCapacity = std::min(maxSprites, available / recordSize);
+}
+
+// ============================================================================
+// Renderer
+// ============================================================================
+
+Renderer::Renderer()
+    : Renderer(GLBackend::getOpenGL())
+{
+}
+
+Renderer::Renderer(GLBackend& backend)
+    : glState(backend)
+    , lightDrawCalls(0)
+    , windowWidth(0)
+    , windowHeight(0)
+    , fullscreenVAO(0)
+    , overlayBegun(false)
+    , renderWidth(0)
+    , renderHeight(0)
+    , dynamicResolutionEnabled(false)
+    , worldDrawCalls(0)
+    , worldSpritesDrawn(0)
+    , lastFrameTime(0.0)
+    , clearColor(0.2f, 0.2f, 0.2f, 1.0f)
+    , alphaCutoff(DEFAULT_ALPHA_CUTOFF)
+    , debugMode(false)
+    , stats{0, 0, 0, 0, 0, 1.0f, 0.0}
+#if PENUMBRA_DEBUG_DRAW
+    , debugVAO(0)
+    , debugVBO(0)
+    , debugDrawCalls(0)
+#endif
+{
+}
+
+Renderer::~Renderer()
+{
+    if (fullscreenVAO != 0)
+    {
+        glDeleteVertexArrays(1, &fullscreenVAO);
+    }
+#if PENUMBRA_DEBUG_DRAW
+    if (debugVAO != 0)
+    {
+        glDeleteVertexArrays(1, &debugVAO);
+    }
+    if (debugVBO != 0)
+    {
+        glDeleteBuffers(1, &debugVBO);
+    }
+#endif
+}
+
+void Renderer::initialize(int width, int height, SpriteBatchMode batchMode)
+{
+    windowWidth = width;
+    windowHeight = height;
+    renderWidth = width;
+    renderHeight = height;
+    overlayCamera.setViewportSize(static_cast<float>(width), static_cast<float>(height));
+    overlayCamera.setPosition(static_cast<float>(width) * 0.5f, static_cast<float>(height) * 0.5f);
+
+    frameUniforms.initialize();
+    const char* vertexSource = batchMode == SpriteBatchMode::Instanced
+        ? Shaders::INSTANCED_SPRITE_VERTEX_SHADER
+        : Shaders::DEFAULT_VERTEX_SHADER;
+    if (!defaultShader.loadFromSource(vertexSource, Shaders::DEFAULT_FRAGMENT_SHADER))
+    {
+        std::cerr << "Failed to create default sprite shader" << std::endl;
+    }
+    spriteBatch.initialize(glState, 10000, batchMode);
+
+    std::vector<uint8_t> fontPixels;
+    defaultFont.loadBuiltin(fontPixels);
+    defaultFontPage.loadFromPixels(fontPixels.data(), defaultFont.getPageWidth(), defaultFont.getPageHeight(),
+                                   &glState);
+    defaultFont.setPage(&defaultFontPage);
+
+    lightRenderer.initialize(glState, windowWidth, windowHeight);
+
+    if (!upscaleShader.loadFromSource(Shaders::UPSCALE_VERTEX_SHADER, Shaders::COPY_FRAGMENT_SHADER) ||
+        !postShader.loadFromSource(Shaders::UPSCALE_VERTEX_SHADER, Shaders::POST_FRAGMENT_SHADER))
+    {
+        std::cerr << "Failed to create upscale shaders" << std::endl;
+    }
+    glState.useProgram(upscaleShader.getID());
+    upscaleShader.setInt(Shaders::UNIFORM_TEXTURE, 0);
+    glState.useProgram(postShader.getID());
+    postShader.setInt(Shaders::UNIFORM_TEXTURE, 0);
+    glGenVertexArrays(1, &fullscreenVAO);
+    gpuTimer.initialize();
+
+#if PENUMBRA_DEBUG_DRAW
+    if (!debugShader.loadFromSource(Shaders::DEBUG_VERTEX_SHADER, Shaders::DEBUG_FRAGMENT_SHADER))
+    {
+        std::cerr << "Failed to create debug draw shader" << std::endl;
+    }
+    glGenVertexArrays(1, &debugVAO);
+    glGenBuffers(1, &debugVBO);
+    glState.bindVertexArray(debugVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, debugVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex),
+                          reinterpret_cast<void*>(offsetof(DebugVertex, x)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex),
+                          reinterpret_cast<void*>(offsetof(DebugVertex, r)));
+#endif
+
+    // Equal depths pass so sprites sharing an anchor depth keep batch order
+    glDepthFunc(GL_LEQUAL);
+
+    lastFrameTime = Platform::Time::getTime();
+}
+
+void Renderer::beginFrame(const Camera& camera)
+{
+    float deltaTime = prepareFrame(DepthMode::Disabled);
+    frameUniforms.update(camera, static_cast<float>(lastFrameTime), deltaTime);
+
+    clear();
+    spriteBatch.begin(camera, &defaultShader, nullptr);
+    beginCommandBuffers();
+}
+
+void Renderer::beginFrame(const IsometricCamera& camera)
+{
+    float deltaTime = prepareFrame(DepthMode::TestWrite);
+    frameUniforms.update(camera, alphaCutoff, static_cast<float>(lastFrameTime), deltaTime);
+
+    clear();
+    spriteBatch.begin(camera, &defaultShader, nullptr);
+    beginCommandBuffers();
+}
+
+float Renderer::prepareFrame(DepthMode depthMode)
+{
+    // Resource loading and eviction bind and delete GL objects directly,
+    // so the shadow is only trusted within a frame
+    glState.invalidate();
+    glState.resetStats();
+    stats = Stats{0, 0, 0, 0, 0, 1.0f, 0.0};
+    lightDrawCalls = 0;
+    worldDrawCalls = 0;
+    worldSpritesDrawn = 0;
+    overlayBegun = false;
+#if PENUMBRA_DEBUG_DRAW
+    debugDrawCalls = 0;
+#endif
+
+    // Results lag a few frames; a scale change applies from this frame on
+    if (gpuTimer.poll() && dynamicResolutionEnabled && worldTarget.isValid() &&
+        dynamicResolution.update(gpuTimer.getLastTime()))
+    {
+        applyRenderScale(dynamicResolution.getScale());
+    }
+    gpuTimer.begin();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, worldTarget.getFramebuffer());
+    glState.setViewport(0, 0, renderWidth, renderHeight);
+    glState.setBlendMode(BlendMode::Premultiplied);
+    glState.setDepthMode(depthMode);
+
+    double now = Platform::Time::getTime();
+    float deltaTime = static_cast<float>(now - lastFrameTime);
+    lastFrameTime = now;
+    return deltaTime;
+}
+
+void Renderer::setCommandBufferCount(size_t count)
+{
+    commandBuffers.resize(count);
+    beginCommandBuffers();
+}
+
+void Renderer::beginCommandBuffers()
+{
+    for (SpriteCommandBuffer& buffer : commandBuffers)
+    {
+        buffer.begin(spriteBatch.getMode(), spriteBatch.getAxes(), &defaultShader);
+    }
+}
+
+void Renderer::submitCommandBuffers()
+{
+    bool submitted = false;
+    for (SpriteCommandBuffer& buffer : commandBuffers)
+    {
+        submitted = submitted || buffer.getSpriteCount() > 0;
+        spriteBatch.submit(buffer);
+    }
+    if (!submitted)
+    {
+        return;
+    }
+
+    // Records are only copied out on flush; buffers can be reused after it
+    spriteBatch.flush();
+    for (SpriteCommandBuffer& buffer : commandBuffers)
+    {
+        buffer.clear();
+    }
+}
+
+void Renderer::beginTranslucentPass()
+{
+    spriteBatch.flush();
+    glState.setDepthMode(DepthMode::TestOnly);
+
+    // Translucent texels must blend, not be cut out
+    FrameData frameData = frameUniforms.getData();
+    frameData.cameraDown.w = 0.0f;
+    frameUniforms.update(frameData);
+}
+
+void Renderer::beginOverlay()
+{
+    if (overlayBegun)
+    {
+        return;
+    }
+    overlayBegun = true;
+
+    submitCommandBuffers();
+    spriteBatch.end();
+    worldDrawCalls = spriteBatch.getDrawCalls();
+    worldSpritesDrawn = spriteBatch.getSpritesDrawn();
+
+    if (worldTarget.isValid())
+    {
+        drawUpscale();
+    }
+
+    glState.setViewport(0, 0, windowWidth, windowHeight);
+    glState.setDepthMode(DepthMode::Disabled);
+    glState.setBlendMode(BlendMode::Premultiplied);
+    frameUniforms.update(overlayCamera, static_cast<float>(lastFrameTime), 0.0f);
+    spriteBatch.begin(overlayCamera, &defaultShader, nullptr);
+    beginCommandBuffers();
+}
+
+void Renderer::drawUpscale()
+{
+    // Letterbox bars stay black; the image is centered at a whole scale
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glState.setViewport(0, 0, windowWidth, windowHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    IntegerUpscale fit = fitIntegerUpscale(worldTarget.getWidth(), worldTarget.getHeight(),
+                                           windowWidth, windowHeight);
+    glState.setViewport(fit.x, fit.y, fit.width, fit.height);
+    glState.setDepthMode(DepthMode::Disabled);
+    glState.setBlendMode(BlendMode::None);
+
+    Resources::Shader& shader = post.isNeutral() ? upscaleShader : postShader;
+    glState.useProgram(shader.getID());
+    shader.setVec2(Shaders::UNIFORM_SOURCE_REGION,
+                   static_cast<float>(renderWidth) / static_cast<float>(worldTarget.getWidth()),
+                   static_cast<float>(renderHeight) / static_cast<float>(worldTarget.getHeight()));
+    if (!post.isNeutral())
+    {
+        postShader.setVec3(Shaders::UNIFORM_GRADE, post.brightness, post.contrast, post.saturation);
+        postShader.setVec3(Shaders::UNIFORM_TINT, post.tint.r, post.tint.g, post.tint.b);
+        postShader.setVec3(Shaders::UNIFORM_VIGNETTE, post.vignette, post.vignetteRadius, post.vignetteSoftness);
+    }
+    glState.bindTexture(0, worldTarget.getTexture());
+    glState.bindVertexArray(fullscreenVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    ++worldDrawCalls;
+}
+
+void Renderer::setWorldResolution(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        worldTarget.release();
+    }
+    else
+    {
+        worldTarget.create(glState, width, height, RenderTargetFilter::Nearest, true);
+    }
+    dynamicResolution.reset();
+    applyRenderScale(dynamicResolution.getScale());
+}
+
+void Renderer::setDynamicResolution(bool enabled)
+{
+    dynamicResolutionEnabled = enabled;
+    dynamicResolution.reset();
+    applyRenderScale(dynamicResolution.getScale());
+}
+
+void Renderer::applyRenderScale(float scale)
+{
+    if (!worldTarget.isValid())
+    {
+        scale = 1.0f;
+    }
+    int width = std::max(static_cast<int>(std::lround(static_cast<float>(getWorldWidth()) * scale)), 1);
+    int height = std::max(static_cast<int>(std::lround(static_cast<float>(getWorldHeight()) * scale)), 1);
+    if (width == renderWidth && height == renderHeight)
+    {
+        return;
+    }
+
+    // The light map follows so its fill cost scales too
+    renderWidth = width;
+    renderHeight = height;
+    lightRenderer.resize(renderWidth, renderHeight);
+}
+
+void Renderer::endFrame()
+{
+    beginOverlay();
+    submitCommandBuffers();
+    spriteBatch.end();
+    gpuTimer.end();
+
+    stats.drawCalls = worldDrawCalls + spriteBatch.getDrawCalls() + lightDrawCalls;
+#if PENUMBRA_DEBUG_DRAW
+    stats.drawCalls += debugDrawCalls;
+#endif
+    stats.spritesDrawn = worldSpritesDrawn + spriteBatch.getSpritesDrawn();
+    stats.verticesDrawn = stats.spritesDrawn * 4;
+    stats.stateChanges = glState.getStats().issued;
+    stats.stateChangesAvoided = glState.getStats().avoided;
+    stats.resolutionScale = static_cast<float>(renderWidth) / static_cast<float>(getWorldWidth());
+    stats.gpuFrameTime = gpuTimer.getLastTime();
+}
+
+void Renderer::drawDebug(const DebugDrawQueue& queue)
+{
+#if PENUMBRA_DEBUG_DRAW
+    if (queue.isEmpty())
+    {
+        return;
+    }
+    spriteBatch.flush();
+
+    const std::vector<DebugVertex>& triangles = queue.getTriangleVertices();
+    const std::vector<DebugVertex>& lines = queue.getLineVertices();
+    size_t triangleBytes = triangles.size() * sizeof(DebugVertex);
+    size_t lineBytes = lines.size() * sizeof(DebugVertex);
+
+    // Orphan, then fill: last frame's draw may still be reading the old storage
+    glState.bindVertexArray(debugVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, debugVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(triangleBytes + lineBytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(triangleBytes), triangles.data());
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(triangleBytes), static_cast<GLsizeiptr>(lineBytes),
+                    lines.data());
+
+    DepthMode frameDepthMode = glState.getDepthMode();
+    glState.useProgram(debugShader.getID());
+    glState.setDepthMode(DepthMode::Disabled);
+    if (!triangles.empty())
+    {
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(triangles.size()));
+        ++debugDrawCalls;
+    }
+    if (!lines.empty())
+    {
+        glDrawArrays(GL_LINES, static_cast<GLint>(triangles.size()), static_cast<GLsizei>(lines.size()));
+        ++debugDrawCalls;
+    }
+    glState.setDepthMode(frameDepthMode);
+#else
+    (void)queue;
+#endif
+}
+
+void Renderer::drawLighting(const LightFrame& frame)
+{
+    if (!frame.enabled)
+    {
+        return;
+    }
+    spriteBatch.flush();
+    lightRenderer.draw(frame, worldTarget.getFramebuffer());
+    lightDrawCalls += lightRenderer.getDrawCalls();
+}
+
+void Renderer::setClearColor(const Math::Color& color)
+{
+    clearColor = color;
+}
+
+void Renderer::clear()
+{
+    glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void Renderer::drawRect(const Math::Rect& rect, const Math::Color& color)
+{
+    Sprite sprite;
+    sprite.position = Math::Vec2(rect.x, rect.y);
+    sprite.size = Math::Vec2(rect.width, rect.height);
+    sprite.origin = Math::Vec2(0.0f, 0.0f);
+    sprite.color = color;
+
+    spriteBatch.setTexture(nullptr);
+    spriteBatch.draw(sprite);
+}
+
+void Renderer::drawRectOutline(const Math::Rect& rect, const Math::Color& color, float thickness)
+{
+    drawRect(Math::Rect(rect.x, rect.y, rect.width, thickness), color);
+    drawRect(Math::Rect(rect.x, rect.y + rect.height - thickness, rect.width, thickness), color);
+    drawRect(Math::Rect(rect.x, rect.y + thickness, thickness, rect.height - 2.0f * thickness), color);
+    drawRect(Math::Rect(rect.x + rect.width - thickness, rect.y + thickness,
+                        thickness, rect.height - 2.0f * thickness), color);
+}
+
+void Renderer::drawLine(const Math::Vec2& start, const Math::Vec2& end,
+                        const Math::Color& color, float thickness)
+{
+    Math::Vec2 delta = end - start;
+
+    Sprite sprite;
+    sprite.position = start;
+    sprite.size = Math::Vec2(std::sqrt(delta.x * delta.x + delta.y * delta.y), thickness);
+    sprite.origin = Math::Vec2(0.0f, 0.5f);
+    sprite.rotation = std::atan2(delta.y, delta.x);
+    sprite.color = color;
+
+    spriteBatch.setTexture(nullptr);
+    spriteBatch.draw(sprite);
+}
+
+} // namespace Rendering
+} // namespace Penumbra
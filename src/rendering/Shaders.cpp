@@ -0,0 +1,483 @@
+#include "rendering/Shaders.h"
+#include "rendering/ProgramCache.h"
+#include "core/OpenGL.h"
+#include "core/Platform.h"
+#include <iostream>
+#include <vector>
+
+namespace Penumbra {
+namespace Rendering {
+namespace Shaders {
+
+const char* DEFAULT_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in uint aTexSlot;
+
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;
+};
+
+out vec2 vTexCoord;
+out vec4 vColor;
+flat out uint vTexSlot;
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
+    vTexCoord = aTexCoord;
+    vColor = aColor;
+    vTexSlot = aTexSlot;
+}
+)";
+
+const char* DEFAULT_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 vTexCoord;
+in vec4 vColor;
+flat in uint vTexSlot;
+
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;
+};
+
+uniform sampler2D uTextures[8];
+
+out vec4 FragColor;
+
+vec4 sampleSlot(uint slot, vec2 uv, vec2 dx, vec2 dy)
+{
+    switch (slot)
+    {
+        case 0u: return textureGrad(uTextures[0], uv, dx, dy);
+        case 1u: return textureGrad(uTextures[1], uv, dx, dy);
+        case 2u: return textureGrad(uTextures[2], uv, dx, dy);
+        case 3u: return textureGrad(uTextures[3], uv, dx, dy);
+        case 4u: return textureGrad(uTextures[4], uv, dx, dy);
+        case 5u: return textureGrad(uTextures[5], uv, dx, dy);
+        case 6u: return textureGrad(uTextures[6], uv, dx, dy);
+        case 7u: return textureGrad(uTextures[7], uv, dx, dy);
+        default: return vec4(1.0);
+    }
+}
+
+void main()
+{
+    vec4 color = sampleSlot(vTexSlot, vTexCoord, dFdx(vTexCoord), dFdy(vTexCoord)) * vColor;
+    if (color.a < uCameraDown.w)
+    {
+        discard;
+    }
+    FragColor = color;
+}
+)";
+
+const char* INSTANCED_SPRITE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec4 aTransform;
+layout(location = 1) in vec2 aSize;
+layout(location = 2) in vec4 aTexRect;
+layout(location = 3) in vec2 aOrigin;
+layout(location = 4) in vec4 aColor;
+layout(location = 5) in uint aTexSlot;
+
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;
+};
+
+out vec2 vTexCoord;
+out vec4 vColor;
+flat out uint vTexSlot;
+
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec2 local = (corner - aOrigin) * aSize;
+    float c = cos(aTransform.w);
+    float s = sin(aTransform.w);
+    vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    vec3 world = aTransform.xyz + uCameraRight.xyz * rotated.x + uCameraDown.xyz * rotated.y;
+
+    gl_Position = uViewProjection * vec4(world, 1.0);
+    vTexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
+    vColor = aColor;
+    vTexSlot = aTexSlot;
+}
+)";
+
+const char* PASSTHROUGH_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
+
+out vec2 vTexCoord;
+out vec4 vColor;
+
+void main()
+{
+    gl_Position = vec4(aPosition, 1.0);
+    vTexCoord = aTexCoord;
+    vColor = aColor;
+}
+)";
+
+const char* SOLID_COLOR_FRAGMENT_SHADER = R"(#version 330 core
+uniform vec4 uColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = uColor;
+}
+)";
+
+const char* DEBUG_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec3 aPosition;
+layout(location = 2) in vec4 aColor;
+
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;
+};
+
+out vec4 vColor;
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
+    vColor = aColor;
+}
+)";
+
+const char* DEBUG_FRAGMENT_SHADER = R"(#version 330 core
+in vec4 vColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vColor;
+}
+)";
+
+const char* FULLSCREEN_VERTEX_SHADER = R"(#version 330 core
+out vec2 vTexCoord;
+
+void main()
+{
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    vTexCoord = corner;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* UPSCALE_VERTEX_SHADER = R"(#version 330 core
+uniform vec2 uSourceRegion;
+
+out vec2 vTexCoord;
+
+void main()
+{
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    vTexCoord = corner * uSourceRegion;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* COPY_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 vTexCoord;
+
+uniform sampler2D uTexture;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = texture(uTexture, vTexCoord);
+}
+)";
+
+const char* POST_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 vTexCoord;
+
+uniform sampler2D uTexture;
+uniform vec3 uGrade;     // Brightness, contrast, saturation
+uniform vec3 uTint;
+uniform vec3 uVignette;  // Strength, radius, softness
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 color = texture(uTexture, vTexCoord).rgb;
+
+    color = (color - 0.5) * uGrade.y + 0.5 + uGrade.x;
+    float luma = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    color = mix(vec3(luma), color, uGrade.z) * uTint;
+
+    // Distance from center, 1 at the corners
+    float distance = length(vTexCoord - 0.5) * 1.41421356;
+    float falloff = smoothstep(uVignette.y, uVignette.y + uVignette.z, distance);
+    color *= 1.0 - uVignette.x * falloff;
+
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
+)";
+
+const char* BLUR_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 vTexCoord;
+
+uniform sampler2D uTexture;
+uniform vec2 uTexelStep;
+
+out vec4 FragColor;
+
+const float WEIGHTS[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+
+void main()
+{
+    vec4 sum = texture(uTexture, vTexCoord) * WEIGHTS[0];
+    for (int i = 1; i < 5; ++i)
+    {
+        sum += texture(uTexture, vTexCoord + uTexelStep * float(i)) * WEIGHTS[i];
+        sum += texture(uTexture, vTexCoord - uTexelStep * float(i)) * WEIGHTS[i];
+    }
+    FragColor = sum;
+}
+)";
+
+const char* LIGHT_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 aPosition;
+
+layout(std140) uniform FrameData
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewport;
+    vec4 uTime;
+    vec4 uCameraRight;
+    vec4 uCameraDown;
+};
+
+out vec2 vWorldPosition;
+
+void main()
+{
+    gl_Position = uViewProjection * vec4(aPosition, 0.0, 1.0);
+    vWorldPosition = aPosition;
+}
+)";
+
+const char* LIGHT_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 vWorldPosition;
+
+uniform vec2 uLightPosition;
+uniform float uLightRadius;
+uniform vec3 uLightColor;
+uniform vec2 uLightDirection;
+uniform vec2 uLightCone;  // Cosines of the cone's outer and inner edge
+
+out vec4 FragColor;
+
+void main()
+{
+    vec2 toFragment = vWorldPosition - uLightPosition;
+    float distance = length(toFragment);
+    float falloff = clamp(1.0 - distance / uLightRadius, 0.0, 1.0);
+    falloff *= falloff;
+
+    if (uLightCone.x > -1.0)
+    {
+        float alignment = dot(toFragment / max(distance, 0.0001), uLightDirection);
+        falloff *= smoothstep(uLightCone.x, uLightCone.y, alignment);
+    }
+
+    FragColor = vec4(uLightColor * falloff, 1.0);
+}
+)";
+
+namespace {
+
+/**
+ * Point the program's FrameData block (if any) at the shared binding
+ * Done after every link or binary load, since bindings aren't part of the source
+ */
+void bindFrameBlock(unsigned int programID)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(programID, FRAME_UNIFORM_BLOCK);
+    if (blockIndex != GL_INVALID_INDEX)
+    {
+        glUniformBlockBinding(programID, blockIndex, FRAME_UNIFORM_BINDING);
+    }
+}
+
+/**
+ * Point the program's uTextures samplers (if any) at units 0..MAX_TEXTURE_SLOTS-1
+ * Sampler values are program state, so this is done once here instead of
+ * per batch. GL 3.3 can only set uniforms on the current program; the
+ * previous one is restored so GLStateCache's shadow stays correct
+ */
+void bindSamplerUnits(unsigned int programID)
+{
+    GLint location = glGetUniformLocation(programID, "uTextures");
+    if (location < 0)
+    {
+        return;
+    }
+
+    static const GLint SAMPLER_UNITS[MAX_TEXTURE_SLOTS] = {0, 1, 2, 3, 4, 5, 6, 7};
+    GLint previous = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+    glUseProgram(programID);
+    glUniform1iv(location, MAX_TEXTURE_SLOTS, SAMPLER_UNITS);
+    glUseProgram(static_cast<GLuint>(previous));
+}
+
+} // namespace
+
+bool compileShader(const std::string& source, unsigned int type, unsigned int& outID)
+{
+    GLuint shader = glCreateShader(type);
+    const char* sourcePtr = source.c_str();
+    glShaderSource(shader, 1, &sourcePtr, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE)
+    {
+        GLint logLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> log(static_cast<size_t>(logLength > 1 ? logLength : 1));
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Shader compilation failed: " << log.data() << std::endl;
+        glDeleteShader(shader);
+        return false;
+    }
+
+    outID = shader;
+    return true;
+}
+
+bool linkProgram(unsigned int vertexID, unsigned int fragmentID, unsigned int& outProgramID)
+{
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexID);
+    glAttachShader(program, fragmentID);
+
+    // Must be set before linking for glGetProgramBinary to return anything
+    if (ProgramCache::getInstance().isSupported())
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+
+    glDetachShader(program, vertexID);
+    glDetachShader(program, fragmentID);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        GLint logLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+        std::vector<char> log(static_cast<size_t>(logLength > 1 ? logLength : 1));
+        glGetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Shader program linking failed: " << log.data() << std::endl;
+        glDeleteProgram(program);
+        return false;
+    }
+
+    outProgramID = program;
+    return true;
+}
+
+bool createShaderProgram(const std::string& vertexSource,
+                         const std::string& fragmentSource,
+                         unsigned int& outProgramID)
+{
+    // Warm path: reuse the driver's own binary and skip compilation entirely
+    ProgramCache& cache = ProgramCache::getInstance();
+    uint64_t key = cache.makeKey(vertexSource, fragmentSource);
+    if (cache.load(key, outProgramID))
+    {
+        bindFrameBlock(outProgramID);
+        bindSamplerUnits(outProgramID);
+        return true;
+    }
+
+    unsigned int vertexID = 0;
+    unsigned int fragmentID = 0;
+    if (!compileShader(vertexSource, GL_VERTEX_SHADER, vertexID))
+    {
+        return false;
+    }
+    if (!compileShader(fragmentSource, GL_FRAGMENT_SHADER, fragmentID))
+    {
+        glDeleteShader(vertexID);
+        return false;
+    }
+
+    bool linked = linkProgram(vertexID, fragmentID, outProgramID);
+    glDeleteShader(vertexID);
+    glDeleteShader(fragmentID);
+
+    if (linked)
+    {
+        cache.store(key, outProgramID);
+        bindFrameBlock(outProgramID);
+        bindSamplerUnits(outProgramID);
+    }
+    return linked;
+}
+
+bool loadShaderProgram(const std::string& vertexPath,
+                       const std::string& fragmentPath,
+                       unsigned int& outProgramID)
+{
+    std::string vertexSource;
+    std::string fragmentSource;
+    if (!Platform::FileSystem::readFile(vertexPath, vertexSource))
+    {
+        std::cerr << "Failed to read vertex shader: " << vertexPath << std::endl;
+        return false;
+    }
+    if (!Platform::FileSystem::readFile(fragmentPath, fragmentSource))
+    {
+        std::cerr << "Failed to read fragment shader: " << fragmentPath << std::endl;
+        return false;
+    }
+    return createShaderProgram(vertexSource, fragmentSource, outProgramID);
+}
+
+} // namespace Shaders
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,425 @@
+#include "rendering/Sprite.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define PENUMBRA_SPRITE_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PENUMBRA_SPRITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+uint16_t packUnorm16(float value)
+{
+    return static_cast<uint16_t>(Math::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+uint8_t packUnorm8(float value)
+{
+    return static_cast<uint8_t>(Math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+#ifdef PENUMBRA_SPRITE_SSE2
+
+/**
+ * Four-lane SSE2 operations for the vertex kernel
+ */
+struct PackSse2 {
+    using F = __m128;
+    using I = __m128i;
+    static constexpr int WIDTH = 4;
+
+    static F load(const float* p) { return _mm_load_ps(p); }
+    static void store(float* p, F v) { _mm_store_ps(p, v); }
+    static void store(uint32_t* p, I v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    static F set(float v) { return _mm_set1_ps(v); }
+    static I set(int v) { return _mm_set1_epi32(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+    static F bitXor(F a, F b) { return _mm_xor_ps(a, b); }
+    static F select(F mask, F a, F b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static bool allZero(F v) { return _mm_movemask_ps(_mm_cmpneq_ps(v, _mm_setzero_ps())) == 0; }
+    static I truncate(F v) { return _mm_cvttps_epi32(v); }
+    static I round(F v) { return _mm_cvtps_epi32(v); }
+    static F toFloat(I v) { return _mm_cvtepi32_ps(v); }
+    static F asFloat(I v) { return _mm_castsi128_ps(v); }
+    static I add(I a, I b) { return _mm_add_epi32(a, b); }
+    static I bitAnd(I a, I b) { return _mm_and_si128(a, b); }
+    static I bitOr(I a, I b) { return _mm_or_si128(a, b); }
+    static I equal(I a, I b) { return _mm_cmpeq_epi32(a, b); }
+    template <int BITS> static I shiftLeft(I v) { return _mm_slli_epi32(v, BITS); }
+};
+
+#ifdef PENUMBRA_SPRITE_AVX2
+
+/**
+ * Eight-lane AVX2 operations for the vertex kernel
+ */
+struct PackAvx2 {
+    using F = __m256;
+    using I = __m256i;
+    static constexpr int WIDTH = 8;
+
+    static F load(const float* p) { return _mm256_load_ps(p); }
+    static void store(float* p, F v) { _mm256_store_ps(p, v); }
+    static void store(uint32_t* p, I v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static F set(float v) { return _mm256_set1_ps(v); }
+    static I set(int v) { return _mm256_set1_epi32(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F bitXor(F a, F b) { return _mm256_xor_ps(a, b); }
+    static F select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+    static bool allZero(F v)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_NEQ_UQ)) == 0;
+    }
+    static I truncate(F v) { return _mm256_cvttps_epi32(v); }
+    static I round(F v) { return _mm256_cvtps_epi32(v); }
+    static F toFloat(I v) { return _mm256_cvtepi32_ps(v); }
+    static F asFloat(I v) { return _mm256_castsi256_ps(v); }
+    static I add(I a, I b) { return _mm256_add_epi32(a, b); }
+    static I bitAnd(I a, I b) { return _mm256_and_si256(a, b); }
+    static I bitOr(I a, I b) { return _mm256_or_si256(a, b); }
+    static I equal(I a, I b) { return _mm256_cmpeq_epi32(a, b); }
+    template <int BITS> static I shiftLeft(I v) { return _mm256_slli_epi32(v, BITS); }
+};
+
+using SpriteKernel = PackAvx2;
+constexpr const char* SPRITE_KERNEL_NAME = "AVX2";
+
+#else
+
+using SpriteKernel = PackSse2;
+constexpr const char* SPRITE_KERNEL_NAME = "SSE2";
+
+#endif
+
+/**
+ * sin and cos per lane (Cephes single-precision polynomials)
+ * Reduces to [-pi/4, pi/4] by quadrant, then picks and signs the results
+ */
+template <class P>
+void sinCos(typename P::F x, typename P::F& outSin, typename P::F& outCos)
+{
+    using F = typename P::F;
+    using I = typename P::I;
+
+    I quadrant = P::round(P::mul(x, P::set(0.636619772f)));  // 2 / pi
+    F j = P::toFloat(quadrant);
+
+    // pi / 2 split three ways so the reduction stays exact for large j
+    F y = P::sub(x, P::mul(j, P::set(1.5703125f)));
+    y = P::sub(y, P::mul(j, P::set(4.837512969970703125e-4f)));
+    y = P::sub(y, P::mul(j, P::set(7.54978995489188216e-8f)));
+    F z = P::mul(y, y);
+
+    F s = P::add(P::mul(z, P::set(-1.9515295891e-4f)), P::set(8.3321608736e-3f));
+    s = P::add(P::mul(s, z), P::set(-1.6666654611e-1f));
+    s = P::add(P::mul(P::mul(s, z), y), y);
+
+    F c = P::add(P::mul(z, P::set(2.443315711809948e-5f)), P::set(-1.388731625493765e-3f));
+    c = P::add(P::mul(c, z), P::set(4.166664568298827e-2f));
+    c = P::add(P::mul(P::mul(c, z), z), P::sub(P::set(1.0f), P::mul(z, P::set(0.5f))));
+
+    // Odd quadrants swap sin and cos; bit 1 of the quadrant (of quadrant + 1 for cos) flips the sign
+    F swap = P::asFloat(P::equal(P::bitAnd(quadrant, P::set(1)), P::set(1)));
+    F sinSign = P::asFloat(P::template shiftLeft<30>(P::bitAnd(quadrant, P::set(2))));
+    F cosSign = P::asFloat(P::template shiftLeft<30>(P::bitAnd(P::add(quadrant, P::set(1)), P::set(2))));
+    outSin = P::bitXor(P::select(swap, c, s), sinSign);
+    outCos = P::bitXor(P::select(swap, s, c), cosSign);
+}
+
+template <class P>
+typename P::I packUnorm(typename P::F value, float scale)
+{
+    value = P::min(P::max(value, P::set(0.0f)), P::set(1.0f));
+    return P::truncate(P::add(P::mul(value, P::set(scale)), P::set(0.5f)));
+}
+
+/**
+ * Transform P::WIDTH sprites and write their 4 * P::WIDTH vertices
+ */
+template <class P>
+void writeSpriteGroup(const Sprite* const* sprites, const uint8_t* textureSlots, const SpriteAxes& axes,
+                      SpriteVertex* out, bool streaming)
+{
+    using F = typename P::F;
+    using I = typename P::I;
+    constexpr int W = P::WIDTH;
+
+    // Gather the group into lanes
+    alignas(32) float fields[16][W];
+    alignas(32) uint32_t slots[W];
+    for (int lane = 0; lane < W; ++lane)
+    {
+        const Sprite& sprite = *sprites[lane];
+        fields[0][lane] = sprite.position.x;
+        fields[1][lane] = sprite.position.y;
+        fields[2][lane] = sprite.z;
+        fields[3][lane] = sprite.size.x;
+        fields[4][lane] = sprite.size.y;
+        fields[5][lane] = sprite.origin.x;
+        fields[6][lane] = sprite.origin.y;
+        fields[7][lane] = sprite.rotation;
+        fields[8][lane] = sprite.textureRect.x;
+        fields[9][lane] = sprite.textureRect.y;
+        fields[10][lane] = sprite.textureRect.x + sprite.textureRect.width;
+        fields[11][lane] = sprite.textureRect.y + sprite.textureRect.height;
+        fields[12][lane] = sprite.color.r * sprite.color.a;
+        fields[13][lane] = sprite.color.g * sprite.color.a;
+        fields[14][lane] = sprite.color.b * sprite.color.a;
+        fields[15][lane] = sprite.color.a;
+        slots[lane] = textureSlots[lane];
+    }
+
+    F positionX = P::load(fields[0]);
+    F positionY = P::load(fields[1]);
+    F height = P::load(fields[2]);
+    F sizeX = P::load(fields[3]);
+    F sizeY = P::load(fields[4]);
+    F rotation = P::load(fields[7]);
+
+    // Corners relative to the origin, before rotation
+    F left = P::mul(P::sub(P::set(0.0f), P::load(fields[5])), sizeX);
+    F top = P::mul(P::sub(P::set(0.0f), P::load(fields[6])), sizeY);
+    F right = P::add(left, sizeX);
+    F bottom = P::add(top, sizeY);
+    const F cornerX[4] = {left, right, right, left};
+    const F cornerY[4] = {top, top, bottom, bottom};
+
+    F offsetX[4];
+    F offsetY[4];
+    if (P::allZero(rotation))
+    {
+        // Unrotated sprites are the common case; skip the trig entirely
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            offsetX[corner] = cornerX[corner];
+            offsetY[corner] = cornerY[corner];
+        }
+    }
+    else
+    {
+        F sinR;
+        F cosR;
+        sinCos<P>(rotation, sinR, cosR);
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            offsetX[corner] = P::sub(P::mul(cornerX[corner], cosR), P::mul(cornerY[corner], sinR));
+            offsetY[corner] = P::add(P::mul(cornerX[corner], sinR), P::mul(cornerY[corner], cosR));
+        }
+    }
+
+    alignas(32) float x[4][W];
+    alignas(32) float y[4][W];
+    alignas(32) float z[4][W];
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        if (axes.billboard)
+        {
+            // Same operation order as the scalar path's anchor + right * x + down * y
+            P::store(x[corner], P::add(P::add(positionX, P::mul(P::set(axes.right.x), offsetX[corner])),
+                                       P::mul(P::set(axes.down.x), offsetY[corner])));
+            P::store(y[corner], P::add(P::add(positionY, P::mul(P::set(axes.right.y), offsetX[corner])),
+                                       P::mul(P::set(axes.down.y), offsetY[corner])));
+            P::store(z[corner], P::add(P::add(height, P::mul(P::set(axes.right.z), offsetX[corner])),
+                                       P::mul(P::set(axes.down.z), offsetY[corner])));
+        }
+        else
+        {
+            P::store(x[corner], P::add(positionX, offsetX[corner]));
+            P::store(y[corner], P::add(positionY, offsetY[corner]));
+            P::store(z[corner], P::set(0.0f));
+        }
+    }
+
+    // u | v << 16 per corner, and r | g << 8 | b << 16 | a << 24 shared by all four
+    I u0 = packUnorm<P>(P::load(fields[8]), 65535.0f);
+    I v0 = P::template shiftLeft<16>(packUnorm<P>(P::load(fields[9]), 65535.0f));
+    I u1 = packUnorm<P>(P::load(fields[10]), 65535.0f);
+    I v1 = P::template shiftLeft<16>(packUnorm<P>(P::load(fields[11]), 65535.0f));
+    alignas(32) uint32_t uv[4][W];
+    P::store(uv[0], P::bitOr(u0, v0));
+    P::store(uv[1], P::bitOr(u1, v0));
+    P::store(uv[2], P::bitOr(u1, v1));
+    P::store(uv[3], P::bitOr(u0, v1));
+
+    I color = packUnorm<P>(P::load(fields[12]), 255.0f);
+    color = P::bitOr(color, P::template shiftLeft<8>(packUnorm<P>(P::load(fields[13]), 255.0f)));
+    color = P::bitOr(color, P::template shiftLeft<16>(packUnorm<P>(P::load(fields[14]), 255.0f)));
+    color = P::bitOr(color, P::template shiftLeft<24>(packUnorm<P>(P::load(fields[15]), 255.0f)));
+    alignas(32) uint32_t colors[W];
+    P::store(colors, color);
+
+    // Interleave each sprite's quad (96 bytes) and write it as six 16-byte stores
+    for (int lane = 0; lane < W; ++lane)
+    {
+        alignas(16) uint32_t quad[24];
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            uint32_t* vertex = quad + corner * 6;
+            std::memcpy(&vertex[0], &x[corner][lane], sizeof(float));
+            std::memcpy(&vertex[1], &y[corner][lane], sizeof(float));
+            std::memcpy(&vertex[2], &z[corner][lane], sizeof(float));
+            vertex[3] = uv[corner][lane];
+            vertex[4] = colors[lane];
+            vertex[5] = slots[lane];
+        }
+
+        __m128i* destination = reinterpret_cast<__m128i*>(out + lane * 4);
+        for (int i = 0; i < 6; ++i)
+        {
+            __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(quad) + i);
+            if (streaming)
+            {
+                _mm_stream_si128(destination + i, data);
+            }
+            else
+            {
+                _mm_storeu_si128(destination + i, data);
+            }
+        }
+    }
+}
+
+#endif // PENUMBRA_SPRITE_SSE2
+
+} // namespace
+
+void writeSpriteVertices(const Sprite& sprite, uint8_t textureSlot, const SpriteAxes& axes, SpriteVertex* out)
+{
+    // Corners relative to the origin, before rotation
+    float left = -sprite.origin.x * sprite.size.x;
+    float top = -sprite.origin.y * sprite.size.y;
+    float right = left + sprite.size.x;
+    float bottom = top + sprite.size.y;
+
+    float cosR = 1.0f;
+    float sinR = 0.0f;
+    if (sprite.rotation != 0.0f)
+    {
+        cosR = std::cos(sprite.rotation);
+        sinR = std::sin(sprite.rotation);
+    }
+
+    const Math::Rect& uv = sprite.textureRect;
+    const float corners[4][4] = {
+        {left,  top,    uv.x,            uv.y},
+        {right, top,    uv.x + uv.width, uv.y},
+        {right, bottom, uv.x + uv.width, uv.y + uv.height},
+        {left,  bottom, uv.x,            uv.y + uv.height},
+    };
+
+    // Textures are premultiplied, so tint colors must be too
+    const Math::Color& c = sprite.color;
+    const uint8_t r = packUnorm8(c.r * c.a);
+    const uint8_t g = packUnorm8(c.g * c.a);
+    const uint8_t b = packUnorm8(c.b * c.a);
+    const uint8_t a = packUnorm8(c.a);
+
+    const Math::Vec3 anchor(sprite.position, sprite.z);
+
+    // Destination is write-combined GPU memory: write whole vertices, never read back
+    for (const auto& corner : corners)
+    {
+        float offsetX = corner[0] * cosR - corner[1] * sinR;
+        float offsetY = corner[0] * sinR + corner[1] * cosR;
+
+        SpriteVertex vertex;
+        if (axes.billboard)
+        {
+            Math::Vec3 world = anchor + axes.right * offsetX + axes.down * offsetY;
+            vertex.x = world.x;
+            vertex.y = world.y;
+            vertex.z = world.z;
+        }
+        else
+        {
+            vertex.x = sprite.position.x + offsetX;
+            vertex.y = sprite.position.y + offsetY;
+            vertex.z = 0.0f;
+        }
+        vertex.u = packUnorm16(corner[2]);
+        vertex.v = packUnorm16(corner[3]);
+        vertex.r = r;
+        vertex.g = g;
+        vertex.b = b;
+        vertex.a = a;
+        vertex.textureSlot = textureSlot;
+        *out++ = vertex;
+    }
+}
+
+void writeSpriteVerticesBatch(const Sprite* const* sprites, const uint8_t* textureSlots, size_t count,
+                              const SpriteAxes& axes, SpriteVertex* out)
+{
+    size_t i = 0;
+#ifdef PENUMBRA_SPRITE_SSE2
+    // A quad is 96 bytes, so every quad shares the destination's alignment
+    const bool streaming = (reinterpret_cast<uintptr_t>(out) & 15) == 0;
+    for (; i + SpriteKernel::WIDTH <= count; i += SpriteKernel::WIDTH)
+    {
+        writeSpriteGroup<SpriteKernel>(sprites + i, textureSlots + i, axes, out + i * 4, streaming);
+    }
+    if (streaming)
+    {
+        // Streaming stores are weakly ordered; make them visible before the draw reads them
+        _mm_sfence();
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        writeSpriteVertices(*sprites[i], textureSlots[i], axes, out + i * 4);
+    }
+}
+
+const char* getSpriteKernelName()
+{
+#ifdef PENUMBRA_SPRITE_SSE2
+    return SPRITE_KERNEL_NAME;
+#else
+    return "scalar";
+#endif
+}
+
+void writeSpriteInstance(const Sprite& sprite, uint8_t textureSlot, const SpriteAxes& axes, SpriteInstance* out)
+{
+    const Math::Rect& uv = sprite.textureRect;
+    const Math::Color& c = sprite.color;
+
+    SpriteInstance instance;
+    instance.x = sprite.position.x;
+    instance.y = sprite.position.y;
+    instance.z = axes.billboard ? sprite.z : 0.0f;
+    instance.rotation = sprite.rotation;
+    instance.width = sprite.size.x;
+    instance.height = sprite.size.y;
+    instance.u0 = packUnorm16(uv.x);
+    instance.v0 = packUnorm16(uv.y);
+    instance.u1 = packUnorm16(uv.x + uv.width);
+    instance.v1 = packUnorm16(uv.y + uv.height);
+    instance.originX = packUnorm16(sprite.origin.x);
+    instance.originY = packUnorm16(sprite.origin.y);
+    instance.r = packUnorm8(c.r * c.a);
+    instance.g = packUnorm8(c.g * c.a);
+    instance.b = packUnorm8(c.b * c.a);
+    instance.a = packUnorm8(c.a);
+    instance.textureSlot = textureSlot;
+    *out = instance;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,108 @@
+#include "rendering/SpriteCommandBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+SpriteCommandBuffer::SpriteCommandBuffer()
+    : mode(SpriteBatchMode::Vertices)
+    , defaultShader(nullptr)
+    , currentTextureSlot(0)
+    , currentShaderSlot(0)
+{
+    clear();
+}
+
+void SpriteCommandBuffer::begin(SpriteBatchMode batchMode, const SpriteAxes& batchAxes, Resources::Shader* shader)
+{
+    mode = batchMode;
+    axes = batchAxes;
+    defaultShader = shader;
+    clear();
+}
+
+void SpriteCommandBuffer::clear()
+{
+    commands.clear();
+    vertices.clear();
+    instances.clear();
+
+    textureSlots.clear();
+    shaderSlots.clear();
+    textureSlots.push_back(nullptr);
+    shaderSlots.push_back(defaultShader);
+    currentTextureSlot = 0;
+    currentShaderSlot = 0;
+}
+
+void SpriteCommandBuffer::setTexture(Resources::Texture* texture)
+{
+    auto it = std::find(textureSlots.begin(), textureSlots.end(), texture);
+    if (it == textureSlots.end())
+    {
+        // A buffer can't flush early like the batch does
+        if (textureSlots.size() > 0xFFFF)
+        {
+            std::cerr << "SpriteCommandBuffer: more than 65536 textures in one buffer, texture ignored"
+                      << std::endl;
+            return;
+        }
+        it = textureSlots.insert(textureSlots.end(), texture);
+    }
+    currentTextureSlot = static_cast<uint32_t>(it - textureSlots.begin());
+}
+
+void SpriteCommandBuffer::setShader(Resources::Shader* shader)
+{
+    auto it = std::find(shaderSlots.begin(), shaderSlots.end(), shader);
+    if (it == shaderSlots.end())
+    {
+        if (shaderSlots.size() > 0xFF)
+        {
+            std::cerr << "SpriteCommandBuffer: more than 256 shaders in one buffer, shader ignored" << std::endl;
+            return;
+        }
+        it = shaderSlots.insert(shaderSlots.end(), shader);
+    }
+    currentShaderSlot = static_cast<uint32_t>(it - shaderSlots.begin());
+}
+
+void SpriteCommandBuffer::draw(const Sprite& sprite)
+{
+    uint32_t index = static_cast<uint32_t>(commands.size());
+    commands.push_back({makeSortKey(sprite.layer, sprite.depth, currentTextureSlot, currentShaderSlot), index});
+
+    // The transform is the expensive part of a sprite, so it runs here on the recording thread
+    if (mode == SpriteBatchMode::Instanced)
+    {
+        instances.emplace_back();
+        writeSpriteInstance(sprite, 0, axes, &instances.back());
+    }
+    else
+    {
+        vertices.resize(vertices.size() + 4);
+        writeSpriteVertices(sprite, 0, axes, &vertices[vertices.size() - 4]);
+    }
+}
+
+SpriteInstance* SpriteCommandBuffer::drawInstances(size_t count, int layer, float depth)
+{
+    assert(mode == SpriteBatchMode::Instanced && "drawInstances() needs an instanced buffer");
+
+    // One key for the whole run, so the batch draws it in record order
+    uint64_t key = makeSortKey(layer, depth, currentTextureSlot, currentShaderSlot);
+    uint32_t first = static_cast<uint32_t>(commands.size());
+    commands.resize(commands.size() + count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        commands[first + i] = {key, first + static_cast<uint32_t>(i)};
+    }
+
+    instances.resize(instances.size() + count);
+    return instances.data() + first;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
@@ -0,0 +1,189 @@
+#include "rendering/StreamBuffer.h"
+#include "rendering/GLState.h"
+#include "core/OpenGL.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Fence wait slice; the loop keeps waiting, this only bounds each call
+constexpr GLuint64 FENCE_TIMEOUT_NS = 1000000;
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+StreamBuffer::StreamBuffer()
+    : target(0)
+    , buffer(0)
+    , segmentSize(0)
+    , alignment(1)
+    , cursor(0)
+    , segment(0)
+    , persistent(false)
+    , mapped(false)
+    , persistentData(nullptr)
+    , fences{}
+    , stats{0, 0, 0}
+{
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (void*& fence : fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+    if (buffer != 0)
+    {
+        if (persistent || mapped)
+        {
+            glBindBuffer(target, buffer);
+            glUnmapBuffer(target);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+}
+
+void StreamBuffer::initialize(unsigned int bufferTarget, size_t bytesPerSegment, size_t offsetAlignment)
+{
+    target = bufferTarget;
+    segmentSize = bytesPerSegment;
+    alignment = std::max<size_t>(offsetAlignment, 1);
+    cursor = 0;
+    segment = 0;
+    stats = Stats{0, 0, 0};
+
+    size_t totalSize = segmentSize * SEGMENT_COUNT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    persistent = hasGLVersion(4, 4) || hasGLExtension("GL_ARB_buffer_storage");
+    if (persistent)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, static_cast<GLsizeiptr>(totalSize), nullptr, flags);
+        persistentData = static_cast<unsigned char*>(
+            glMapBufferRange(target, 0, static_cast<GLsizeiptr>(totalSize), flags));
+        persistent = persistentData != nullptr;
+    }
+#endif
+
+    if (!persistent)
+    {
+        glBufferData(target, static_cast<GLsizeiptr>(totalSize), nullptr, GL_STREAM_DRAW);
+    }
+
+    std::cout << "Stream buffer: " << (totalSize / 1024) << " KB, "
+              << (persistent ? "persistent mapping" : "orphaning") << std::endl;
+}
+
+void* StreamBuffer::reserve(size_t minBytes, size_t& outAvailable)
+{
+    cursor = alignUp(cursor, alignment);
+
+    if (persistent)
+    {
+        size_t segmentEnd = (segment + 1) * segmentSize;
+        if (cursor + minBytes > segmentEnd)
+        {
+            enterSegment((segment + 1) % SEGMENT_COUNT);
+            segmentEnd = cursor + segmentSize;
+        }
+        outAvailable = segmentEnd - cursor;
+        return persistentData + cursor;
+    }
+
+    // Fallback: everything before the cursor may still be read by the GPU,
+    // everything after it is untouched since the last orphan
+    size_t totalSize = segmentSize * SEGMENT_COUNT;
+    glBindBuffer(target, buffer);
+    if (cursor + minBytes > totalSize)
+    {
+        glBufferData(target, static_cast<GLsizeiptr>(totalSize), nullptr, GL_STREAM_DRAW);
+        cursor = 0;
+        ++stats.orphans;
+    }
+
+    outAvailable = std::min(totalSize - cursor, segmentSize);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                             GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+    void* data = glMapBufferRange(target, static_cast<GLintptr>(cursor),
+                                  static_cast<GLsizeiptr>(outAvailable), flags);
+    mapped = data != nullptr;
+    if (!mapped)
+    {
+        outAvailable = 0;
+    }
+    return data;
+}
+
+size_t StreamBuffer::commit(size_t bytes)
+{
+    size_t offset = cursor;
+
+    if (mapped)
+    {
+        glBindBuffer(target, buffer);
+        if (bytes > 0)
+        {
+            glFlushMappedBufferRange(target, 0, static_cast<GLsizeiptr>(bytes));
+        }
+        glUnmapBuffer(target);
+        mapped = false;
+    }
+
+    cursor += bytes;
+    stats.bytesStreamed += bytes;
+    return offset;
+}
+
+void StreamBuffer::enterSegment(size_t next)
+{
+    // Fence the segment being left: it is complete once the GPU passes this point
+    if (fences[segment] != nullptr)
+    {
+        glDeleteSync(static_cast<GLsync>(fences[segment]));
+    }
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    segment = next;
+    cursor = segment * segmentSize;
+    waitFence(segment);
+}
+
+void StreamBuffer::waitFence(size_t index)
+{
+    GLsync fence = static_cast<GLsync>(fences[index]);
+    if (fence == nullptr)
+    {
+        return;
+    }
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        ++stats.fenceWaits;
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    glDeleteSync(fence);
+    fences[index] = nullptr;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
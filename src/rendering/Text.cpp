@@ -0,0 +1,166 @@
+#include "rendering/Text.h"
+#include <algorithm>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+constexpr uint32_t REPLACEMENT = '?';
+
+/**
+ * Decode the UTF-8 sequence at text[index] and advance index past it
+ * Malformed bytes decode as REPLACEMENT
+ */
+uint32_t decodeUtf8(const std::string& text, size_t& index)
+{
+    uint8_t lead = static_cast<uint8_t>(text[index++]);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    size_t extra = 0;
+    uint32_t codepoint = 0;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        codepoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        codepoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        return REPLACEMENT;
+    }
+
+    for (size_t i = 0; i < extra; ++i)
+    {
+        if (index >= text.size() || (static_cast<uint8_t>(text[index]) & 0xC0) != 0x80)
+        {
+            return REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (static_cast<uint8_t>(text[index++]) & 0x3F);
+    }
+    return codepoint;
+}
+
+} // namespace
+
+TextLayout::TextLayout()
+    : font(nullptr)
+    , fontRevision(0)
+    , wrapWidth(0.0f)
+    , size(0.0f, 0.0f)
+    , lineCount(0)
+{
+}
+
+bool TextLayout::set(const Font& newFont, const std::string& newText, float newWrapWidth)
+{
+    if (font == &newFont && fontRevision == newFont.getRevision() && wrapWidth == newWrapWidth &&
+        text == newText)
+    {
+        return false;
+    }
+
+    font = &newFont;
+    fontRevision = newFont.getRevision();
+    wrapWidth = newWrapWidth;
+    text = newText;
+    layout();
+    return true;
+}
+
+void TextLayout::layout()
+{
+    quads.clear();
+    size = Math::Vec2(0.0f, 0.0f);
+    lineCount = text.empty() ? 0 : 1;
+
+    const size_t NO_BREAK = static_cast<size_t>(-1);
+    float lineHeight = font->getLineHeight();
+    float penX = 0.0f;
+    float penY = 0.0f;
+    size_t breakQuad = NO_BREAK;  // First quad after the last space on this line
+    float breakX = 0.0f;          // Pen position after that space
+    uint32_t previous = 0;
+
+    size_t index = 0;
+    while (index < text.size())
+    {
+        uint32_t codepoint = decodeUtf8(text, index);
+        if (codepoint == '\n')
+        {
+            penX = 0.0f;
+            penY += lineHeight;
+            breakQuad = NO_BREAK;
+            previous = 0;
+            ++lineCount;
+            continue;
+        }
+
+        const Glyph* glyph = font->getGlyph(codepoint);
+        if (glyph == nullptr)
+        {
+            codepoint = REPLACEMENT;
+            glyph = font->getGlyph(codepoint);
+            if (glyph == nullptr)
+            {
+                continue;
+            }
+        }
+
+        if (previous != 0)
+        {
+            penX += font->getKerning(previous, codepoint);
+        }
+        previous = codepoint;
+
+        if (codepoint == ' ')
+        {
+            penX += glyph->advance;
+            breakQuad = quads.size();
+            breakX = penX;
+            continue;
+        }
+
+        // Move the word being written to a new line if it would overflow
+        if (wrapWidth > 0.0f && breakQuad != NO_BREAK && penX + glyph->offset.x + glyph->size.x > wrapWidth)
+        {
+            for (size_t i = breakQuad; i < quads.size(); ++i)
+            {
+                quads[i].position.x -= breakX;
+                quads[i].position.y += lineHeight;
+            }
+            penX -= breakX;
+            penY += lineHeight;
+            breakQuad = NO_BREAK;
+            ++lineCount;
+        }
+
+        if (glyph->size.x > 0.0f && glyph->size.y > 0.0f)
+        {
+            quads.push_back({Math::Vec2(penX + glyph->offset.x, penY + glyph->offset.y), glyph->size,
+                             glyph->textureRect});
+        }
+        penX += glyph->advance;
+    }
+
+    for (const GlyphQuad& quad : quads)
+    {
+        size.x = std::max(size.x, quad.position.x + quad.size.x);
+    }
+    size.y = static_cast<float>(lineCount) * lineHeight;
+}
+
+} // namespace Rendering
+} // namespace Penumbra
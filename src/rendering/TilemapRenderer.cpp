@@ -0,0 +1,630 @@
+#include "rendering/TilemapRenderer.h"
+#include "rendering/Camera.h"
+#include "rendering/GLState.h"
+#include "rendering/IsometricCamera.h"
+#include "rendering/Renderer.h"
+#include "rendering/Shaders.h"
+#include "core/OpenGL.h"
+#include "game/TileGrid.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+namespace Penumbra {
+namespace Rendering {
+
+namespace {
+
+// Default margin: one tile plus the largest shake we use
+constexpr float DEFAULT_CULL_MARGIN = 32.0f;
+
+// Enough to absorb a few edits per frame without a visible hitch
+constexpr size_t DEFAULT_REBUILD_BUDGET = 4;
+
+constexpr size_t CHUNK_TILES = static_cast<size_t>(Game::TileGrid::CHUNK_SIZE) * Game::TileGrid::CHUNK_SIZE;
+
+// Chunk meshes share one 16-bit quad index buffer
+constexpr size_t MAX_CHUNK_QUADS = 65536 / 4;
+static_assert(CHUNK_TILES <= MAX_CHUNK_QUADS, "A flat chunk must fit the shared index buffer");
+
+// Per-face brightness so block sides read apart without lighting (Game::TileFace order)
+constexpr float FACE_SHADE[] = {1.0f, 0.8f, 0.65f, 0.8f, 0.65f};
+
+// Outward normals in Game::TileFace order
+const Math::Vec3 FACE_NORMALS[] = {
+    Math::Vec3(0.0f, 0.0f, 1.0f),
+    Math::Vec3(0.0f, -1.0f, 0.0f),
+    Math::Vec3(1.0f, 0.0f, 0.0f),
+    Math::Vec3(0.0f, 1.0f, 0.0f),
+    Math::Vec3(-1.0f, 0.0f, 0.0f),
+};
+
+/**
+ * Same layout as SpriteVertex, so the default sprite shaders draw chunks
+ */
+struct TileVertex {
+    float x, y, z;
+    uint16_t u, v;
+    uint8_t r, g, b, a;  // Premultiplied
+    uint8_t textureSlot;
+    uint8_t padding[3];
+};
+static_assert(sizeof(TileVertex) == 24, "TileVertex must match SpriteVertex");
+
+uint16_t packUnorm16(float value)
+{
+    return static_cast<uint16_t>(Math::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+uint8_t packUnorm8(float value)
+{
+    return static_cast<uint8_t>(Math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/**
+ * Tileset cell for a tile, in normalized texture coordinates
+ */
+Math::Rect tileTextureRect(const Game::Tile& tile, int columns, int rows)
+{
+    const float cellWidth = 1.0f / static_cast<float>(columns);
+    const float cellHeight = 1.0f / static_cast<float>(rows);
+    int cell = Math::clamp(tile.textureIndex, 0, columns * rows - 1);
+    return Math::Rect(static_cast<float>(cell % columns) * cellWidth,
+                      static_cast<float>(cell / columns) * cellHeight,
+                      cellWidth, cellHeight);
+}
+
+/**
+ * Append a quad; corners run top-left, top-right, bottom-right, bottom-left
+ * as seen from in front of the face
+ */
+void appendQuad(std::vector<TileVertex>& vertices, const Math::Vec3 (&corners)[4], const Math::Rect& uv,
+                const Math::Color& tint, float shade, uint8_t textureSlot)
+{
+    const float texCoords[4][2] = {
+        {uv.x,            uv.y},
+        {uv.x + uv.width, uv.y},
+        {uv.x + uv.width, uv.y + uv.height},
+        {uv.x,            uv.y + uv.height},
+    };
+
+    // Premultiplied, like every other sprite color
+    const uint8_t r = packUnorm8(tint.r * tint.a * shade);
+    const uint8_t g = packUnorm8(tint.g * tint.a * shade);
+    const uint8_t b = packUnorm8(tint.b * tint.a * shade);
+    const uint8_t a = packUnorm8(tint.a);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        TileVertex vertex = {};
+        vertex.x = corners[i].x;
+        vertex.y = corners[i].y;
+        vertex.z = corners[i].z;
+        vertex.u = packUnorm16(texCoords[i][0]);
+        vertex.v = packUnorm16(texCoords[i][1]);
+        vertex.r = r;
+        vertex.g = g;
+        vertex.b = b;
+        vertex.a = a;
+        vertex.textureSlot = textureSlot;
+        vertices.push_back(vertex);
+    }
+}
+
+/**
+ * Corners of one face of the block spanning [min, max]
+ */
+void blockFaceCorners(Game::TileFace face, const Math::Vec3& min, const Math::Vec3& max, Math::Vec3 (&out)[4])
+{
+    switch (face)
+    {
+        case Game::TileFace::Top:
+            out[0] = Math::Vec3(min.x, min.y, max.z);
+            out[1] = Math::Vec3(max.x, min.y, max.z);
+            out[2] = Math::Vec3(max.x, max.y, max.z);
+            out[3] = Math::Vec3(min.x, max.y, max.z);
+            break;
+        case Game::TileFace::North:
+            out[0] = Math::Vec3(max.x, min.y, max.z);
+            out[1] = Math::Vec3(min.x, min.y, max.z);
+            out[2] = Math::Vec3(min.x, min.y, min.z);
+            out[3] = Math::Vec3(max.x, min.y, min.z);
+            break;
+        case Game::TileFace::East:
+            out[0] = Math::Vec3(max.x, max.y, max.z);
+            out[1] = Math::Vec3(max.x, min.y, max.z);
+            out[2] = Math::Vec3(max.x, min.y, min.z);
+            out[3] = Math::Vec3(max.x, max.y, min.z);
+            break;
+        case Game::TileFace::South:
+            out[0] = Math::Vec3(min.x, max.y, max.z);
+            out[1] = Math::Vec3(max.x, max.y, max.z);
+            out[2] = Math::Vec3(max.x, max.y, min.z);
+            out[3] = Math::Vec3(min.x, max.y, min.z);
+            break;
+        case Game::TileFace::West:
+            out[0] = Math::Vec3(min.x, min.y, max.z);
+            out[1] = Math::Vec3(min.x, max.y, max.z);
+            out[2] = Math::Vec3(min.x, max.y, min.z);
+            out[3] = Math::Vec3(min.x, min.y, min.z);
+            break;
+    }
+}
+
+} // namespace
+
+TilemapRenderer::TilemapRenderer()
+    : tileset(nullptr)
+    , columns(1)
+    , rows(1)
+    , layer(0)
+    , cullMargin(DEFAULT_CULL_MARGIN)
+    , rebuildBudget(DEFAULT_REBUILD_BUDGET)
+    , cellsVisited(0)
+    , tilesDrawn(0)
+    , chunksDrawn(0)
+    , chunksRebuilt(0)
+    , facesDrawn(0)
+    , state(nullptr)
+    , EBO(0)
+    , chunkGrid(nullptr)
+    , chunkColumns(0)
+    , chunkRows(0)
+{
+}
+
+TilemapRenderer::~TilemapRenderer()
+{
+    releaseChunks();
+    if (EBO != 0)
+    {
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+void TilemapRenderer::initialize(GLStateCache& stateCache)
+{
+    state = &stateCache;
+
+    // Chunks are baked in world space, so the plain vertex path's shader applies
+    // regardless of the sprite batch's mode
+    if (!chunkShader.loadFromSource(Shaders::DEFAULT_VERTEX_SHADER, Shaders::DEFAULT_FRAGMENT_SHADER))
+    {
+        std::cerr << "TilemapRenderer: failed to create chunk shader" << std::endl;
+    }
+
+    // Every chunk shares one quad index buffer; face groups draw sub-ranges of it
+    std::vector<uint16_t> indices(MAX_CHUNK_QUADS * 6);
+    for (size_t i = 0; i < MAX_CHUNK_QUADS; ++i)
+    {
+        uint16_t base = static_cast<uint16_t>(i * 4);
+        indices[i * 6 + 0] = base;
+        indices[i * 6 + 1] = static_cast<uint16_t>(base + 1);
+        indices[i * 6 + 2] = static_cast<uint16_t>(base + 2);
+        indices[i * 6 + 3] = static_cast<uint16_t>(base + 2);
+        indices[i * 6 + 4] = static_cast<uint16_t>(base + 3);
+        indices[i * 6 + 5] = base;
+    }
+
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint16_t)),
+                 indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void TilemapRenderer::setTileset(Resources::Texture* texture, int tilesetColumns, int tilesetRows)
+{
+    tilesetColumns = std::max(tilesetColumns, 1);
+    tilesetRows = std::max(tilesetRows, 1);
+    if (tilesetColumns != columns || tilesetRows != rows || (texture == nullptr) != (tileset == nullptr))
+    {
+        // Baked UVs and texture slots no longer match
+        for (Chunk& chunk : chunks)
+        {
+            chunk.revision = 0;
+        }
+    }
+
+    tileset = texture;
+    columns = tilesetColumns;
+    rows = tilesetRows;
+}
+
+void TilemapRenderer::draw(SpriteBatch& batch, const Game::TileGrid& grid, const Camera& camera)
+{
+    cellsVisited = 0;
+    tilesDrawn = 0;
+
+    int minX, minY, maxX, maxY;
+    grid.getCellRange(camera.getVisibleBounds(cullMargin), minX, minY, maxX, maxY);
+    if (minX >= maxX || minY >= maxY)
+    {
+        return;
+    }
+    cellsVisited = static_cast<size_t>(maxX - minX) * static_cast<size_t>(maxY - minY);
+
+    batch.setTexture(tileset);
+    queueTiles(batch, grid, minX, minY, maxX, maxY);
+}
+
+void TilemapRenderer::queueTiles(SpriteBatch& batch, const Game::TileGrid& grid,
+                                 int minX, int minY, int maxX, int maxY)
+{
+    const float tileSize = static_cast<float>(grid.getTileSize());
+
+    Sprite sprite;
+    sprite.size = Math::Vec2(tileSize, tileSize);
+    sprite.origin = Math::Vec2(0.0f, 0.0f);
+    sprite.layer = layer;
+
+    for (int y = minY; y < maxY; ++y)
+    {
+        const Game::Tile* row = grid.getRow(y);
+        sprite.position.y = static_cast<float>(y) * tileSize;
+
+        for (int x = minX; x < maxX; ++x)
+        {
+            const Game::Tile& tile = row[x];
+            if (tile.type == Game::TileType::Empty)
+            {
+                continue;
+            }
+
+            sprite.position.x = static_cast<float>(x) * tileSize;
+            sprite.textureRect = tileTextureRect(tile, columns, rows);
+            sprite.color = tile.tint;
+            batch.draw(sprite);
+            ++tilesDrawn;
+        }
+    }
+}
+
+void TilemapRenderer::drawRetained(SpriteBatch& batch, const Game::TileGrid& grid, const Camera& camera)
+{
+    if (state == nullptr || EBO == 0)
+    {
+        draw(batch, grid, camera);
+        return;
+    }
+
+    cellsVisited = 0;
+    tilesDrawn = 0;
+    chunksDrawn = 0;
+    chunksRebuilt = 0;
+    facesDrawn = 0;
+    bindChunkTable(grid);
+
+    int minX, minY, maxX, maxY;
+    grid.getCellRange(camera.getVisibleBounds(cullMargin), minX, minY, maxX, maxY);
+    if (minX >= maxX || minY >= maxY)
+    {
+        return;
+    }
+    cellsVisited = static_cast<size_t>(maxX - minX) * static_cast<size_t>(maxY - minY);
+
+    const int chunkSize = Game::TileGrid::CHUNK_SIZE;
+    const int minChunkX = minX / chunkSize;
+    const int minChunkY = minY / chunkSize;
+    const int maxChunkX = (maxX - 1) / chunkSize + 1;
+    const int maxChunkY = (maxY - 1) / chunkSize + 1;
+
+    // Keep earlier sprites beneath the tiles
+    batch.flush();
+    batch.setTexture(tileset);
+
+    // Re-bake stale visible chunks within budget; the rest go through the
+    // batch this frame so edits never show a stale mesh
+    size_t budget = rebuildBudget;
+    for (int chunkY = minChunkY; chunkY < maxChunkY; ++chunkY)
+    {
+        for (int chunkX = minChunkX; chunkX < maxChunkX; ++chunkX)
+        {
+            Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                  static_cast<size_t>(chunkX)];
+            if (chunk.revision == grid.getChunkRevision(chunkX, chunkY) && !chunk.blocks)
+            {
+                continue;
+            }
+
+            if (budget > 0)
+            {
+                rebuildChunk(chunk, grid, chunkX, chunkY, false);
+                --budget;
+                ++chunksRebuilt;
+            }
+            else
+            {
+                queueTiles(batch, grid,
+                           std::max(chunkX * chunkSize, minX), std::max(chunkY * chunkSize, minY),
+                           std::min((chunkX + 1) * chunkSize, maxX), std::min((chunkY + 1) * chunkSize, maxY));
+            }
+        }
+    }
+
+    bindChunkProgram();
+    for (int chunkY = minChunkY; chunkY < maxChunkY; ++chunkY)
+    {
+        for (int chunkX = minChunkX; chunkX < maxChunkX; ++chunkX)
+        {
+            const Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                        static_cast<size_t>(chunkX)];
+            if (chunk.blocks || chunk.groupCount[0] == 0 ||
+                chunk.revision != grid.getChunkRevision(chunkX, chunkY))
+            {
+                continue;
+            }
+
+            state->bindVertexArray(chunk.VAO);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(chunk.groupCount[0] * 6), GL_UNSIGNED_SHORT, nullptr);
+            ++chunksDrawn;
+            facesDrawn += chunk.groupCount[0];
+        }
+    }
+}
+
+void TilemapRenderer::drawIsometric(SpriteBatch& batch, const Game::TileGrid& grid, const IsometricCamera& camera)
+{
+    cellsVisited = 0;
+    tilesDrawn = 0;
+    chunksDrawn = 0;
+    chunksRebuilt = 0;
+    facesDrawn = 0;
+    if (state == nullptr || EBO == 0)
+    {
+        return;
+    }
+    bindChunkTable(grid);
+
+    // Footprint of the view between the ground and the top of the highest level
+    const float tileSize = static_cast<float>(grid.getTileSize());
+    const float heights[2] = {0.0f, static_cast<float>(grid.getLevels()) * tileSize};
+    const float screenX[2] = {0.0f, camera.getViewportWidth()};
+    const float screenY[2] = {0.0f, camera.getViewportHeight()};
+    Math::Vec2 footprintMin(std::numeric_limits<float>::max());
+    Math::Vec2 footprintMax(std::numeric_limits<float>::lowest());
+    for (float height : heights)
+    {
+        for (float x : screenX)
+        {
+            for (float y : screenY)
+            {
+                Math::Vec3 world = camera.screenToWorld(x, y, height);
+                footprintMin = glm::min(footprintMin, Math::Vec2(world.x, world.y));
+                footprintMax = glm::max(footprintMax, Math::Vec2(world.x, world.y));
+            }
+        }
+    }
+    Math::Vec2 border(cullMargin, cullMargin);
+
+    int minX, minY, maxX, maxY;
+    grid.getCellRange(Math::AABB(footprintMin - border, footprintMax + border), minX, minY, maxX, maxY);
+    if (minX >= maxX || minY >= maxY)
+    {
+        return;
+    }
+    cellsVisited = static_cast<size_t>(maxX - minX) * static_cast<size_t>(maxY - minY) *
+                   static_cast<size_t>(grid.getLevels());
+
+    const int chunkSize = Game::TileGrid::CHUNK_SIZE;
+    const int minChunkX = minX / chunkSize;
+    const int minChunkY = minY / chunkSize;
+    const int maxChunkX = (maxX - 1) / chunkSize + 1;
+    const int maxChunkY = (maxY - 1) / chunkSize + 1;
+
+    batch.flush();
+
+    size_t budget = rebuildBudget;
+    for (int chunkY = minChunkY; chunkY < maxChunkY && budget > 0; ++chunkY)
+    {
+        for (int chunkX = minChunkX; chunkX < maxChunkX && budget > 0; ++chunkX)
+        {
+            Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                  static_cast<size_t>(chunkX)];
+            if (chunk.revision != grid.getChunkRevision(chunkX, chunkY) || !chunk.blocks)
+            {
+                rebuildChunk(chunk, grid, chunkX, chunkY, true);
+                --budget;
+                ++chunksRebuilt;
+            }
+        }
+    }
+
+    // Only faces turned towards this view are drawn; during a quarter turn
+    // that is whichever sides the animated yaw currently shows
+    bool facing[FACE_GROUPS];
+    for (int group = 0; group < FACE_GROUPS; ++group)
+    {
+        facing[group] = camera.isFacing(FACE_NORMALS[group]);
+    }
+
+    bindChunkProgram();
+    for (int chunkY = minChunkY; chunkY < maxChunkY; ++chunkY)
+    {
+        for (int chunkX = minChunkX; chunkX < maxChunkX; ++chunkX)
+        {
+            const Chunk& chunk = chunks[static_cast<size_t>(chunkY) * static_cast<size_t>(chunkColumns) +
+                                        static_cast<size_t>(chunkX)];
+            if (!chunk.blocks)
+            {
+                continue;
+            }
+
+            GLsizei counts[FACE_GROUPS];
+            const void* offsets[FACE_GROUPS];
+            GLsizei drawCount = 0;
+            for (int group = 0; group < FACE_GROUPS; ++group)
+            {
+                if (!facing[group] || chunk.groupCount[group] == 0)
+                {
+                    continue;
+                }
+                counts[drawCount] = static_cast<GLsizei>(chunk.groupCount[group] * 6);
+                offsets[drawCount] = reinterpret_cast<const void*>(
+                    static_cast<uintptr_t>(chunk.groupStart[group]) * 6 * sizeof(uint16_t));
+                ++drawCount;
+                facesDrawn += chunk.groupCount[group];
+            }
+            if (drawCount == 0)
+            {
+                continue;
+            }
+
+            state->bindVertexArray(chunk.VAO);
+            glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_SHORT, offsets, drawCount);
+            ++chunksDrawn;
+        }
+    }
+}
+
+void TilemapRenderer::bindChunkProgram()
+{
+    state->useProgram(chunkShader.getID());
+    if (tileset != nullptr)
+    {
+        state->bindTexture(0, tileset->getID());
+    }
+}
+
+void TilemapRenderer::bindChunkTable(const Game::TileGrid& grid)
+{
+    if (chunkGrid == &grid && chunkColumns == grid.getChunkColumns() && chunkRows == grid.getChunkRows())
+    {
+        return;
+    }
+
+    releaseChunks();
+    chunkGrid = &grid;
+    chunkColumns = grid.getChunkColumns();
+    chunkRows = grid.getChunkRows();
+    chunks.assign(static_cast<size_t>(chunkColumns) * static_cast<size_t>(chunkRows), Chunk{});
+}
+
+void TilemapRenderer::releaseChunks()
+{
+    for (Chunk& chunk : chunks)
+    {
+        if (chunk.VAO != 0)
+        {
+            glDeleteVertexArrays(1, &chunk.VAO);
+        }
+        if (chunk.VBO != 0)
+        {
+            glDeleteBuffers(1, &chunk.VBO);
+        }
+    }
+    chunks.clear();
+    chunkGrid = nullptr;
+    chunkColumns = 0;
+    chunkRows = 0;
+
+    // Deleted VAO names may be reused; don't let the cache skip binding them
+    if (state != nullptr)
+    {
+        state->invalidate();
+    }
+}
+
+void TilemapRenderer::rebuildChunk(Chunk& chunk, const Game::TileGrid& grid, int chunkX, int chunkY, bool blocks)
+{
+    const int chunkSize = Game::TileGrid::CHUNK_SIZE;
+    const int minX = chunkX * chunkSize;
+    const int minY = chunkY * chunkSize;
+    const int maxX = std::min(minX + chunkSize, grid.getWidth());
+    const int maxY = std::min(minY + chunkSize, grid.getHeight());
+    const int levels = blocks ? grid.getLevels() : 1;
+    const float tileSize = static_cast<float>(grid.getTileSize());
+    const uint8_t textureSlot = static_cast<uint8_t>(tileset != nullptr ? 0 : Shaders::TEXTURE_SLOT_NONE);
+
+    // Flat meshes are one group of tiles lying at z = 0; block meshes hold
+    // every exposed face, grouped by direction
+    const int groups = blocks ? FACE_GROUPS : 1;
+    std::vector<TileVertex> vertices;
+    vertices.reserve(CHUNK_TILES * 4);
+    bool truncated = false;
+
+    for (int group = 0; group < FACE_GROUPS; ++group)
+    {
+        chunk.groupStart[group] = static_cast<uint32_t>(vertices.size() / 4);
+        for (int z = 0; z < levels && group < groups; ++z)
+        {
+            for (int y = minY; y < maxY; ++y)
+            {
+                const Game::Tile* row = grid.getRow(y, z);
+                for (int x = minX; x < maxX; ++x)
+                {
+                    const Game::TileFace face = static_cast<Game::TileFace>(group);
+                    bool visible = blocks ? grid.isFaceExposed(x, y, z, face)
+                                          : row[x].type != Game::TileType::Empty;
+                    if (!visible)
+                    {
+                        continue;
+                    }
+                    if (vertices.size() / 4 == MAX_CHUNK_QUADS)
+                    {
+                        truncated = true;
+                        continue;
+                    }
+
+                    Math::Vec3 min(static_cast<float>(x) * tileSize, static_cast<float>(y) * tileSize,
+                                   static_cast<float>(z) * tileSize);
+                    Math::Vec3 max = min + Math::Vec3(tileSize, tileSize, tileSize);
+                    if (!blocks)
+                    {
+                        // Top face at ground height is exactly the flat 2D quad
+                        max.z = 0.0f;
+                    }
+
+                    Math::Vec3 corners[4];
+                    blockFaceCorners(face, min, max, corners);
+                    appendQuad(vertices, corners, tileTextureRect(row[x], columns, rows), row[x].tint,
+                               FACE_SHADE[group], textureSlot);
+                }
+            }
+        }
+        chunk.groupCount[group] = static_cast<uint32_t>(vertices.size() / 4) - chunk.groupStart[group];
+    }
+
+    if (truncated)
+    {
+        std::cerr << "TilemapRenderer: chunk (" << chunkX << ", " << chunkY << ") exceeds "
+                  << MAX_CHUNK_QUADS << " faces, extra faces dropped" << std::endl;
+    }
+
+    chunk.revision = grid.getChunkRevision(chunkX, chunkY);
+    chunk.blocks = blocks;
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    if (chunk.VAO == 0)
+    {
+        glGenVertexArrays(1, &chunk.VAO);
+        glGenBuffers(1, &chunk.VBO);
+
+        state->bindVertexArray(chunk.VAO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TileVertex),
+                              reinterpret_cast<void*>(offsetof(TileVertex, x)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(TileVertex),
+                              reinterpret_cast<void*>(offsetof(TileVertex, u)));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TileVertex),
+                              reinterpret_cast<void*>(offsetof(TileVertex, r)));
+        glEnableVertexAttribArray(3);
+        glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(TileVertex),
+                               reinterpret_cast<void*>(offsetof(TileVertex, textureSlot)));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(TileVertex)),
+                 vertices.data(), GL_STATIC_DRAW);
+}
+
+} // namespace Rendering
+} // namespace Penumbra
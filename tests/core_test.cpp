@@ -1,7 +1,16 @@
 #include <gtest/gtest.h>
 #include "core/Math.h"
+#include "core/Handle.h"
+#include "core/CookedAssets.h"
+#include "core/JobSystem.h"
+#include "core/FrameStats.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 using namespace Penumbra::Math;
+using namespace Penumbra::Resources;
 
 class MathTest : public ::testing::Test {
 protected:
@@ -81,6 +90,288 @@ TEST_F(MathTest, ColorConstruction) {
     EXPECT_FLOAT_EQ(whiteVec.a, 1.0f);
 }
 
+struct PooledValue {
+    int value;
+    explicit PooledValue(int v) : value(v) {}
+};
+
+TEST(HandlePoolTest, InsertAndResolve) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(1));
+    Handle<PooledValue> b = pool.insert(std::make_unique<PooledValue>(2));
+
+    ASSERT_TRUE(pool.isValid(a));
+    ASSERT_TRUE(pool.isValid(b));
+    EXPECT_EQ(pool.get(a)->value, 1);
+    EXPECT_EQ(pool.get(b)->value, 2);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(HandlePoolTest, NullHandle) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> none;
+
+    EXPECT_TRUE(none.isNull());
+    EXPECT_FALSE(pool.isValid(none));
+    EXPECT_EQ(pool.get(none), nullptr);
+}
+
+TEST(HandlePoolTest, RemovedHandleBecomesStale) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(1));
+    pool.remove(a);
+
+    EXPECT_FALSE(pool.isValid(a));
+    EXPECT_TRUE(pool.empty());
+
+    // Slot is reused, but the old handle must not resolve to the new resource
+    Handle<PooledValue> b = pool.insert(std::make_unique<PooledValue>(2));
+    EXPECT_EQ(b.index, a.index);
+    EXPECT_NE(b.generation, a.generation);
+    EXPECT_FALSE(pool.isValid(a));
+    EXPECT_EQ(pool.get(b)->value, 2);
+}
+
+TEST(HandlePoolTest, TakeDetachesResource) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(7));
+    std::unique_ptr<PooledValue> taken = pool.take(a);
+
+    ASSERT_NE(taken, nullptr);
+    EXPECT_EQ(taken->value, 7);
+    EXPECT_FALSE(pool.isValid(a));
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.take(a), nullptr);
+}
+
+TEST(HandlePoolTest, ClearInvalidatesAllHandles) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(1));
+    Handle<PooledValue> b = pool.insert(std::make_unique<PooledValue>(2));
+    pool.clear();
+
+    EXPECT_FALSE(pool.isValid(a));
+    EXPECT_FALSE(pool.isValid(b));
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.capacity(), 2u);
+}
+
+TEST(HandlePoolTest, ReferenceCounting) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(1));
+
+    EXPECT_EQ(pool.refCount(a), 0u);
+    pool.addRef(a);
+    pool.addRef(a);
+    EXPECT_EQ(pool.refCount(a), 2u);
+    pool.release(a);
+    pool.release(a);
+    pool.release(a);
+    EXPECT_EQ(pool.refCount(a), 0u);
+}
+
+TEST(HandlePoolTest, UsageStamp) {
+    HandlePool<PooledValue> pool;
+    Handle<PooledValue> a = pool.insert(std::make_unique<PooledValue>(1));
+
+    EXPECT_EQ(pool.lastUsed(a), 0u);
+    ASSERT_NE(pool.get(a, 42), nullptr);
+    EXPECT_EQ(pool.lastUsed(a), 42u);
+
+    // Reused slots start fresh
+    pool.addRef(a);
+    pool.remove(a);
+    Handle<PooledValue> b = pool.insert(std::make_unique<PooledValue>(2));
+    EXPECT_EQ(pool.lastUsed(b), 0u);
+    EXPECT_EQ(pool.refCount(b), 0u);
+}
+
+class CookedAssetsTest : public ::testing::Test {
+protected:
+    std::string tempPath(const char* name) const {
+        return ::testing::TempDir() + name;
+    }
+};
+
+TEST_F(CookedAssetsTest, TextureRoundTrip) {
+    Penumbra::Assets::CookedTexture texture;
+    texture.width = 2;
+    texture.height = 2;
+    texture.levels.push_back({2, 2, 0, 16});
+    texture.levels.push_back({1, 1, 16, 4});
+    for (int i = 0; i < 20; ++i) {
+        texture.pixels.push_back(static_cast<uint8_t>(i));
+    }
+
+    std::string path = tempPath("roundtrip.ptex");
+    ASSERT_TRUE(Penumbra::Assets::writeTexture(path, texture));
+
+    Penumbra::Assets::CookedTexture loaded;
+    ASSERT_TRUE(Penumbra::Assets::readTexture(path, loaded));
+    EXPECT_EQ(loaded.width, 2);
+    EXPECT_EQ(loaded.height, 2);
+    ASSERT_EQ(loaded.levels.size(), 2u);
+    EXPECT_EQ(loaded.levels[1].width, 1);
+    EXPECT_EQ(loaded.levelData(0)[0], 0);
+    EXPECT_EQ(loaded.levelData(1)[3], 19);
+    std::remove(path.c_str());
+}
+
+TEST_F(CookedAssetsTest, RoomRoundTrip) {
+    Penumbra::Assets::CookedRoom room;
+    room.name = "Floor1_A";
+    room.width = 3;
+    room.height = 2;
+    room.tileTypes = {0, 1, 1, 2, 0, 4};
+    room.textureIndices = {0, 5, 5, 7, 0, 9};
+    room.spawnX = 24.0f;
+    room.eastRoom = "Floor1_B";
+    room.enemies.push_back({"patrol", 32.0f, 48.0f});
+    room.platforms.push_back({"pingpong", 0.0f, 16.0f, 64.0f, 16.0f});
+
+    std::string path = tempPath("roundtrip.proom");
+    ASSERT_TRUE(Penumbra::Assets::writeRoom(path, room));
+
+    Penumbra::Assets::CookedRoom loaded;
+    ASSERT_TRUE(Penumbra::Assets::readRoom(path, loaded));
+    EXPECT_EQ(loaded.name, "Floor1_A");
+    EXPECT_EQ(loaded.tileTypes, room.tileTypes);
+    EXPECT_EQ(loaded.textureIndices, room.textureIndices);
+    EXPECT_FLOAT_EQ(loaded.spawnX, 24.0f);
+    EXPECT_EQ(loaded.eastRoom, "Floor1_B");
+    ASSERT_EQ(loaded.enemies.size(), 1u);
+    EXPECT_EQ(loaded.enemies[0].type, "patrol");
+    ASSERT_EQ(loaded.platforms.size(), 1u);
+    EXPECT_FLOAT_EQ(loaded.platforms[0].width, 64.0f);
+    std::remove(path.c_str());
+}
+
+TEST_F(CookedAssetsTest, ShaderBundleRoundTrip) {
+    Penumbra::Assets::ShaderBundle bundle;
+    bundle.sources["shaders/sprite.vert"] = "#version 330 core\nvoid main() {}\n";
+
+    std::string path = tempPath("roundtrip.pshb");
+    ASSERT_TRUE(Penumbra::Assets::writeShaderBundle(path, bundle));
+
+    Penumbra::Assets::ShaderBundle loaded;
+    ASSERT_TRUE(Penumbra::Assets::readShaderBundle(path, loaded));
+    ASSERT_NE(loaded.find("shaders/sprite.vert"), nullptr);
+    EXPECT_EQ(*loaded.find("shaders/sprite.vert"), bundle.sources["shaders/sprite.vert"]);
+    EXPECT_EQ(loaded.find("shaders/missing.frag"), nullptr);
+    std::remove(path.c_str());
+}
+
+TEST_F(CookedAssetsTest, FontRoundTrip) {
+    Penumbra::Assets::CookedFont font;
+    font.lineHeight = 12;
+    font.base = 9;
+    font.pageWidth = 128;
+    font.pageHeight = 64;
+    font.page = "fonts/ui.png";
+    font.glyphs.push_back({'A', 10, 20, 6, 9, 0, 1, 7});
+    font.glyphs.push_back({0x00E9, 16, 20, 6, 11, -1, -1, 7});
+    font.kernings.push_back({'A', 'V', -2});
+
+    std::string path = tempPath("roundtrip.pfnt");
+    ASSERT_TRUE(Penumbra::Assets::writeFont(path, font));
+
+    Penumbra::Assets::CookedFont loaded;
+    ASSERT_TRUE(Penumbra::Assets::readFont(path, loaded));
+    EXPECT_EQ(loaded.lineHeight, 12);
+    EXPECT_EQ(loaded.page, "fonts/ui.png");
+    ASSERT_EQ(loaded.glyphs.size(), 2u);
+    EXPECT_EQ(loaded.glyphs[1].codepoint, 0x00E9u);
+    EXPECT_EQ(loaded.glyphs[1].offsetX, -1);
+    EXPECT_EQ(loaded.glyphs[0].advance, 7);
+    ASSERT_EQ(loaded.kernings.size(), 1u);
+    EXPECT_EQ(loaded.kernings[0].amount, -2);
+    std::remove(path.c_str());
+}
+
+TEST_F(CookedAssetsTest, RejectsWrongMagic) {
+    Penumbra::Assets::ShaderBundle bundle;
+    std::string path = tempPath("wrongmagic.pshb");
+    ASSERT_TRUE(Penumbra::Assets::writeShaderBundle(path, bundle));
+
+    Penumbra::Assets::CookedTexture texture;
+    EXPECT_FALSE(Penumbra::Assets::readTexture(path, texture));
+    std::remove(path.c_str());
+}
+
+TEST_F(CookedAssetsTest, CookedPaths) {
+    EXPECT_EQ(Penumbra::Assets::cookedTexturePath("sprites/player.png"), "sprites/player.ptex");
+    EXPECT_EQ(Penumbra::Assets::cookedRoomPath("rooms/Floor1_A.json"), "rooms/Floor1_A.proom");
+    EXPECT_EQ(Penumbra::Assets::cookedFontPath("fonts/ui.fnt"), "fonts/ui.pfnt");
+    EXPECT_EQ(Penumbra::Assets::cookedTexturePath("my.dir/noext"), "my.dir/noext.ptex");
+}
+
+// JobSystem tests
+TEST(JobSystemTest, DispatchRunsEveryPieceOnce) {
+    Penumbra::Jobs::JobSystem jobs(3);
+    EXPECT_EQ(jobs.getThreadCount(), 4u);
+
+    std::vector<std::atomic<int>> runs(1000);
+    std::atomic<bool> threadInRange(true);
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        jobs.dispatch(runs.size(), [&](size_t piece, size_t thread) {
+            runs[piece].fetch_add(1);
+            if (thread >= jobs.getThreadCount())
+            {
+                threadInRange = false;
+            }
+        });
+    }
+
+    for (const std::atomic<int>& count : runs)
+    {
+        EXPECT_EQ(count.load(), 3);
+    }
+    EXPECT_TRUE(threadInRange.load());
+}
+
+TEST(JobSystemTest, NoWorkersRunsOnCaller) {
+    Penumbra::Jobs::JobSystem jobs(0);
+    EXPECT_EQ(jobs.getThreadCount(), 1u);
+
+    size_t total = 0;
+    jobs.dispatch(10, [&](size_t piece, size_t thread) {
+        EXPECT_EQ(thread, 0u);
+        total += piece;
+    });
+    EXPECT_EQ(total, 45u);
+}
+
+// ===== FrameStats Tests =====
+
+TEST(FrameStatsTest, MeanAndStdDev) {
+    Penumbra::Platform::FrameStats stats(8);
+    EXPECT_EQ(stats.getCount(), 0u);
+    EXPECT_DOUBLE_EQ(stats.getMean(), 0.0);
+
+    for (double sample : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+        stats.add(sample);
+    }
+    EXPECT_EQ(stats.getCount(), 8u);
+    EXPECT_DOUBLE_EQ(stats.getMean(), 5.0);
+    EXPECT_DOUBLE_EQ(stats.getStdDev(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.getMin(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.getMax(), 9.0);
+}
+
+TEST(FrameStatsTest, WindowDropsOldestSamples) {
+    Penumbra::Platform::FrameStats stats(3);
+    for (double sample : {100.0, 1.0, 2.0, 3.0}) {
+        stats.add(sample);
+    }
+    EXPECT_EQ(stats.getCount(), 3u);
+    EXPECT_DOUBLE_EQ(stats.getMean(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.getMax(), 3.0);
+
+    stats.clear();
+    EXPECT_EQ(stats.getCount(), 0u);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
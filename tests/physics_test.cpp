@@ -65,6 +65,91 @@ TEST_F(TileGridTest, CollisionDetection) {
     EXPECT_FALSE(grid.checkCollision(noBounds));
 }
 
+TEST_F(TileGridTest, CellRangeClampsToGrid) {
+    int minX, minY, maxX, maxY;
+    grid.getCellRange(AABB(-100.0f, 20.0f, 150.0f, 16.0f), minX, minY, maxX, maxY);
+
+    EXPECT_EQ(minX, 0);
+    EXPECT_EQ(maxX, 4);
+    EXPECT_EQ(minY, 1);
+    EXPECT_EQ(maxY, 3);
+
+    grid.getCellRange(AABB(500.0f, 500.0f, 16.0f, 16.0f), minX, minY, maxX, maxY);
+    EXPECT_GE(minX, maxX);
+}
+
+TEST_F(TileGridTest, CellRangeDoesNotGrowWithGrid) {
+    TileGrid large(1000, 1000);
+    AABB view(4000.0f, 4000.0f, 800.0f, 600.0f);
+
+    int minX, minY, maxX, maxY;
+    large.getCellRange(view, minX, minY, maxX, maxY);
+
+    EXPECT_EQ((maxX - minX) * (maxY - minY), 50 * 38);
+}
+
+TEST_F(TileGridTest, JsonRoundTrip) {
+    grid.setTile(3, 4, Tile(TileType::Solid, 7));
+
+    TileGrid loaded;
+    ASSERT_TRUE(loaded.loadFromJson(grid.saveToJson()));
+    EXPECT_EQ(loaded.getWidth(), 10);
+    EXPECT_EQ(loaded.getTile(3, 4).type, TileType::Solid);
+    EXPECT_EQ(loaded.getTile(3, 4).textureIndex, 7);
+    EXPECT_FALSE(loaded.loadFromJson("{\"width\": 2, \"height\": 2, \"tiles\": [0]}"));
+}
+
+TEST_F(TileGridTest, SetTileTouchesOnlyItsChunk) {
+    TileGrid large(40, 40);
+    EXPECT_EQ(large.getChunkColumns(), 3);
+    EXPECT_EQ(large.getChunkRows(), 3);
+
+    uint32_t edited = large.getChunkRevision(1, 2);
+    uint32_t untouched = large.getChunkRevision(0, 0);
+    large.setTile(20, 35, Tile(TileType::Solid, 0));
+
+    EXPECT_NE(large.getChunkRevision(1, 2), edited);
+    EXPECT_EQ(large.getChunkRevision(0, 0), untouched);
+
+    uint32_t beforeClear = large.getChunkRevision(0, 0);
+    large.clear();
+    EXPECT_NE(large.getChunkRevision(0, 0), beforeClear);
+}
+
+TEST_F(TileGridTest, StackedBlocksHideCoveredFaces) {
+    TileGrid stacked(4, 4, 3);
+    EXPECT_EQ(stacked.getLevels(), 3);
+    stacked.setTile(1, 1, 0, Tile(TileType::Solid, 0));
+    stacked.setTile(1, 1, 1, Tile(TileType::Solid, 0));
+    stacked.setTile(2, 1, 0, Tile(TileType::Solid, 0));
+    stacked.setTile(1, 2, 0, Tile(TileType::Platform, 0));
+
+    // Covered top and the side against a solid neighbor are hidden
+    EXPECT_FALSE(stacked.isFaceExposed(1, 1, 0, TileFace::Top));
+    EXPECT_TRUE(stacked.isFaceExposed(1, 1, 1, TileFace::Top));
+    EXPECT_FALSE(stacked.isFaceExposed(1, 1, 0, TileFace::East));
+    EXPECT_TRUE(stacked.isFaceExposed(1, 1, 1, TileFace::East));
+
+    // Platforms don't hide their neighbors' faces; empty tiles have none
+    EXPECT_TRUE(stacked.isFaceExposed(1, 1, 0, TileFace::South));
+    EXPECT_FALSE(stacked.isFaceExposed(0, 0, 0, TileFace::Top));
+
+    // Level 0 is what 2D code sees
+    EXPECT_EQ(stacked.getTile(1, 1).type, TileType::Solid);
+    EXPECT_EQ(stacked.getTile(1, 1, 2).type, TileType::Empty);
+}
+
+TEST_F(TileGridTest, EdgeEditTouchesNeighborChunk) {
+    TileGrid large(40, 40, 2);
+    uint32_t neighbor = large.getChunkRevision(0, 0);
+    uint32_t far = large.getChunkRevision(2, 2);
+
+    // Column 16 is the first of chunk 1; the block beside it sits in chunk 0
+    large.setTile(16, 4, 1, Tile(TileType::Solid, 0));
+    EXPECT_NE(large.getChunkRevision(0, 0), neighbor);
+    EXPECT_EQ(large.getChunkRevision(2, 2), far);
+}
+
 class PlayerTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -1,6 +1,27 @@
 #include <gtest/gtest.h>
 #include "rendering/Camera.h"
+#include "rendering/DebugDraw.h"
+#include "rendering/DrawSort.h"
+#include "rendering/DynamicResolution.h"
+#include "rendering/Font.h"
+#include "rendering/FrameUniforms.h"
+#include "rendering/GLState.h"
+#include "rendering/IsometricCamera.h"
+#include "rendering/Lighting.h"
+#include "rendering/Particles.h"
+#include "rendering/RenderTarget.h"
+#include "rendering/SpriteCommandBuffer.h"
+#include "rendering/Text.h"
+#include "core/JobSystem.h"
+#include "core/Resources.h"
 #include "core/Math.h"
+#include "game/TileGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace Penumbra::Rendering;
 using namespace Penumbra::Math;
@@ -63,7 +84,821 @@ TEST_F(CameraTest, TargetFollowing) {
     EXPECT_NE(pos.y, 0.0f);
 }
 
+TEST_F(CameraTest, VisibleBoundsFollowZoomAndMargin) {
+    camera.setPosition(1000.0f, 500.0f);
+
+    AABB bounds = camera.getVisibleBounds();
+    EXPECT_FLOAT_EQ(bounds.min.x, 600.0f);
+    EXPECT_FLOAT_EQ(bounds.min.y, 200.0f);
+    EXPECT_FLOAT_EQ(bounds.max.x, 1400.0f);
+    EXPECT_FLOAT_EQ(bounds.max.y, 800.0f);
+
+    camera.setZoom(2.0f);
+    bounds = camera.getVisibleBounds(10.0f);
+    EXPECT_FLOAT_EQ(bounds.min.x, 790.0f);
+    EXPECT_FLOAT_EQ(bounds.max.x, 1210.0f);
+    EXPECT_FLOAT_EQ(bounds.max.y - bounds.min.y, 320.0f);
+}
+
+class IsometricCameraTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        camera.initialize(800.0f, 600.0f);
+        camera.setTarget(Vec3(160.0f, 96.0f, 0.0f));
+    }
+
+    IsometricCamera camera;
+};
+
+TEST_F(IsometricCameraTest, TargetProjectsToViewportCenter) {
+    Vec2 screen = camera.worldToScreen(camera.getTarget());
+    EXPECT_NEAR(screen.x, 400.0f, 1e-3f);
+    EXPECT_NEAR(screen.y, 300.0f, 1e-3f);
+}
+
+TEST_F(IsometricCameraTest, ScreenToWorldInvertsWorldToScreen) {
+    Vec3 world(200.0f, 40.0f, 16.0f);
+    Vec2 screen = camera.worldToScreen(world);
+    Vec3 picked = camera.screenToWorld(screen.x, screen.y, 16.0f);
+
+    EXPECT_NEAR(picked.x, world.x, 1e-2f);
+    EXPECT_NEAR(picked.y, world.y, 1e-2f);
+    EXPECT_NEAR(picked.z, world.z, 1e-2f);
+}
+
+TEST_F(IsometricCameraTest, KeepsTwoDimensionalHandedness) {
+    // Looking straight down at yaw 0 must match the 2D layout: +X right, +Y (rows) down
+    camera.setYaw(0.0f);
+    camera.setPitch(89.0f);
+
+    Vec2 center = camera.worldToScreen(camera.getTarget());
+    EXPECT_GT(camera.worldToScreen(camera.getTarget() + Vec3(16.0f, 0.0f, 0.0f)).x, center.x);
+    EXPECT_GT(camera.worldToScreen(camera.getTarget() + Vec3(0.0f, 16.0f, 0.0f)).y, center.y);
+}
+
+TEST_F(IsometricCameraTest, BillboardAxesMatchScreen) {
+    Vec3 right = camera.getRight();
+    Vec3 down = camera.getDown();
+    EXPECT_NEAR(glm::length(right), 1.0f, 1e-5f);
+    EXPECT_NEAR(glm::dot(right, down), 0.0f, 1e-5f);
+
+    // A quad spanned by the axes stays screen-aligned and at constant depth
+    Vec3 anchor = camera.getTarget();
+    Vec2 screen = camera.worldToScreen(anchor + right * 10.0f + down * 20.0f);
+    EXPECT_NEAR(screen.x, 410.0f, 1e-2f);
+    EXPECT_NEAR(screen.y, 320.0f, 1e-2f);
+    EXPECT_NEAR(camera.getSortDepth(anchor + down * 20.0f), camera.getSortDepth(anchor), 1e-2f);
+}
+
+TEST_F(IsometricCameraTest, NearerPointsSortHigher) {
+    // At the default yaw the camera sits to the south-west, above the ground
+    Vec3 target = camera.getTarget();
+    EXPECT_GT(camera.getSortDepth(target + Vec3(-16.0f, 16.0f, 0.0f)), camera.getSortDepth(target));
+    EXPECT_GT(camera.getSortDepth(target + Vec3(0.0f, 0.0f, 16.0f)), camera.getSortDepth(target));
+}
+
+TEST_F(IsometricCameraTest, FacingFollowsYaw) {
+    // Default view looks north-east, so south and west sides face the camera
+    EXPECT_TRUE(camera.isFacing(Vec3(0.0f, 0.0f, 1.0f)));
+    EXPECT_TRUE(camera.isFacing(Vec3(0.0f, 1.0f, 0.0f)));
+    EXPECT_TRUE(camera.isFacing(Vec3(-1.0f, 0.0f, 0.0f)));
+    EXPECT_FALSE(camera.isFacing(Vec3(0.0f, -1.0f, 0.0f)));
+    EXPECT_FALSE(camera.isFacing(Vec3(1.0f, 0.0f, 0.0f)));
+
+    camera.setYaw(225.0f);
+    EXPECT_TRUE(camera.isFacing(Vec3(0.0f, -1.0f, 0.0f)));
+    EXPECT_TRUE(camera.isFacing(Vec3(1.0f, 0.0f, 0.0f)));
+    EXPECT_FALSE(camera.isFacing(Vec3(0.0f, 1.0f, 0.0f)));
+}
+
+TEST_F(IsometricCameraTest, QuarterTurnsAnimateAndWrap) {
+    EXPECT_EQ(camera.getQuarterTurn(), 0);
+
+    camera.rotateQuarterTurn(-1);
+    EXPECT_EQ(camera.getQuarterTurn(), 3);
+    EXPECT_TRUE(camera.isRotating());
+
+    camera.update(0.1f);
+    EXPECT_TRUE(camera.isRotating());
+    camera.update(1.0f);
+    EXPECT_FALSE(camera.isRotating());
+    EXPECT_FLOAT_EQ(camera.getYaw(), 315.0f);
+}
+
+TEST(UniformIDTest, CompileTimeHashMatchesRuntime) {
+    constexpr Penumbra::Resources::UniformID texture("uTexture");
+    static_assert(texture.hash == Penumbra::Resources::UniformID::hashName("uTexture"),
+                  "UniformID must hash at compile time");
+
+    std::string runtimeName = "uTexture";
+    EXPECT_EQ(texture.hash, Penumbra::Resources::UniformID::hashName(runtimeName.c_str()));
+    EXPECT_NE(texture.hash, Penumbra::Resources::UniformID("uColor").hash);
+}
+
+TEST(FrameUniformsTest, Std140Layout) {
+    EXPECT_EQ(offsetof(FrameData, view), 0u);
+    EXPECT_EQ(offsetof(FrameData, projection), 64u);
+    EXPECT_EQ(offsetof(FrameData, viewProjection), 128u);
+    EXPECT_EQ(offsetof(FrameData, viewport), 192u);
+    EXPECT_EQ(offsetof(FrameData, time), 208u);
+    EXPECT_EQ(offsetof(FrameData, cameraRight), 224u);
+    EXPECT_EQ(offsetof(FrameData, cameraDown), 240u);
+}
+
+/**
+ * GL backend that records calls instead of issuing them
+ */
+class RecordingGL : public GLBackend {
+public:
+    std::vector<std::string> calls;
+
+    void useProgram(unsigned int program) override { record("useProgram", program); }
+    void activeTexture(unsigned int unit) override { record("activeTexture", unit); }
+    void bindTexture(unsigned int, unsigned int texture) override { record("bindTexture", texture); }
+    void bindVertexArray(unsigned int vertexArray) override { record("bindVertexArray", vertexArray); }
+    void setBlendEnabled(bool enabled) override { record("blend", enabled ? 1 : 0); }
+    void blendFunc(unsigned int source, unsigned int dest) override { record("blendFunc", source + dest); }
+    void viewport(int, int, int width, int height) override {
+        record("viewport", static_cast<unsigned int>(width * height));
+    }
+    void setDepthTestEnabled(bool enabled) override { record("depthTest", enabled ? 1 : 0); }
+    void depthMask(bool write) override { record("depthMask", write ? 1 : 0); }
+
+private:
+    void record(const char* name, unsigned int value) {
+        calls.push_back(std::string(name) + " " + std::to_string(value));
+    }
+};
+
+class GLStateCacheTest : public ::testing::Test {
+protected:
+    RecordingGL gl;
+    GLStateCache state{gl};
+};
+
+TEST_F(GLStateCacheTest, RedundantProgramIsSkipped) {
+    state.useProgram(3);
+    state.useProgram(3);
+    state.useProgram(4);
+
+    EXPECT_EQ(gl.calls, (std::vector<std::string>{"useProgram 3", "useProgram 4"}));
+    EXPECT_EQ(state.getStats().issued, 2u);
+    EXPECT_EQ(state.getStats().avoided, 1u);
+}
+
+TEST_F(GLStateCacheTest, FirstBindOfZeroReachesGL) {
+    // Nothing is assumed about GL's initial state
+    state.bindVertexArray(0);
+    state.useProgram(0);
+
+    EXPECT_EQ(gl.calls.size(), 2u);
+    EXPECT_EQ(state.getStats().avoided, 0u);
+}
+
+TEST_F(GLStateCacheTest, TextureUnitsAreTrackedSeparately) {
+    state.bindTexture(0, 7);
+    state.bindTexture(1, 7);
+    state.bindTexture(0, 7);
+    state.bindTexture(1, 8);
+
+    EXPECT_EQ(gl.calls, (std::vector<std::string>{
+        "activeTexture 0", "bindTexture 7",
+        "activeTexture 1", "bindTexture 7",
+        "bindTexture 8"}));
+    EXPECT_EQ(state.getStats().avoided, 1u);
+}
+
+TEST_F(GLStateCacheTest, ForgottenTextureIsRebound) {
+    state.bindTexture(0, 7);
+    state.bindTexture(1, 9);
+
+    // Deleted and its name reused: the next bind must reach GL
+    state.forgetTexture(7);
+    state.bindTexture(0, 7);
+    state.bindTexture(1, 9);
+
+    EXPECT_EQ(gl.calls, (std::vector<std::string>{
+        "activeTexture 0", "bindTexture 7",
+        "activeTexture 1", "bindTexture 9",
+        "activeTexture 0", "bindTexture 7"}));
+}
+
+TEST_F(GLStateCacheTest, BlendModeAndViewport) {
+    state.setBlendMode(BlendMode::Premultiplied);
+    state.setBlendMode(BlendMode::Premultiplied);
+    state.setViewport(0, 0, 640, 360);
+    state.setViewport(0, 0, 640, 360);
+    state.setBlendMode(BlendMode::None);
+
+    EXPECT_EQ(gl.calls.size(), 4u);
+    EXPECT_EQ(gl.calls.back(), "blend 0");
+    EXPECT_EQ(state.getStats().issued, 3u);
+    EXPECT_EQ(state.getStats().avoided, 2u);
+}
+
+TEST_F(GLStateCacheTest, DepthModeIsCached) {
+    state.setDepthMode(DepthMode::TestWrite);
+    state.setDepthMode(DepthMode::TestWrite);
+    state.setDepthMode(DepthMode::TestOnly);
+
+    EXPECT_EQ(gl.calls, (std::vector<std::string>{
+        "depthTest 1", "depthMask 1",
+        "depthTest 1", "depthMask 0"}));
+    EXPECT_EQ(state.getStats().issued, 2u);
+    EXPECT_EQ(state.getStats().avoided, 1u);
+}
+
+TEST_F(GLStateCacheTest, InvalidateForcesReissue) {
+    state.useProgram(3);
+    state.bindVertexArray(2);
+    state.invalidate();
+    state.useProgram(3);
+    state.bindVertexArray(2);
+
+    EXPECT_EQ(gl.calls.size(), 4u);
+    EXPECT_EQ(state.getStats().avoided, 0u);
+
+    state.resetStats();
+    state.useProgram(3);
+    EXPECT_EQ(state.getStats().issued, 0u);
+    EXPECT_EQ(state.getStats().avoided, 1u);
+}
+
+TEST(DrawSortTest, KeyOrdersLayerThenDepthThenTexture) {
+    EXPECT_LT(makeSortKey(-1, 100.0f, 9, 9), makeSortKey(0, -100.0f, 0, 0));
+    EXPECT_LT(makeSortKey(0, -2.5f, 9, 9), makeSortKey(0, -1.0f, 0, 0));
+    EXPECT_LT(makeSortKey(0, 1.0f, 9, 9), makeSortKey(0, 2.0f, 0, 0));
+    EXPECT_LT(makeSortKey(0, 1.0f, 1, 9), makeSortKey(0, 1.0f, 2, 0));
+    EXPECT_LT(makeSortKey(0, 1.0f, 1, 1), makeSortKey(0, 1.0f, 1, 2));
+
+    // Out-of-range layers clamp instead of wrapping
+    EXPECT_LT(makeSortKey(-1000, 0.0f, 0, 0), makeSortKey(0, 0.0f, 0, 0));
+    EXPECT_GT(makeSortKey(1000, 0.0f, 0, 0), makeSortKey(126, 0.0f, 0, 0));
+}
+
+TEST(DrawSortTest, RadixSortIsStable) {
+    std::mt19937 random(1234);
+    std::vector<DrawCommand> commands;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        // Few distinct keys so stability is actually exercised
+        commands.push_back({makeSortKey(static_cast<int>(random() % 4), static_cast<float>(random() % 8),
+                                        random() % 3, 0), i});
+    }
+
+    std::vector<DrawCommand> expected = commands;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const DrawCommand& a, const DrawCommand& b) { return a.key < b.key; });
+
+    std::vector<DrawCommand> scratch;
+    radixSort(commands, scratch);
+
+    ASSERT_EQ(commands.size(), expected.size());
+    for (size_t i = 0; i < commands.size(); ++i) {
+        EXPECT_EQ(commands[i].key, expected[i].key);
+        EXPECT_EQ(commands[i].index, expected[i].index);
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+// Sprite vertex kernel tests
+class SpriteKernelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Odd count so the scalar tail runs too
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        sprites.resize(21);
+        for (size_t i = 0; i < sprites.size(); ++i)
+        {
+            Sprite& sprite = sprites[i];
+            sprite.position = Vec2(unit(random) * 500.0f, unit(random) * 500.0f);
+            sprite.size = Vec2(8.0f + unit(random) * 32.0f, 8.0f + unit(random) * 32.0f);
+            sprite.origin = Vec2(unit(random), unit(random));
+            sprite.textureRect = Rect(unit(random) * 0.5f, unit(random) * 0.5f, 0.25f, 0.25f);
+            sprite.color = Color(unit(random), unit(random), unit(random), unit(random));
+            sprite.z = unit(random) * 64.0f;
+            slots.push_back(static_cast<uint8_t>(i % 8));
+        }
+    }
+
+    void expectMatchesScalar(const SpriteAxes& axes, float tolerance) {
+        std::vector<const Sprite*> pointers;
+        for (const Sprite& sprite : sprites)
+        {
+            pointers.push_back(&sprite);
+        }
+        std::vector<SpriteVertex> batch(sprites.size() * 4);
+        std::vector<SpriteVertex> scalar(sprites.size() * 4);
+        writeSpriteVerticesBatch(pointers.data(), slots.data(), sprites.size(), axes, batch.data());
+        for (size_t i = 0; i < sprites.size(); ++i)
+        {
+            writeSpriteVertices(sprites[i], slots[i], axes, &scalar[i * 4]);
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            EXPECT_NEAR(batch[i].x, scalar[i].x, tolerance);
+            EXPECT_NEAR(batch[i].y, scalar[i].y, tolerance);
+            EXPECT_NEAR(batch[i].z, scalar[i].z, tolerance);
+            EXPECT_EQ(batch[i].u, scalar[i].u);
+            EXPECT_EQ(batch[i].v, scalar[i].v);
+            EXPECT_EQ(batch[i].r, scalar[i].r);
+            EXPECT_EQ(batch[i].g, scalar[i].g);
+            EXPECT_EQ(batch[i].b, scalar[i].b);
+            EXPECT_EQ(batch[i].a, scalar[i].a);
+            EXPECT_EQ(batch[i].textureSlot, scalar[i].textureSlot);
+        }
+    }
+
+    std::vector<Sprite> sprites;
+    std::vector<uint8_t> slots;
+};
+
+TEST_F(SpriteKernelTest, UnrotatedMatchesScalarExactly) {
+    expectMatchesScalar(SpriteAxes(), 0.0f);
+}
+
+TEST_F(SpriteKernelTest, RotatedMatchesScalar) {
+    // Several turns either way exercise every quadrant of the range reduction
+    for (size_t i = 0; i < sprites.size(); ++i)
+    {
+        sprites[i].rotation = (static_cast<float>(i) - 10.0f) * 1.37f;
+    }
+    sprites[3].rotation = 0.0f;
+    expectMatchesScalar(SpriteAxes(), 1e-3f);
+
+    SpriteAxes billboard;
+    billboard.billboard = true;
+    billboard.right = Vec3(0.7071f, -0.7071f, 0.0f);
+    billboard.down = Vec3(0.3536f, 0.3536f, -0.866f);
+    expectMatchesScalar(billboard, 1e-3f);
+}
+
+// SpriteCommandBuffer tests
+TEST(SpriteCommandBufferTest, RecordsTransformedQuads) {
+    SpriteCommandBuffer buffer;
+    buffer.begin(SpriteBatchMode::Vertices, SpriteAxes(), nullptr);
+
+    Sprite sprite;
+    sprite.position = Vec2(100.0f, 50.0f);
+    sprite.size = Vec2(20.0f, 10.0f);
+    sprite.layer = 2;
+    sprite.depth = 1.5f;
+    buffer.draw(sprite);
+
+    ASSERT_EQ(buffer.getSpriteCount(), 1u);
+    const DrawCommand& command = buffer.getCommands()[0];
+    EXPECT_EQ(command.key, makeSortKey(2, 1.5f, 0, 0));
+
+    // Centered origin: top-left and bottom-right corners straddle the position
+    const SpriteVertex* quad = static_cast<const SpriteVertex*>(buffer.getRecord(command.index));
+    EXPECT_FLOAT_EQ(quad[0].x, 90.0f);
+    EXPECT_FLOAT_EQ(quad[0].y, 45.0f);
+    EXPECT_FLOAT_EQ(quad[2].x, 110.0f);
+    EXPECT_FLOAT_EQ(quad[2].y, 55.0f);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.getSpriteCount(), 0u);
+    EXPECT_EQ(buffer.getTextures().size(), 1u);
+}
+
+TEST(SpriteCommandBufferTest, ThreadsRecordIntoOwnBuffers) {
+    Penumbra::Jobs::JobSystem jobs(3);
+    std::vector<SpriteCommandBuffer> buffers(jobs.getThreadCount());
+    for (SpriteCommandBuffer& buffer : buffers)
+    {
+        buffer.begin(SpriteBatchMode::Instanced, SpriteAxes(), nullptr);
+    }
+
+    const size_t pieces = 64;
+    const size_t spritesPerPiece = 100;
+    jobs.dispatch(pieces, [&](size_t piece, size_t thread) {
+        Sprite sprite;
+        for (size_t i = 0; i < spritesPerPiece; ++i)
+        {
+            sprite.position = Vec2(static_cast<float>(piece), static_cast<float>(i));
+            buffers[thread].draw(sprite);
+        }
+    });
+
+    // Every sprite lands in exactly one buffer, with its own record
+    size_t total = 0;
+    std::vector<int> seen(pieces * spritesPerPiece, 0);
+    for (const SpriteCommandBuffer& buffer : buffers)
+    {
+        total += buffer.getSpriteCount();
+        for (const DrawCommand& command : buffer.getCommands())
+        {
+            const SpriteInstance* instance = static_cast<const SpriteInstance*>(buffer.getRecord(command.index));
+            size_t id = static_cast<size_t>(instance->x) * spritesPerPiece + static_cast<size_t>(instance->y);
+            ASSERT_LT(id, seen.size());
+            ++seen[id];
+        }
+    }
+    EXPECT_EQ(total, pieces * spritesPerPiece);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+}
+
+// Font and TextLayout tests
+class TextLayoutTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        font.loadBuiltin(pixels);
+    }
+
+    Font font;
+    std::vector<uint8_t> pixels;
+};
+
+TEST_F(TextLayoutTest, BuiltinFontCoversPrintableAscii) {
+    ASSERT_EQ(pixels.size(), static_cast<size_t>(font.getPageWidth() * font.getPageHeight() * 4));
+    for (uint32_t c = 32; c < 127; ++c) {
+        ASSERT_NE(font.getGlyph(c), nullptr) << c;
+    }
+    EXPECT_EQ(font.getGlyph(127), nullptr);
+    EXPECT_EQ(font.getGlyph(0x00E9), nullptr);
+
+    // '!' is the second cell: a dot at the top of its middle column
+    const Glyph* bang = font.getGlyph('!');
+    int x = static_cast<int>(bang->textureRect.x * font.getPageWidth() + 0.5f) + 2;
+    int y = static_cast<int>(bang->textureRect.y * font.getPageHeight() + 0.5f);
+    EXPECT_EQ(pixels[(static_cast<size_t>(y * font.getPageWidth() + x)) * 4 + 3], 255);
+    EXPECT_EQ(pixels[(static_cast<size_t>(y * font.getPageWidth() + x - 1)) * 4 + 3], 0);
+}
+
+TEST_F(TextLayoutTest, LayoutIsCachedUntilTextChanges) {
+    TextLayout layout;
+    EXPECT_TRUE(layout.set(font, "HP 10"));
+    EXPECT_FALSE(layout.set(font, "HP 10"));
+    EXPECT_EQ(layout.getQuads().size(), 4u);  // Spaces add no quad
+    EXPECT_FLOAT_EQ(layout.getQuads()[2].position.x, 3.0f * font.getGlyph('H')->advance);
+
+    EXPECT_TRUE(layout.set(font, "HP 9"));
+    EXPECT_EQ(layout.getQuads().size(), 3u);
+
+    // Reloading the font invalidates the cache
+    font.loadBuiltin(pixels);
+    EXPECT_TRUE(layout.set(font, "HP 9"));
+}
+
+TEST_F(TextLayoutTest, BreaksLinesAndWraps) {
+    float advance = font.getGlyph('A')->advance;
+    float lineHeight = font.getLineHeight();
+
+    TextLayout layout;
+    layout.set(font, "AB\nC");
+    EXPECT_EQ(layout.getLineCount(), 2u);
+    EXPECT_FLOAT_EQ(layout.getQuads()[2].position.x, 0.0f);
+    EXPECT_FLOAT_EQ(layout.getQuads()[2].position.y, lineHeight);
+
+    // "AAA BBB" wrapped to five glyphs moves BBB to the second line
+    layout.set(font, "AAA BBB", advance * 5.0f);
+    EXPECT_EQ(layout.getLineCount(), 2u);
+    EXPECT_FLOAT_EQ(layout.getQuads()[3].position.x, 0.0f);
+    EXPECT_FLOAT_EQ(layout.getQuads()[3].position.y, lineHeight);
+    EXPECT_FLOAT_EQ(layout.getSize().x, advance * 2.0f + font.getGlyph('A')->size.x);
+
+    // Unknown characters fall back to '?'
+    layout.set(font, "\xC3\xA9");
+    ASSERT_EQ(layout.getQuads().size(), 1u);
+    EXPECT_FLOAT_EQ(layout.getQuads()[0].textureRect.x, font.getGlyph('?')->textureRect.x);
+}
+
+TEST_F(TextLayoutTest, DrawsIntoOneTextureSlot) {
+    TextLayout layout;
+    layout.set(font, "FPS 60\nMS 16.7");
+
+    SpriteCommandBuffer buffer;
+    buffer.begin(SpriteBatchMode::Vertices, SpriteAxes(), nullptr);
+    layout.draw(buffer, Vec2(10.0f, 20.0f), Color::White, 2.0f);
+    EXPECT_EQ(buffer.getSpriteCount(), layout.getQuads().size());
+
+    // Every glyph uses the font page (unset here, so the untextured slot)
+    EXPECT_EQ(buffer.getTextures().size(), 1u);
+    for (const DrawCommand& command : buffer.getCommands()) {
+        EXPECT_EQ(command.key, buffer.getCommands()[0].key);
+    }
+    const SpriteVertex* first = static_cast<const SpriteVertex*>(buffer.getRecord(0));
+    EXPECT_FLOAT_EQ(first[0].x, 10.0f);
+    EXPECT_FLOAT_EQ(first[2].x, 10.0f + font.getGlyph('F')->size.x * 2.0f);
+}
+
+#if PENUMBRA_DEBUG_DRAW
+// DebugDrawQueue tests
+TEST(DebugDrawQueueTest, PrimitivesExpandIntoTwoStreams) {
+    DebugDrawQueue queue;
+    queue.line(Vec2(0.0f, 0.0f), Vec2(10.0f, 0.0f), Color::Red);
+    queue.rect(Rect(0.0f, 0.0f, 4.0f, 4.0f), Color::Green);
+    queue.rect(Rect(0.0f, 0.0f, 4.0f, 4.0f), Color::Green, true);
+    queue.circle(Vec2(0.0f, 0.0f), 2.0f, Color::Blue, true);
+    queue.text(Vec2(0.0f, 0.0f), "1 -", Color::White);
+
+    // One line, four outline edges, three strokes for '1' and two for '-'
+    EXPECT_EQ(queue.getLineVertices().size(), (1u + 4u + 3u + 2u) * 2u);
+    EXPECT_EQ(queue.getTriangleVertices().size(), (2u + DebugDrawQueue::CIRCLE_SEGMENTS) * 3u);
+
+    // Colors are premultiplied
+    queue.clear();
+    queue.line(Vec2(0.0f, 0.0f), Vec2(1.0f, 1.0f), Color(1.0f, 1.0f, 1.0f, 0.5f));
+    EXPECT_EQ(queue.getLineVertices()[0].r, 128);
+    EXPECT_EQ(queue.getLineVertices()[0].a, 128);
+}
+
+TEST(DebugDrawQueueTest, PersistentPrimitivesSurviveEndFrame) {
+    DebugDrawQueue queue;
+    queue.line(Vec2(0.0f, 0.0f), Vec2(1.0f, 0.0f), Color::Red);
+    queue.line(Vec2(5.0f, 5.0f), Vec2(6.0f, 5.0f), Color::Green, DebugLifetime::Persistent);
+    ASSERT_EQ(queue.getLineVertices().size(), 4u);
+
+    queue.endFrame();
+    ASSERT_EQ(queue.getLineVertices().size(), 2u);
+    EXPECT_FLOAT_EQ(queue.getLineVertices()[0].x, 5.0f);
+
+    queue.rect(Rect(0.0f, 0.0f, 1.0f, 1.0f), Color::Blue, true);
+    queue.clearPersistent();
+    EXPECT_TRUE(queue.getLineVertices().empty());
+    EXPECT_EQ(queue.getTriangleVertices().size(), 6u);
+
+    queue.endFrame();
+    EXPECT_TRUE(queue.isEmpty());
+}
+#endif
+
+class LightingTest : public ::testing::Test {
+protected:
+    Penumbra::Game::TileGrid grid{48, 32};
+
+    void SetUp() override {
+        // Wall of 8 tiles entirely inside chunk (0, 0)
+        for (int x = 2; x < 10; ++x) {
+            grid.setTile(x, 5, Penumbra::Game::Tile(Penumbra::Game::TileType::Solid));
+        }
+    }
+};
+
+TEST_F(LightingTest, WallMergesIntoOneSegmentPerSide) {
+    OccluderCache occluders;
+    EXPECT_TRUE(occluders.update(grid));
+    EXPECT_EQ(occluders.getSegmentCount(), 4u);
+
+    std::vector<OccluderSegment> segments;
+    occluders.query(AABB(Vec2(0.0f, 0.0f), Vec2(200.0f, 200.0f)), segments);
+    ASSERT_EQ(segments.size(), 4u);
+    for (const OccluderSegment& segment : segments) {
+        float length = std::fabs(segment.end.x - segment.start.x) + std::fabs(segment.end.y - segment.start.y);
+        EXPECT_TRUE(length == 128.0f || length == 16.0f);
+    }
+
+    segments.clear();
+    occluders.query(AABB(Vec2(400.0f, 300.0f), Vec2(500.0f, 400.0f)), segments);
+    EXPECT_TRUE(segments.empty());
+}
+
+TEST_F(LightingTest, OnlyChangedChunksAreRebuilt) {
+    OccluderCache occluders;
+    occluders.update(grid);
+    EXPECT_EQ(occluders.getChunksRebuilt(), 6u);
+    uint32_t revision = occluders.getRevision();
+
+    EXPECT_FALSE(occluders.update(grid));
+    EXPECT_EQ(occluders.getChunksRebuilt(), 0u);
+    EXPECT_EQ(occluders.getRevision(), revision);
+
+    // A block in chunk (2, 1), away from its edges
+    grid.setTile(40, 20, Penumbra::Game::Tile(Penumbra::Game::TileType::Solid));
+    EXPECT_TRUE(occluders.update(grid));
+    EXPECT_EQ(occluders.getChunksRebuilt(), 1u);
+    EXPECT_NE(occluders.getRevision(), revision);
+    EXPECT_EQ(occluders.getSegmentCount(), 8u);
+}
+
+TEST(VisibilityPolygonTest, WallBlocksRays) {
+    VisibilityPolygon visibility;
+    visibility.build(Vec2(0.0f, 0.0f), 100.0f, {});
+    ASSERT_FALSE(visibility.getPoints().empty());
+    for (const Vec2& point : visibility.getPoints()) {
+        EXPECT_NEAR(std::max(std::fabs(point.x), std::fabs(point.y)), 100.0f, 1e-3f);
+    }
+
+    std::vector<OccluderSegment> walls = {{Vec2(20.0f, -10.0f), Vec2(20.0f, 10.0f)}};
+    visibility.build(Vec2(0.0f, 0.0f), 100.0f, walls);
+    const std::vector<Vec2>& points = visibility.getPoints();
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_LE(std::atan2(points[i - 1].y, points[i - 1].x), std::atan2(points[i].y, points[i].x));
+    }
+    for (const Vec2& point : points) {
+        // Straight ahead ends at the wall, past its ends at the bounds
+        if (std::fabs(point.y) < 9.0f && point.x > 0.0f) {
+            EXPECT_NEAR(point.x, 20.0f, 1e-3f);
+        }
+        if (std::fabs(std::atan2(point.y, point.x)) > 0.6f) {
+            EXPECT_NEAR(std::max(std::fabs(point.x), std::fabs(point.y)), 100.0f, 1e-3f);
+        }
+    }
+}
+
+TEST_F(LightingTest, LightsAreCulledAndStaticShadowsCached) {
+    OccluderCache occluders;
+    occluders.update(grid);
+
+    LightSystem lights;
+    Light lamp;
+    lamp.position = Vec2(96.0f, 40.0f);
+    lamp.radius = 64.0f;
+    lamp.isStatic = true;
+    LightHandle lampHandle = lights.addLight(lamp);
+
+    Light faraway;
+    faraway.position = Vec2(700.0f, 480.0f);
+    lights.addLight(faraway);
+
+    AABB view(Vec2(0.0f, 0.0f), Vec2(320.0f, 240.0f));
+    LightFrame frame;
+    lights.update(occluders, view, frame);
+    ASSERT_EQ(frame.lights.size(), 1u);
+    EXPECT_EQ(lights.getLightsCulled(), 1u);
+    EXPECT_EQ(lights.getPolygonsBuilt(), 1u);
+
+    // Fan: origin, outline, first outline point again
+    const VisibleLight& visible = frame.lights[0];
+    EXPECT_EQ(frame.vertices[visible.firstVertex], lamp.position);
+    EXPECT_EQ(frame.vertices[visible.firstVertex + 1], frame.vertices[visible.firstVertex + visible.vertexCount - 1]);
+
+    lights.update(occluders, view, frame);
+    EXPECT_EQ(lights.getPolygonsBuilt(), 0u);
+    EXPECT_EQ(frame.lights.size(), 1u);
+
+    lights.getLight(lampHandle)->position.x += 8.0f;
+    lights.update(occluders, view, frame);
+    EXPECT_EQ(lights.getPolygonsBuilt(), 1u);
+
+    grid.setTile(1, 1, Penumbra::Game::Tile(Penumbra::Game::TileType::Solid));
+    occluders.update(grid);
+    lights.update(occluders, view, frame);
+    EXPECT_EQ(lights.getPolygonsBuilt(), 1u);
+}
+
+class ParticlePoolTest : public ::testing::Test {
+protected:
+    ParticleType type;
+
+    void SetUp() override {
+        type.capacity = 64;
+        type.lifetime = 1.0f;
+        type.angle = 0.0f;
+        type.spread = 0.0f;
+        type.speed = 10.0f;
+        type.acceleration = Vec2(0.0f, 20.0f);
+        type.startColor = Color(1.0f, 0.5f, 0.0f, 1.0f);
+        type.endColor = Color(1.0f, 0.5f, 0.0f, 0.0f);
+    }
+};
+
+TEST_F(ParticlePoolTest, EmissionStopsAtCapacity) {
+    ParticlePool pool(type);
+    EXPECT_EQ(pool.emit(Vec2(0.0f, 0.0f), 50), 50u);
+    EXPECT_EQ(pool.emit(Vec2(0.0f, 0.0f), 50), 14u);
+    EXPECT_EQ(pool.getCount(), 64u);
+}
+
+TEST_F(ParticlePoolTest, IntegratesAndCompactsExpired) {
+    ParticlePool pool(type);
+    pool.emit(Vec2(0.0f, 0.0f), 13);
+    pool.update(0.5f);
+    ASSERT_EQ(pool.getCount(), 13u);
+    for (size_t i = 0; i < pool.getCount(); ++i) {
+        EXPECT_NEAR(pool.getPosition(i).x, 5.0f, 1e-4f);
+        EXPECT_NEAR(pool.getPosition(i).y, 5.0f, 1e-4f);
+    }
+
+    // The first burst expires; the second moves into its slots
+    pool.emit(Vec2(100.0f, 0.0f), 3);
+    pool.update(0.6f);
+    ASSERT_EQ(pool.getCount(), 3u);
+    for (size_t i = 0; i < pool.getCount(); ++i) {
+        EXPECT_NEAR(pool.getPosition(i).x, 106.0f, 1e-4f);
+    }
+}
+
+TEST_F(ParticlePoolTest, BouncesOffSolidTiles) {
+    Penumbra::Game::TileGrid grid(8, 8);
+    grid.setTile(4, 2, Penumbra::Game::Tile(Penumbra::Game::TileType::Solid));
+
+    type.collide = true;
+    type.speed = 100.0f;
+    type.acceleration = Vec2(0.0f, 0.0f);
+    ParticleSystem particles;
+    size_t sparks = particles.addType(type);
+    particles.emit(sparks, Vec2(60.0f, 40.0f), 1);
+
+    particles.update(0.1f, &grid);
+    EXPECT_NEAR(particles.getPool(sparks).getPosition(0).x, 60.0f, 1e-4f);
+    particles.update(0.1f, &grid);
+    EXPECT_NEAR(particles.getPool(sparks).getPosition(0).x, 55.0f, 1e-4f);
+}
+
+TEST_F(ParticlePoolTest, DrawsOneInstanceRun) {
+    ParticlePool pool(type);
+    pool.emit(Vec2(0.0f, 0.0f), 20);
+    pool.update(0.5f);
+
+    SpriteCommandBuffer buffer;
+    buffer.begin(SpriteBatchMode::Instanced, SpriteAxes(), nullptr);
+    pool.draw(buffer);
+    ASSERT_EQ(buffer.getSpriteCount(), 20u);
+    for (const DrawCommand& command : buffer.getCommands()) {
+        EXPECT_EQ(command.key, buffer.getCommands()[0].key);
+    }
+
+    // Halfway through life: half alpha, premultiplied
+    const SpriteInstance* instance = static_cast<const SpriteInstance*>(buffer.getRecord(19));
+    EXPECT_NEAR(instance->a, 128, 1);
+    EXPECT_NEAR(instance->r, 128, 1);
+    EXPECT_NEAR(instance->g, 64, 1);
+    EXPECT_EQ(instance->b, 0);
+    EXPECT_FLOAT_EQ(instance->x, 5.0f);
+}
+
+TEST(RenderTargetTest, IntegerUpscaleFitsAndCenters) {
+    // 256x192 world in a 1024x768 window fills it exactly at 4x
+    IntegerUpscale exact = fitIntegerUpscale(256, 192, 1024, 768);
+    EXPECT_EQ(exact.scale, 4);
+    EXPECT_EQ(exact.x, 0);
+    EXPECT_EQ(exact.y, 0);
+    EXPECT_EQ(exact.width, 1024);
+    EXPECT_EQ(exact.height, 768);
+
+    // Wider window: limited by height, pillarboxed
+    IntegerUpscale wide = fitIntegerUpscale(256, 192, 1920, 1080);
+    EXPECT_EQ(wide.scale, 5);
+    EXPECT_EQ(wide.width, 1280);
+    EXPECT_EQ(wide.height, 960);
+    EXPECT_EQ(wide.x, 320);
+    EXPECT_EQ(wide.y, 60);
+
+    // Source larger than the window is never shrunk
+    IntegerUpscale large = fitIntegerUpscale(800, 600, 640, 480);
+    EXPECT_EQ(large.scale, 1);
+    EXPECT_EQ(large.x, -80);
+}
+
+TEST(RenderTargetTest, DefaultPostSettingsAreNeutral) {
+    PostSettings post;
+    EXPECT_TRUE(post.isNeutral());
+    post.vignette = 0.3f;
+    EXPECT_FALSE(post.isNeutral());
+}
+
+TEST(DynamicResolutionTest, ShrinksQuicklyAndGrowsSlowly) {
+    DynamicResolutionSettings settings;
+    settings.targetFrameTime = 0.010;
+    settings.settleFrames = 2;
+    DynamicResolution controller;
+    controller.setSettings(settings);
+    EXPECT_FLOAT_EQ(controller.getScale(), 1.0f);
+
+    // Over budget: shrinks after shrinkFrames samples
+    int frames = 0;
+    while (!controller.update(0.015) && frames < 100)
+    {
+        ++frames;
+    }
+    EXPECT_EQ(frames + 1, settings.shrinkFrames);
+    EXPECT_NEAR(controller.getScale(), 0.9f, 1e-5f);
+
+    // Inside the hysteresis band nothing changes
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_FALSE(controller.update(0.008));
+    }
+    EXPECT_NEAR(controller.getScale(), 0.9f, 1e-5f);
+
+    // Well under budget: grows only after settle + growFrames samples
+    frames = 0;
+    while (!controller.update(0.002) && frames < 1000)
+    {
+        ++frames;
+    }
+    EXPECT_GE(frames + 1, settings.growFrames);
+    EXPECT_NEAR(controller.getScale(), 1.0f, 1e-5f);
+}
+
+TEST(DynamicResolutionTest, ScaleStaysWithinBounds) {
+    DynamicResolution controller;
+    for (int i = 0; i < 1000; ++i)
+    {
+        controller.update(1.0);
+    }
+    EXPECT_NEAR(controller.getScale(), controller.getSettings().minScale, 1e-5f);
+
+    controller.reset();
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_FALSE(controller.update(0.0));
+    }
+    EXPECT_FLOAT_EQ(controller.getScale(), controller.getSettings().maxScale);
+}
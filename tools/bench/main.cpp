@@ -0,0 +1,166 @@
+#include "game/TileGrid.h"
+#include "rendering/Particles.h"
+#include "rendering/Sprite.h"
+#include "rendering/SpriteCommandBuffer.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Penumbra;
+using namespace Penumbra::Rendering;
+
+namespace {
+
+/**
+ * Best of several runs, in sprites per second
+ */
+double measure(size_t spriteCount, const std::function<void()>& run)
+{
+    constexpr int RUNS = 20;
+    double best = 0.0;
+    for (int i = 0; i < RUNS; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > 0.0)
+        {
+            best = std::max(best, static_cast<double>(spriteCount) / elapsed.count());
+        }
+    }
+    return best;
+}
+
+void report(const char* name, double scalar, double batch)
+{
+    std::cout << std::fixed << std::setprecision(1)
+              << name << ": scalar " << scalar / 1e6 << "M sprites/s, "
+              << getSpriteKernelName() << " " << batch / 1e6 << "M sprites/s ("
+              << std::setprecision(2) << batch / scalar << "x)" << std::endl;
+}
+
+/**
+ * Time one simulated frame of count particles bouncing around a walled
+ * room: update, refill, and recording as instances
+ */
+void benchmarkParticles(size_t count)
+{
+    constexpr int FRAMES = 120;
+    constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+    Game::TileGrid grid(64, 48);
+    for (int x = 0; x < grid.getWidth(); ++x)
+    {
+        grid.setTile(x, grid.getHeight() - 1, Game::Tile(Game::TileType::Solid));
+    }
+
+    ParticleType type;
+    type.capacity = count;
+    type.lifetime = 2.0f;
+    type.lifetimeVariance = 0.5f;
+    type.angle = -1.5708f;
+    type.spread = 1.0f;
+    type.speed = 120.0f;
+    type.speedVariance = 0.5f;
+    type.acceleration = Math::Vec2(0.0f, 200.0f);
+    type.collide = true;
+
+    ParticlePool pool(type);
+    SolidTileMask tiles;
+    tiles.update(grid);
+    SpriteCommandBuffer buffer;
+
+    double updateTime = 0.0;
+    double recordTime = 0.0;
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        pool.emit(Math::Vec2(512.0f, 400.0f), count - pool.getCount());
+
+        auto start = std::chrono::steady_clock::now();
+        pool.update(FRAME_TIME, &tiles);
+        auto updated = std::chrono::steady_clock::now();
+        buffer.begin(SpriteBatchMode::Instanced, SpriteAxes(), nullptr);
+        pool.draw(buffer);
+        auto recorded = std::chrono::steady_clock::now();
+
+        updateTime += std::chrono::duration<double>(updated - start).count();
+        recordTime += std::chrono::duration<double>(recorded - updated).count();
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << count << " particles (" << getParticleKernelName() << "): update "
+              << updateTime / FRAMES * 1000.0 << " ms, record " << recordTime / FRAMES * 1000.0
+              << " ms per frame (budget " << FRAME_TIME * 1000.0f << " ms)" << std::endl;
+}
+
+} // namespace
+
+/**
+ * penumbra_bench [sprite-count]
+ * Compares scalar and SIMD sprite vertex generation, then times the
+ * particle system with as many particles
+ */
+int main(int argc, char* argv[])
+{
+    size_t spriteCount = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    if (spriteCount == 0)
+    {
+        std::cerr << "Usage: penumbra_bench [sprite-count]" << std::endl;
+        return 2;
+    }
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> coordinate(0.0f, 1024.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+    std::vector<Sprite> still(spriteCount);
+    std::vector<Sprite> rotated(spriteCount);
+    for (size_t i = 0; i < spriteCount; ++i)
+    {
+        still[i].position = Math::Vec2(coordinate(random), coordinate(random));
+        still[i].textureRect = Math::Rect(0.25f, 0.5f, 0.125f, 0.125f);
+        rotated[i] = still[i];
+        rotated[i].rotation = angle(random);
+    }
+
+    std::vector<const Sprite*> stillPointers;
+    std::vector<const Sprite*> rotatedPointers;
+    for (size_t i = 0; i < spriteCount; ++i)
+    {
+        stillPointers.push_back(&still[i]);
+        rotatedPointers.push_back(&rotated[i]);
+    }
+    std::vector<uint8_t> slots(spriteCount, 0);
+    std::vector<SpriteVertex> out(spriteCount * 4);
+    SpriteAxes axes;
+
+    auto scalar = [&](const std::vector<Sprite>& sprites) {
+        return measure(spriteCount, [&] {
+            for (size_t i = 0; i < spriteCount; ++i)
+            {
+                writeSpriteVertices(sprites[i], slots[i], axes, &out[i * 4]);
+            }
+        });
+    };
+    auto batch = [&](const std::vector<const Sprite*>& sprites) {
+        return measure(spriteCount, [&] {
+            writeSpriteVerticesBatch(sprites.data(), slots.data(), spriteCount, axes, out.data());
+        });
+    };
+
+    std::cout << spriteCount << " sprites, best of 20 runs" << std::endl;
+    report("unrotated", scalar(still), batch(stillPointers));
+    report("rotated  ", scalar(rotated), batch(rotatedPointers));
+
+    axes.billboard = true;
+    axes.right = Math::Vec3(0.7071f, -0.7071f, 0.0f);
+    axes.down = Math::Vec3(0.3536f, 0.3536f, -0.866f);
+    report("billboard", scalar(rotated), batch(rotatedPointers));
+
+    benchmarkParticles(spriteCount);
+    return 0;
+}
@@ -0,0 +1,715 @@
+#include "Cooker.h"
+#include "core/CookedAssets.h"
+#include <nlohmann/json.hpp>
+#include <png.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Penumbra {
+namespace Tools {
+
+namespace {
+
+constexpr const char* SHADER_BUNDLE_KEY = "<shader bundle>";
+
+bool readBytes(const fs::path& path, std::string& outData)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    outData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+std::string toHex(uint64_t value)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+std::string relativeKey(const fs::path& path, const fs::path& root)
+{
+    return fs::relative(path, root).generic_string();
+}
+
+bool isShaderStage(const fs::path& path)
+{
+    return path.extension() == ".vert" || path.extension() == ".frag";
+}
+
+bool isShaderInclude(const fs::path& path)
+{
+    return path.extension() == ".glsl";
+}
+
+/**
+ * Split a BMFont text line ("char id=65 x=2 ...") into its tag and key=value pairs
+ */
+std::string parseFontLine(const std::string& line, std::map<std::string, std::string>& outValues)
+{
+    outValues.clear();
+    std::istringstream stream(line);
+    std::string tag;
+    stream >> tag;
+
+    std::string token;
+    while (stream >> token)
+    {
+        size_t equals = token.find('=');
+        if (equals == std::string::npos)
+        {
+            continue;
+        }
+        std::string key = token.substr(0, equals);
+        std::string value = token.substr(equals + 1);
+
+        // Quoted values (file names, face names) may contain spaces
+        if (!value.empty() && value.front() == '"')
+        {
+            while (value.size() < 2 || value.back() != '"')
+            {
+                std::string rest;
+                if (!(stream >> rest))
+                {
+                    break;
+                }
+                value += " " + rest;
+            }
+            value = value.substr(1, value.size() >= 2 ? value.size() - 2 : 0);
+        }
+        outValues[key] = value;
+    }
+    return tag;
+}
+
+int fontValue(const std::map<std::string, std::string>& values, const char* key)
+{
+    auto it = values.find(key);
+    return it != values.end() ? std::atoi(it->second.c_str()) : 0;
+}
+
+/**
+ * Premultiply alpha in place (RGBA8)
+ */
+void premultiply(std::vector<uint8_t>& pixels)
+{
+    for (size_t i = 0; i + 3 < pixels.size(); i += 4)
+    {
+        unsigned int alpha = pixels[i + 3];
+        for (size_t c = 0; c < 3; ++c)
+        {
+            pixels[i + c] = static_cast<uint8_t>((pixels[i + c] * alpha + 127) / 255);
+        }
+    }
+}
+
+/**
+ * 2x2 box-filter downsample of a premultiplied RGBA8 level
+ * Odd edges clamp, so every level halves (rounding down) to 1x1
+ */
+void downsample(const uint8_t* src, int srcWidth, int srcHeight,
+                uint8_t* dst, int dstWidth, int dstHeight)
+{
+    for (int y = 0; y < dstHeight; ++y)
+    {
+        int y0 = std::min(y * 2, srcHeight - 1);
+        int y1 = std::min(y * 2 + 1, srcHeight - 1);
+        for (int x = 0; x < dstWidth; ++x)
+        {
+            int x0 = std::min(x * 2, srcWidth - 1);
+            int x1 = std::min(x * 2 + 1, srcWidth - 1);
+            for (int c = 0; c < 4; ++c)
+            {
+                unsigned int sum = src[(y0 * srcWidth + x0) * 4 + c] +
+                                   src[(y0 * srcWidth + x1) * 4 + c] +
+                                   src[(y1 * srcWidth + x0) * 4 + c] +
+                                   src[(y1 * srcWidth + x1) * 4 + c];
+                dst[(y * dstWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+/**
+ * Expand #include "file" directives and strip comments and blank lines
+ */
+bool preprocessShader(const fs::path& path, std::set<fs::path>& includeStack, std::string& outSource)
+{
+    fs::path canonical = fs::weakly_canonical(path);
+    if (includeStack.count(canonical))
+    {
+        std::cerr << "Recursive shader include: " << path << std::endl;
+        return false;
+    }
+
+    std::string raw;
+    if (!readBytes(path, raw))
+    {
+        std::cerr << "Missing shader file: " << path << std::endl;
+        return false;
+    }
+    includeStack.insert(canonical);
+
+    // Strip comments first so commented-out includes are ignored
+    std::string stripped;
+    stripped.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        if (raw.compare(i, 2, "//") == 0)
+        {
+            while (i < raw.size() && raw[i] != '\n')
+            {
+                ++i;
+            }
+            if (i < raw.size())
+            {
+                stripped += '\n';
+            }
+        }
+        else if (raw.compare(i, 2, "/*") == 0)
+        {
+            // Keep newlines so driver error line numbers stay close to the source
+            size_t end = std::min(raw.find("*/", i + 2), raw.size());
+            stripped.append(static_cast<size_t>(std::count(raw.begin() + static_cast<std::ptrdiff_t>(i),
+                                                           raw.begin() + static_cast<std::ptrdiff_t>(end), '\n')),
+                            '\n');
+            i = end + 1;
+        }
+        else
+        {
+            stripped += raw[i];
+        }
+    }
+
+    std::istringstream lines(stripped);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+        {
+            continue;
+        }
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+        if (line.compare(0, 8, "#include") == 0)
+        {
+            size_t open = line.find('"');
+            size_t close = line.rfind('"');
+            if (open == std::string::npos || close == open)
+            {
+                std::cerr << "Malformed #include in " << path << ": " << line << std::endl;
+                return false;
+            }
+            fs::path included = path.parent_path() / line.substr(open + 1, close - open - 1);
+            if (!preprocessShader(included, includeStack, outSource))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        outSource += line;
+        outSource += '\n';
+    }
+
+    includeStack.erase(canonical);
+    return true;
+}
+
+} // namespace
+
+Cooker::Cooker(const CookOptions& options)
+    : options(options)
+{
+}
+
+bool Cooker::run(CookReport& outReport)
+{
+    fs::path sourceRoot(options.sourceDir);
+    fs::path outputRoot(options.outputDir);
+
+    std::error_code error;
+    if (!fs::is_directory(sourceRoot, error))
+    {
+        std::cerr << "Asset directory not found: " << sourceRoot << std::endl;
+        return false;
+    }
+    fs::create_directories(outputRoot, error);
+
+    if (!options.force)
+    {
+        loadManifest();
+    }
+    std::set<std::string> seen;
+
+    // Settings that change cooked output are folded into every hash
+    const uint64_t settingsSeed = Assets::hashContent(&Assets::COOK_FORMAT_VERSION, sizeof(uint32_t)) ^
+                                  (options.generateMips ? 0x9e3779b97f4a7c15ULL : 0);
+
+    for (const auto& entry : fs::recursive_directory_iterator(sourceRoot))
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        const fs::path& sourcePath = entry.path();
+        if (isShaderStage(sourcePath) || isShaderInclude(sourcePath))
+        {
+            continue;  // Bundled below
+        }
+
+        std::string key = relativeKey(sourcePath, sourceRoot);
+        seen.insert(key);
+        std::string content;
+        if (!readBytes(sourcePath, content))
+        {
+            std::cerr << "Failed to read " << key << std::endl;
+            ++outReport.failed;
+            continue;
+        }
+        uint64_t hash = Assets::hashContent(content.data(), content.size(), settingsSeed);
+
+        std::string outputKey = key;
+        bool isTexture = sourcePath.extension() == ".png";
+        bool isRoom = sourcePath.extension() == ".json" && key.compare(0, 6, "rooms/") == 0;
+        bool isFont = sourcePath.extension() == ".fnt";
+        if (isTexture)
+        {
+            outputKey = Assets::cookedTexturePath(key);
+        }
+        else if (isRoom)
+        {
+            outputKey = Assets::cookedRoomPath(key);
+        }
+        else if (isFont)
+        {
+            outputKey = Assets::cookedFontPath(key);
+        }
+
+        fs::path outputPath = outputRoot / outputKey;
+        if (isUpToDate(key, hash) && fs::exists(outputPath))
+        {
+            ++outReport.skipped;
+            continue;
+        }
+
+        fs::create_directories(outputPath.parent_path(), error);
+        bool cooked = false;
+        if (isTexture)
+        {
+            cooked = cookTexture(sourcePath.string(), outputPath.string());
+        }
+        else if (isRoom)
+        {
+            cooked = cookRoom(sourcePath.string(), outputPath.string());
+        }
+        else if (isFont)
+        {
+            cooked = cookFont(sourcePath.string(), key, outputPath.string());
+        }
+        else
+        {
+            cooked = fs::copy_file(sourcePath, outputPath, fs::copy_options::overwrite_existing, error);
+        }
+
+        if (cooked)
+        {
+            record(key, hash, outputKey);
+            ++outReport.cooked;
+            std::cout << "Cooked " << key << " -> " << outputKey << std::endl;
+        }
+        else
+        {
+            std::cerr << "Failed to cook " << key << std::endl;
+            ++outReport.failed;
+        }
+    }
+
+    seen.insert(SHADER_BUNDLE_KEY);
+    if (!cookShaders(outReport))
+    {
+        ++outReport.failed;
+    }
+
+    // Forget inputs that no longer exist so the manifest doesn't grow forever
+    for (auto it = manifest.begin(); it != manifest.end();)
+    {
+        it = seen.count(it->first) ? std::next(it) : manifest.erase(it);
+    }
+
+    if (!saveManifest())
+    {
+        std::cerr << "Failed to write cook manifest" << std::endl;
+        return false;
+    }
+
+    return outReport.failed == 0;
+}
+
+bool Cooker::isUpToDate(const std::string& key, uint64_t hash) const
+{
+    auto it = manifest.find(key);
+    return it != manifest.end() && it->second.hash == hash;
+}
+
+void Cooker::record(const std::string& key, uint64_t hash, const std::string& output)
+{
+    manifest[key] = ManifestEntry{hash, output};
+}
+
+void Cooker::loadManifest()
+{
+    std::string text;
+    if (!readBytes(fs::path(options.outputDir) / Assets::MANIFEST_FILE, text))
+    {
+        return;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(text, nullptr, false);
+    if (json.is_discarded() || json.value("version", 0u) != Assets::COOK_FORMAT_VERSION)
+    {
+        return;
+    }
+
+    for (const auto& item : json["entries"].items())
+    {
+        // Malformed entries (hand edits, truncation) are left out, so their
+        // assets count as stale and get re-cooked
+        const auto& value = item.value();
+        if (!value.is_object() || !value.contains("hash") || !value["hash"].is_string() ||
+            !value.contains("output") || !value["output"].is_string())
+        {
+            continue;
+        }
+
+        const std::string& hashText = value["hash"].get_ref<const std::string&>();
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long hash = std::strtoull(hashText.c_str(), &end, 16);
+        if (hashText.empty() || end != hashText.c_str() + hashText.size() || errno == ERANGE)
+        {
+            continue;
+        }
+
+        ManifestEntry entry;
+        entry.hash = static_cast<uint64_t>(hash);
+        entry.output = value["output"].get<std::string>();
+        manifest[item.key()] = entry;
+    }
+}
+
+bool Cooker::saveManifest() const
+{
+    nlohmann::json json;
+    json["version"] = Assets::COOK_FORMAT_VERSION;
+    json["entries"] = nlohmann::json::object();
+    for (const auto& entry : manifest)
+    {
+        json["entries"][entry.first] = {
+            {"hash", toHex(entry.second.hash)},
+            {"output", entry.second.output}
+        };
+    }
+
+    std::ofstream file(fs::path(options.outputDir) / Assets::MANIFEST_FILE, std::ios::trunc);
+    file << json.dump(2) << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool Cooker::cookTexture(const std::string& sourcePath, const std::string& outputPath) const
+{
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, sourcePath.c_str()))
+    {
+        std::cerr << sourcePath << ": " << image.message << std::endl;
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+    std::vector<uint8_t> base(PNG_IMAGE_SIZE(image));
+    if (!png_image_finish_read(&image, nullptr, base.data(), 0, nullptr))
+    {
+        std::cerr << sourcePath << ": " << image.message << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+    premultiply(base);
+
+    Assets::CookedTexture texture;
+    texture.width = static_cast<int>(image.width);
+    texture.height = static_cast<int>(image.height);
+    texture.levels.push_back({texture.width, texture.height, 0, base.size()});
+    texture.pixels = std::move(base);
+
+    while (options.generateMips)
+    {
+        const auto previous = texture.levels.back();
+        if (previous.width == 1 && previous.height == 1)
+        {
+            break;
+        }
+
+        Assets::CookedTexture::Level level;
+        level.width = std::max(1, previous.width / 2);
+        level.height = std::max(1, previous.height / 2);
+        level.offset = texture.pixels.size();
+        level.size = static_cast<size_t>(level.width) * static_cast<size_t>(level.height) * 4;
+        texture.pixels.resize(level.offset + level.size);
+        downsample(texture.pixels.data() + previous.offset, previous.width, previous.height,
+                   texture.pixels.data() + level.offset, level.width, level.height);
+        texture.levels.push_back(level);
+    }
+
+    return Assets::writeTexture(outputPath, texture);
+}
+
+bool Cooker::cookRoom(const std::string& sourcePath, const std::string& outputPath) const
+{
+    // Source schema:
+    // { "name": str, "width": int, "height": int,
+    //   "tiles": [int, ...] (row-major TileType), "textures": [int, ...] (optional),
+    //   "spawn": [x, y], "exits": { "north": id, "south": id, "east": id, "west": id },
+    //   "background": [r, g, b, a], "music": str,
+    //   "enemies": [ { "type": str, "x": f, "y": f } ],
+    //   "platforms": [ { "pattern": str, "x": f, "y": f, "width": f, "height": f } ] }
+    std::string text;
+    if (!readBytes(sourcePath, text))
+    {
+        return false;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(text, nullptr, false);
+    if (json.is_discarded())
+    {
+        std::cerr << sourcePath << ": invalid JSON" << std::endl;
+        return false;
+    }
+
+    Assets::CookedRoom room;
+    try
+    {
+        room.name = json.value("name", fs::path(sourcePath).stem().string());
+        room.width = json.at("width").get<int>();
+        room.height = json.at("height").get<int>();
+
+        size_t cellCount = static_cast<size_t>(room.width) * static_cast<size_t>(room.height);
+        const auto& tiles = json.at("tiles");
+        if (tiles.size() != cellCount)
+        {
+            std::cerr << sourcePath << ": expected " << cellCount << " tiles, found "
+                      << tiles.size() << std::endl;
+            return false;
+        }
+        room.tileTypes.reserve(cellCount);
+        for (const auto& tile : tiles)
+        {
+            room.tileTypes.push_back(static_cast<uint8_t>(tile.get<int>()));
+        }
+
+        room.textureIndices.assign(cellCount, 0);
+        if (json.contains("textures"))
+        {
+            const auto& textures = json["textures"];
+            for (size_t i = 0; i < std::min(cellCount, textures.size()); ++i)
+            {
+                room.textureIndices[i] = static_cast<uint16_t>(textures[i].get<int>());
+            }
+        }
+
+        if (json.contains("spawn"))
+        {
+            room.spawnX = json["spawn"].at(0).get<float>();
+            room.spawnY = json["spawn"].at(1).get<float>();
+        }
+
+        if (json.contains("exits"))
+        {
+            const auto& exits = json["exits"];
+            room.northRoom = exits.value("north", std::string());
+            room.southRoom = exits.value("south", std::string());
+            room.eastRoom = exits.value("east", std::string());
+            room.westRoom = exits.value("west", std::string());
+        }
+
+        if (json.contains("background"))
+        {
+            for (size_t i = 0; i < 4 && i < json["background"].size(); ++i)
+            {
+                room.background[i] = json["background"][i].get<float>();
+            }
+        }
+        room.musicTrack = json.value("music", std::string());
+
+        for (const auto& enemy : json.value("enemies", nlohmann::json::array()))
+        {
+            room.enemies.push_back({enemy.at("type").get<std::string>(),
+                                    enemy.at("x").get<float>(),
+                                    enemy.at("y").get<float>()});
+        }
+
+        for (const auto& platform : json.value("platforms", nlohmann::json::array()))
+        {
+            room.platforms.push_back({platform.value("pattern", std::string("static")),
+                                      platform.at("x").get<float>(),
+                                      platform.at("y").get<float>(),
+                                      platform.at("width").get<float>(),
+                                      platform.at("height").get<float>()});
+        }
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        std::cerr << sourcePath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    return Assets::writeRoom(outputPath, room);
+}
+
+bool Cooker::cookFont(const std::string& sourcePath, const std::string& sourceKey,
+                      const std::string& outputPath) const
+{
+    // AngelCode BMFont text format; only the lines below are used:
+    //   common lineHeight=.. base=.. scaleW=.. scaleH=.. pages=1
+    //   page id=0 file=".."
+    //   char id=.. x=.. y=.. width=.. height=.. xoffset=.. yoffset=.. xadvance=..
+    //   kerning first=.. second=.. amount=..
+    std::ifstream file(sourcePath);
+    if (!file)
+    {
+        return false;
+    }
+
+    Assets::CookedFont font;
+    std::map<std::string, std::string> values;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::string tag = parseFontLine(line, values);
+        if (tag == "common")
+        {
+            font.lineHeight = fontValue(values, "lineHeight");
+            font.base = fontValue(values, "base");
+            font.pageWidth = fontValue(values, "scaleW");
+            font.pageHeight = fontValue(values, "scaleH");
+            if (fontValue(values, "pages") > 1)
+            {
+                std::cerr << sourcePath << ": only single-page fonts are supported" << std::endl;
+                return false;
+            }
+        }
+        else if (tag == "page")
+        {
+            // Pages are named relative to the .fnt; the runtime wants asset-root paths
+            font.page = (fs::path(sourceKey).parent_path() / values["file"]).generic_string();
+        }
+        else if (tag == "char")
+        {
+            Assets::CookedFont::Glyph glyph;
+            glyph.codepoint = static_cast<uint32_t>(fontValue(values, "id"));
+            glyph.x = static_cast<uint16_t>(fontValue(values, "x"));
+            glyph.y = static_cast<uint16_t>(fontValue(values, "y"));
+            glyph.width = static_cast<uint16_t>(fontValue(values, "width"));
+            glyph.height = static_cast<uint16_t>(fontValue(values, "height"));
+            glyph.offsetX = static_cast<int16_t>(fontValue(values, "xoffset"));
+            glyph.offsetY = static_cast<int16_t>(fontValue(values, "yoffset"));
+            glyph.advance = static_cast<int16_t>(fontValue(values, "xadvance"));
+            font.glyphs.push_back(glyph);
+        }
+        else if (tag == "kerning")
+        {
+            font.kernings.push_back({static_cast<uint32_t>(fontValue(values, "first")),
+                                     static_cast<uint32_t>(fontValue(values, "second")),
+                                     static_cast<int16_t>(fontValue(values, "amount"))});
+        }
+    }
+
+    if (font.page.empty() || font.glyphs.empty() || font.pageWidth <= 0 || font.pageHeight <= 0)
+    {
+        std::cerr << sourcePath << ": missing common, page or char lines" << std::endl;
+        return false;
+    }
+
+    return Assets::writeFont(outputPath, font);
+}
+
+bool Cooker::cookShaders(CookReport& report)
+{
+    fs::path sourceRoot(options.sourceDir);
+    fs::path outputPath = fs::path(options.outputDir) / Assets::SHADER_BUNDLE_FILE;
+
+    // Collect every shader input in a stable order so the bundle hash is deterministic
+    std::vector<fs::path> inputs;
+    for (const auto& entry : fs::recursive_directory_iterator(sourceRoot))
+    {
+        if (entry.is_regular_file() && (isShaderStage(entry.path()) || isShaderInclude(entry.path())))
+        {
+            inputs.push_back(entry.path());
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    uint64_t hash = Assets::hashContent(&Assets::COOK_FORMAT_VERSION, sizeof(uint32_t));
+    for (const auto& input : inputs)
+    {
+        std::string key = relativeKey(input, sourceRoot);
+        std::string content;
+        readBytes(input, content);
+        hash = Assets::hashContent(key.data(), key.size(), hash);
+        hash = Assets::hashContent(content.data(), content.size(), hash);
+    }
+
+    if (isUpToDate(SHADER_BUNDLE_KEY, hash) && fs::exists(outputPath))
+    {
+        ++report.skipped;
+        return true;
+    }
+
+    Assets::ShaderBundle bundle;
+    for (const auto& input : inputs)
+    {
+        if (!isShaderStage(input))
+        {
+            continue;
+        }
+
+        std::set<fs::path> includeStack;
+        std::string source;
+        if (!preprocessShader(input, includeStack, source))
+        {
+            return false;
+        }
+        bundle.sources[relativeKey(input, sourceRoot)] = std::move(source);
+    }
+
+    if (!Assets::writeShaderBundle(outputPath.string(), bundle))
+    {
+        return false;
+    }
+
+    record(SHADER_BUNDLE_KEY, hash, Assets::SHADER_BUNDLE_FILE);
+    ++report.cooked;
+    std::cout << "Cooked " << bundle.sources.size() << " shaders -> "
+              << Assets::SHADER_BUNDLE_FILE << std::endl;
+    return true;
+}
+
+} // namespace Tools
+} // namespace Penumbra
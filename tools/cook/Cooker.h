@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Penumbra {
+namespace Tools {
+
+/**
+ * Cook settings
+ */
+struct CookOptions {
+    std::string sourceDir;  // Source asset tree (assets/)
+    std::string outputDir;  // Cooked output tree
+    bool force;             // Ignore the manifest and recook everything
+    bool generateMips;      // Build full mip chains for textures
+
+    CookOptions() : force(false), generateMips(true) {}
+};
+
+/**
+ * Cook results
+ */
+struct CookReport {
+    size_t cooked;
+    size_t skipped;
+    size_t failed;
+
+    CookReport() : cooked(0), skipped(0), failed(0) {}
+};
+
+/**
+ * Offline asset cooker
+ *
+ * Walks the source asset tree and writes runtime-ready assets:
+ * - *.png textures become premultiplied RGBA8 .ptex blobs with mip chains
+ * - shaders/ *.vert and *.frag are preprocessed (#include resolved, comments
+ *   stripped) and bundled into shaders.pshb
+ * - rooms/ *.json become binary .proom files
+ * - *.fnt (AngelCode BMFont text format, one page) become .pfnt glyph tables
+ * - everything else is copied verbatim
+ *
+ * A manifest of content hashes lets repeat cooks skip unchanged inputs.
+ */
+class Cooker {
+public:
+    explicit Cooker(const CookOptions& options);
+
+    /**
+     * Cook the whole tree
+     * @return true if every input cooked (or was up to date)
+     */
+    bool run(CookReport& outReport);
+
+private:
+    struct ManifestEntry {
+        uint64_t hash;
+        std::string output;
+    };
+
+    CookOptions options;
+    std::unordered_map<std::string, ManifestEntry> manifest;
+
+    bool isUpToDate(const std::string& key, uint64_t hash) const;
+    void record(const std::string& key, uint64_t hash, const std::string& output);
+    void loadManifest();
+    bool saveManifest() const;
+
+    bool cookTexture(const std::string& sourcePath, const std::string& outputPath) const;
+    bool cookRoom(const std::string& sourcePath, const std::string& outputPath) const;
+    bool cookFont(const std::string& sourcePath, const std::string& sourceKey, const std::string& outputPath) const;
+    bool cookShaders(CookReport& report);
+};
+
+} // namespace Tools
+} // namespace Penumbra
@@ -0,0 +1,46 @@
+#include "Cooker.h"
+#include <cstring>
+#include <iostream>
+
+/**
+ * penumbra_cook <asset-dir> <output-dir> [--force] [--no-mips]
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: penumbra_cook <asset-dir> <output-dir> [--force] [--no-mips]" << std::endl;
+        return 2;
+    }
+
+    Penumbra::Tools::CookOptions options;
+    options.sourceDir = argv[1];
+    options.outputDir = argv[2];
+
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--force") == 0)
+        {
+            options.force = true;
+        }
+        else if (std::strcmp(argv[i], "--no-mips") == 0)
+        {
+            options.generateMips = false;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    Penumbra::Tools::Cooker cooker(options);
+    Penumbra::Tools::CookReport report;
+    bool success = cooker.run(report);
+
+    std::cout << "Cook finished: " << report.cooked << " cooked, "
+              << report.skipped << " up to date, "
+              << report.failed << " failed" << std::endl;
+
+    return success ? 0 : 1;
+}